@@ -0,0 +1,464 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/log_structured_secondary_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <limits>
+
+#include "util/coding.h"
+#include "util/crc32c.h"
+#include "util/hash.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+constexpr size_t kRecordHeaderSize = 12;
+
+// Returns a record for `key` with `payload_size` bytes of payload at
+// `*payload`, to be filled in before FinishRecord().
+std::string StartRecord(const Slice& key, size_t payload_size,
+                        CompressionType type, CacheTier source,
+                        char** payload) {
+  std::string record;
+  record.reserve(kRecordHeaderSize + key.size() + payload_size);
+  PutFixed32(&record, 0);
+  PutFixed32(&record, static_cast<uint32_t>(payload_size));
+  PutFixed16(&record, static_cast<uint16_t>(key.size()));
+  record.push_back(static_cast<char>(type));
+  record.push_back(static_cast<char>(source));
+  record.append(key.data(), key.size());
+  record.resize(record.size() + payload_size);
+  *payload = &record[kRecordHeaderSize + key.size()];
+  return record;
+}
+
+void FinishRecord(std::string* record) {
+  EncodeFixed32(&(*record)[0],
+                crc32c::Mask(crc32c::Value(record->data() + sizeof(uint32_t),
+                                           record->size() - sizeof(uint32_t))));
+}
+
+// Returns false if `record` is not a valid record for `key`
+bool DecodeRecord(const Slice& record, const Slice& key, Slice* payload,
+                  CompressionType* type, CacheTier* source) {
+  if (record.size() < kRecordHeaderSize) {
+    return false;
+  }
+  const char* data = record.data();
+  const uint32_t payload_size = DecodeFixed32(data + 4);
+  const uint16_t key_size = DecodeFixed16(data + 8);
+  if (kRecordHeaderSize + key_size + uint64_t{payload_size} != record.size() ||
+      crc32c::Unmask(DecodeFixed32(data)) !=
+          crc32c::Value(data + sizeof(uint32_t),
+                        record.size() - sizeof(uint32_t)) ||
+      Slice(data + kRecordHeaderSize, key_size) != key) {
+    return false;
+  }
+  *type = static_cast<CompressionType>(data[10]);
+  *source = static_cast<CacheTier>(data[11]);
+  *payload = Slice(data + kRecordHeaderSize + key_size, payload_size);
+  return true;
+}
+}  // namespace
+
+class LogStructuredSecondaryCache::ResultHandle
+    : public SecondaryCacheResultHandle {
+ public:
+  ResultHandle(FileSystem* fs, const Slice& key,
+               const Cache::CacheItemHelper* helper,
+               Cache::CreateContext* create_context, size_t record_size)
+      : fs_(fs),
+        key_(key.ToString()),
+        helper_(helper),
+        create_context_(create_context),
+        buf_(new char[record_size]),
+        record_size_(record_size) {}
+
+  ~ResultHandle() override {
+    if (io_handle_ != nullptr) {
+      if (!read_done_) {
+        std::vector<void*> io_handles{io_handle_};
+        fs_->AbortIO(io_handles).PermitUncheckedError();
+      }
+      del_fn_(io_handle_);
+    }
+  }
+
+  ResultHandle(const ResultHandle&) = delete;
+  ResultHandle& operator=(const ResultHandle&) = delete;
+
+  bool IsReady() override {
+    if (!ready_ && read_done_) {
+      Complete();
+    }
+    return ready_;
+  }
+
+  void Wait() override {
+    if (!read_done_) {
+      std::vector<void*> io_handles{io_handle_};
+      IOStatus s = fs_->Poll(io_handles, 1);
+      if (!read_done_) {
+        fs_->AbortIO(io_handles).PermitUncheckedError();
+        SetRecord(s.ok() ? IOStatus::IOError("Read not completed by Poll") : s,
+                  Slice());
+      }
+    }
+    if (!ready_) {
+      Complete();
+    }
+  }
+
+  Cache::ObjectPtr Value() override { return value_; }
+
+  size_t Size() override { return size_; }
+
+  bool read_done() const { return read_done_; }
+
+  void* io_handle() const { return io_handle_; }
+
+  char* buf() { return buf_.get(); }
+
+  void SetRecord(const IOStatus& s, const Slice& record) {
+    read_status_ = s;
+    record_ = record;
+    read_done_ = true;
+  }
+
+  // Starts reading the record from `file` at `offset`. Returns false if the
+  // file does not support asynchronous reads.
+  bool StartAsyncRead(FSRandomAccessFile* file, uint64_t offset) {
+    FSReadRequest req;
+    req.offset = offset;
+    req.len = record_size_;
+    req.scratch = buf_.get();
+    IOStatus s = file->ReadAsync(req, IOOptions(), &OnReadDone, this,
+                                 &io_handle_, &del_fn_, /*dbg=*/nullptr);
+    if (!s.ok()) {
+      if (io_handle_ != nullptr) {
+        del_fn_(io_handle_);
+        io_handle_ = nullptr;
+      }
+      return false;
+    }
+    return true;
+  }
+
+  void ReadSync(FSRandomAccessFile* file, uint64_t offset) {
+    Slice result;
+    IOStatus s = file->Read(offset, record_size_, IOOptions(), &result,
+                            buf_.get(), /*dbg=*/nullptr);
+    SetRecord(s, result);
+  }
+
+  // Creates the object from the record once it has been read
+  void Complete() {
+    assert(read_done_);
+    ready_ = true;
+    Slice payload;
+    CompressionType type;
+    CacheTier source;
+    if (!read_status_.ok() ||
+        !DecodeRecord(record_, key_, &payload, &type, &source)) {
+      read_status_.PermitUncheckedError();
+      return;
+    }
+    Status s = helper_->create_cb(payload, type, source, create_context_,
+                                  /*allocator=*/nullptr, &value_, &size_);
+    if (!s.ok()) {
+      value_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+ private:
+  static void OnReadDone(FSReadRequest& req, void* arg) {
+    static_cast<ResultHandle*>(arg)->SetRecord(req.status, req.result);
+  }
+
+  FileSystem* const fs_;
+  const std::string key_;
+  const Cache::CacheItemHelper* const helper_;
+  Cache::CreateContext* const create_context_;
+  std::unique_ptr<char[]> buf_;
+  const size_t record_size_;
+  void* io_handle_ = nullptr;
+  IOHandleDeleter del_fn_;
+  IOStatus read_status_;
+  Slice record_;
+  bool read_done_ = false;
+  bool ready_ = false;
+  Cache::ObjectPtr value_ = nullptr;
+  size_t size_ = 0;
+};
+
+LogStructuredSecondaryCache::LogStructuredSecondaryCache(
+    const LogStructuredSecondaryCacheOptions& opts)
+    : opts_(opts),
+      fs_(opts.fs != nullptr ? opts.fs : FileSystem::Default()),
+      num_segments_(opts.segment_size == 0
+                        ? 0
+                        : static_cast<uint32_t>(std::min<size_t>(
+                              opts.capacity / opts.segment_size,
+                              std::numeric_limits<uint32_t>::max()))),
+      segments_(num_segments_) {}
+
+LogStructuredSecondaryCache::~LogStructuredSecondaryCache() {
+  if (writer_ != nullptr) {
+    reader_.reset();
+    writer_.reset();
+    fs_->DeleteFile(opts_.file_path, IOOptions(), /*dbg=*/nullptr)
+        .PermitUncheckedError();
+  }
+}
+
+Status LogStructuredSecondaryCache::Open() {
+  if (opts_.file_path.empty()) {
+    return Status::InvalidArgument("file_path is required");
+  }
+  if (opts_.segment_size == 0 ||
+      opts_.segment_size > std::numeric_limits<uint32_t>::max()) {
+    return Status::InvalidArgument("segment_size must be in (0, 4GB)");
+  }
+  if (num_segments_ < 2) {
+    return Status::InvalidArgument(
+        "capacity must hold at least two segments");
+  }
+  FileOptions file_opts;
+  std::unique_ptr<FSWritableFile> file;
+  // Creates or truncates the file
+  IOStatus s =
+      fs_->NewWritableFile(opts_.file_path, file_opts, &file, /*dbg=*/nullptr);
+  if (s.ok()) {
+    s = file->Close(IOOptions(), /*dbg=*/nullptr);
+  }
+  if (s.ok()) {
+    s = fs_->NewRandomRWFile(opts_.file_path, file_opts, &writer_,
+                             /*dbg=*/nullptr);
+  }
+  if (s.ok()) {
+    s = fs_->NewRandomAccessFile(opts_.file_path, file_opts, &reader_,
+                                 /*dbg=*/nullptr);
+  }
+  if (!s.ok()) {
+    writer_.reset();
+    return s;
+  }
+  segments_[0].buffer = std::make_shared<std::string>();
+  segments_[0].buffer->reserve(opts_.segment_size);
+  return Status::OK();
+}
+
+Status LogStructuredSecondaryCache::Insert(const Slice& key,
+                                           Cache::ObjectPtr obj,
+                                           const Cache::CacheItemHelper* helper,
+                                           bool force_insert) {
+  if (helper == nullptr || !helper->IsSecondaryCacheCompatible()) {
+    return Status::OK();
+  }
+  const size_t size = helper->size_cb(obj);
+  const uint64_t key_hash = GetSliceNPHash64(key);
+  if (key.size() > std::numeric_limits<uint16_t>::max() ||
+      kRecordHeaderSize + key.size() + size > opts_.segment_size ||
+      (!force_insert && Contains(key_hash))) {
+    return Status::OK();
+  }
+  char* payload = nullptr;
+  std::string record = StartRecord(key, size, kNoCompression,
+                                   CacheTier::kVolatileTier, &payload);
+  Status s = helper->saveto_cb(obj, 0, size, payload);
+  if (!s.ok()) {
+    return s;
+  }
+  FinishRecord(&record);
+  return AppendRecord(key_hash, record);
+}
+
+Status LogStructuredSecondaryCache::InsertSaved(const Slice& key,
+                                                const Slice& saved,
+                                                CompressionType type,
+                                                CacheTier source) {
+  const uint64_t key_hash = GetSliceNPHash64(key);
+  if (key.size() > std::numeric_limits<uint16_t>::max() ||
+      kRecordHeaderSize + key.size() + saved.size() > opts_.segment_size ||
+      Contains(key_hash)) {
+    return Status::OK();
+  }
+  char* payload = nullptr;
+  std::string record = StartRecord(key, saved.size(), type, source, &payload);
+  memcpy(payload, saved.data(), saved.size());
+  FinishRecord(&record);
+  return AppendRecord(key_hash, record);
+}
+
+bool LogStructuredSecondaryCache::Contains(uint64_t key_hash) {
+  MutexLock l(&mutex_);
+  return index_.find(key_hash) != index_.end();
+}
+
+Status LogStructuredSecondaryCache::AppendRecord(uint64_t key_hash,
+                                                 const std::string& record) {
+  std::shared_ptr<std::string> full_buffer;
+  uint32_t full_segment = 0;
+  mutex_.Lock();
+  if (segments_[active_segment_].buffer->size() + record.size() >
+      opts_.segment_size) {
+    full_segment = active_segment_;
+    full_buffer = segments_[active_segment_].buffer;
+    active_segment_ = (active_segment_ + 1) % num_segments_;
+    EvictSegment(active_segment_);
+    segments_[active_segment_].buffer = std::make_shared<std::string>();
+    segments_[active_segment_].buffer->reserve(opts_.segment_size);
+  }
+  Segment& active = segments_[active_segment_];
+  index_[key_hash] = {active_segment_,
+                      static_cast<uint32_t>(active.buffer->size()),
+                      static_cast<uint32_t>(record.size())};
+  active.key_hashes.push_back(key_hash);
+  active.buffer->append(record);
+  if (full_buffer == nullptr) {
+    mutex_.Unlock();
+    return Status::OK();
+  }
+
+  // Lookups keep reading the full segment from memory until it is written
+  write_mutex_.Lock();
+  mutex_.Unlock();
+  IOStatus s = writer_->Write(uint64_t{full_segment} * opts_.segment_size,
+                              *full_buffer, IOOptions(), /*dbg=*/nullptr);
+  write_mutex_.Unlock();
+
+  MutexLock l(&mutex_);
+  Segment& segment = segments_[full_segment];
+  if (segment.buffer == full_buffer) {
+    if (!s.ok()) {
+      EvictSegment(full_segment);
+    }
+    segment.buffer.reset();
+  }
+  return s;
+}
+
+void LogStructuredSecondaryCache::EvictSegment(uint32_t segment) {
+  mutex_.AssertHeld();
+  for (uint64_t key_hash : segments_[segment].key_hashes) {
+    auto it = index_.find(key_hash);
+    // The key may have been inserted again in another segment since
+    if (it != index_.end() && it->second.segment == segment) {
+      index_.erase(it);
+    }
+  }
+  segments_[segment].key_hashes.clear();
+}
+
+std::unique_ptr<SecondaryCacheResultHandle>
+LogStructuredSecondaryCache::Lookup(const Slice& key,
+                                    const Cache::CacheItemHelper* helper,
+                                    Cache::CreateContext* create_context,
+                                    bool wait, bool /*advise_erase*/,
+                                    Statistics* /*stats*/,
+                                    bool& kept_in_sec_cache) {
+  // Entries are only dropped with their segment
+  kept_in_sec_cache = true;
+  if (helper == nullptr || helper->create_cb == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<ResultHandle> handle;
+  Location location;
+  {
+    MutexLock l(&mutex_);
+    auto it = index_.find(GetSliceNPHash64(key));
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    location = it->second;
+    handle.reset(new ResultHandle(fs_.get(), key, helper, create_context,
+                                  location.size));
+    const auto& buffer = segments_[location.segment].buffer;
+    if (buffer != nullptr) {
+      memcpy(handle->buf(), buffer->data() + location.offset, location.size);
+      handle->SetRecord(IOStatus::OK(), Slice(handle->buf(), location.size));
+    }
+  }
+  if (!handle->read_done()) {
+    const uint64_t offset =
+        uint64_t{location.segment} * opts_.segment_size + location.offset;
+    if (wait || !handle->StartAsyncRead(reader_.get(), offset)) {
+      handle->ReadSync(reader_.get(), offset);
+    }
+  }
+  if (handle->read_done()) {
+    handle->Complete();
+    if (handle->Value() == nullptr) {
+      return nullptr;
+    }
+  }
+  return handle;
+}
+
+void LogStructuredSecondaryCache::Erase(const Slice& key) {
+  MutexLock l(&mutex_);
+  index_.erase(GetSliceNPHash64(key));
+}
+
+void LogStructuredSecondaryCache::WaitAll(
+    std::vector<SecondaryCacheResultHandle*> handles) {
+  std::vector<void*> io_handles;
+  for (SecondaryCacheResultHandle* handle : handles) {
+    auto* result_handle = static_cast<ResultHandle*>(handle);
+    if (!result_handle->read_done()) {
+      io_handles.push_back(result_handle->io_handle());
+    }
+  }
+  if (!io_handles.empty()) {
+    // Handles not completed by Poll are dealt with by Wait()
+    fs_->Poll(io_handles, io_handles.size()).PermitUncheckedError();
+  }
+  for (SecondaryCacheResultHandle* handle : handles) {
+    handle->Wait();
+  }
+}
+
+Status LogStructuredSecondaryCache::GetCapacity(size_t& capacity) {
+  capacity = num_segments_ * opts_.segment_size;
+  return Status::OK();
+}
+
+std::string LogStructuredSecondaryCache::GetPrintableOptions() const {
+  std::string ret;
+  const int kBufferSize{200};
+  char buffer[kBufferSize];
+  snprintf(buffer, kBufferSize, "    file_path : %s\n",
+           opts_.file_path.c_str());
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    capacity : %" ROCKSDB_PRIszt "\n",
+           opts_.capacity);
+  ret.append(buffer);
+  snprintf(buffer, kBufferSize, "    segment_size : %" ROCKSDB_PRIszt "\n",
+           opts_.segment_size);
+  ret.append(buffer);
+  return ret;
+}
+
+size_t LogStructuredSecondaryCache::TEST_NumEntries() {
+  MutexLock l(&mutex_);
+  return index_.size();
+}
+
+Status NewLogStructuredSecondaryCache(
+    const LogStructuredSecondaryCacheOptions& opts,
+    std::shared_ptr<SecondaryCache>* result) {
+  auto cache = std::make_shared<LogStructuredSecondaryCache>(opts);
+  Status s = cache->Open();
+  if (s.ok()) {
+    *result = std::move(cache);
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
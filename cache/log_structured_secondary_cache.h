@@ -0,0 +1,114 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/file_system.h"
+#include "rocksdb/secondary_cache.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// A SecondaryCache that stores entries as records appended to a file, see
+// LogStructuredSecondaryCacheOptions.
+//
+// The file is split into segments. Records are appended to an in-memory
+// buffer for the active segment, which is written to the file with a single
+// write when it is full. The next segment then becomes active, and the entries
+// it held are evicted, in FIFO order. The in-memory index maps a 64-bit hash
+// of the key to the location of its record. Records carry the key and a
+// checksum, which are verified on lookup, so that hash collisions and records
+// overwritten while being read are reported as misses.
+//
+// Record format:
+//   [masked crc32c of the rest: fixed32][payload size: fixed32]
+//   [key size: fixed16][compression type: 1 byte][source cache tier: 1 byte]
+//   [key][payload]
+class LogStructuredSecondaryCache : public SecondaryCache {
+ public:
+  explicit LogStructuredSecondaryCache(
+      const LogStructuredSecondaryCacheOptions& opts);
+  ~LogStructuredSecondaryCache() override;
+
+  // Creates the cache file. Must succeed before the cache is used.
+  Status Open();
+
+  const char* Name() const override { return "LogStructuredSecondaryCache"; }
+
+  Status Insert(const Slice& key, Cache::ObjectPtr obj,
+                const Cache::CacheItemHelper* helper,
+                bool force_insert) override;
+
+  Status InsertSaved(const Slice& key, const Slice& saved, CompressionType type,
+                     CacheTier source) override;
+
+  std::unique_ptr<SecondaryCacheResultHandle> Lookup(
+      const Slice& key, const Cache::CacheItemHelper* helper,
+      Cache::CreateContext* create_context, bool wait, bool advise_erase,
+      Statistics* stats, bool& kept_in_sec_cache) override;
+
+  // Erase() only drops the index entry; the space is reclaimed with the
+  // segment.
+  bool SupportForceErase() const override { return false; }
+
+  void Erase(const Slice& key) override;
+
+  void WaitAll(std::vector<SecondaryCacheResultHandle*> handles) override;
+
+  Status GetCapacity(size_t& capacity) override;
+
+  std::string GetPrintableOptions() const override;
+
+  size_t TEST_NumEntries();
+
+ private:
+  class ResultHandle;
+
+  struct Location {
+    uint32_t segment;
+    uint32_t offset;
+    uint32_t size;
+  };
+
+  struct Segment {
+    // Hashes of the keys of the records in the segment, for eviction
+    std::vector<uint64_t> key_hashes;
+    // Contents of the segment while it is active or being written to the
+    // file, nullptr once it is only in the file
+    std::shared_ptr<std::string> buffer;
+  };
+
+  // Whether an entry may be cached for a key with this hash
+  bool Contains(uint64_t key_hash);
+  // Appends `record` to the active segment. If it does not fit, the next
+  // segment becomes active and the full one is written to the file.
+  Status AppendRecord(uint64_t key_hash, const std::string& record);
+  // Drops the index entries of records in `segment`.
+  // REQUIRES: mutex_ held
+  void EvictSegment(uint32_t segment);
+
+  const LogStructuredSecondaryCacheOptions opts_;
+  std::shared_ptr<FileSystem> fs_;
+  const uint32_t num_segments_;
+  std::unique_ptr<FSRandomRWFile> writer_;
+  std::unique_ptr<FSRandomAccessFile> reader_;
+
+  // Protects the members below
+  port::Mutex mutex_;
+  std::unordered_map<uint64_t, Location> index_;
+  std::vector<Segment> segments_;
+  uint32_t active_segment_ = 0;
+
+  // Serializes segment writes. It is acquired while holding mutex_, so that
+  // segments are written in the order in which they became full.
+  port::Mutex write_mutex_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,189 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "cache/log_structured_secondary_cache.h"
+
+#include <memory>
+
+#include "rocksdb/secondary_cache.h"
+#include "test_util/secondary_cache_test_util.h"
+#include "test_util/testharness.h"
+#include "test_util/testutil.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+using secondary_cache_test_util::TestCreateContext;
+using secondary_cache_test_util::WithCacheType;
+using TestItem = WithCacheType::TestItem;
+
+class LogStructuredSecondaryCacheTest : public testing::Test,
+                                        public TestCreateContext {
+ public:
+  LogStructuredSecondaryCacheTest() {
+    opts_.file_path = test::PerThreadDBPath("log_structured_secondary_cache");
+    opts_.segment_size = 4096;
+    opts_.capacity = 4 * opts_.segment_size;
+  }
+
+ protected:
+  // 16 bytes like block cache keys
+  static std::string Key(int i) {
+    std::string key = "____    ____" + std::to_string(i);
+    key.resize(16, '_');
+    return key;
+  }
+
+  std::unique_ptr<SecondaryCacheResultHandle> Lookup(const std::string& key,
+                                                     bool wait) {
+    bool kept_in_sec_cache = false;
+    auto handle = sec_cache_->Lookup(key, WithCacheType::GetHelper(), this,
+                                     wait, /*advise_erase=*/false,
+                                     /*stats=*/nullptr, kept_in_sec_cache);
+    EXPECT_TRUE(kept_in_sec_cache);
+    return handle;
+  }
+
+  // Returns the value of a completed lookup, or "" for none
+  static std::string TakeValue(SecondaryCacheResultHandle* handle) {
+    EXPECT_TRUE(handle->IsReady());
+    std::unique_ptr<TestItem> item(static_cast<TestItem*>(handle->Value()));
+    return item != nullptr ? item->ToString() : "";
+  }
+
+  LogStructuredSecondaryCacheOptions opts_;
+  std::shared_ptr<SecondaryCache> sec_cache_;
+};
+
+TEST_F(LogStructuredSecondaryCacheTest, InsertAndLookup) {
+  ASSERT_OK(NewLogStructuredSecondaryCache(opts_, &sec_cache_));
+  ASSERT_EQ(Lookup(Key(0), /*wait=*/true), nullptr);
+
+  Random rnd(301);
+  std::string str1 = rnd.RandomString(1000);
+  TestItem item1(str1.data(), str1.size());
+  ASSERT_OK(sec_cache_->Insert(Key(1), &item1, WithCacheType::GetHelper(),
+                               /*force_insert=*/false));
+  std::string str2 = rnd.RandomString(1000);
+  ASSERT_OK(sec_cache_->InsertSaved(Key(2), str2));
+
+  auto handle1 = Lookup(Key(1), /*wait=*/true);
+  ASSERT_NE(handle1, nullptr);
+  ASSERT_EQ(TakeValue(handle1.get()), str1);
+  auto handle2 = Lookup(Key(2), /*wait=*/false);
+  ASSERT_NE(handle2, nullptr);
+  sec_cache_->WaitAll({handle2.get()});
+  ASSERT_EQ(TakeValue(handle2.get()), str2);
+
+  // Entries whose object cannot be created are misses
+  SetFailCreate(true);
+  ASSERT_EQ(Lookup(Key(1), /*wait=*/true), nullptr);
+  SetFailCreate(false);
+
+  sec_cache_->Erase(Key(1));
+  ASSERT_EQ(Lookup(Key(1), /*wait=*/true), nullptr);
+  ASSERT_NE(Lookup(Key(2), /*wait=*/true), nullptr);
+
+  // Entries larger than a segment are not cached
+  std::string str3 = rnd.RandomString(static_cast<int>(opts_.segment_size));
+  ASSERT_OK(sec_cache_->InsertSaved(Key(3), str3));
+  ASSERT_EQ(Lookup(Key(3), /*wait=*/true), nullptr);
+
+  size_t capacity = 0;
+  ASSERT_OK(sec_cache_->GetCapacity(capacity));
+  ASSERT_EQ(capacity, opts_.capacity);
+}
+
+TEST_F(LogStructuredSecondaryCacheTest, LookupFromFile) {
+  ASSERT_OK(NewLogStructuredSecondaryCache(opts_, &sec_cache_));
+  // Three entries per segment, so that the first segments are written to the
+  // file
+  Random rnd(301);
+  const int kNumEntries = 9;
+  std::vector<std::string> values;
+  for (int i = 0; i < kNumEntries; ++i) {
+    values.push_back(rnd.RandomString(1200));
+    ASSERT_OK(sec_cache_->InsertSaved(Key(i), values.back()));
+  }
+
+  for (int i = 0; i < kNumEntries; ++i) {
+    auto handle = Lookup(Key(i), /*wait=*/true);
+    ASSERT_NE(handle, nullptr);
+    ASSERT_EQ(TakeValue(handle.get()), values[i]);
+  }
+
+  // Asynchronous lookups, completed with Wait() and WaitAll()
+  std::vector<std::unique_ptr<SecondaryCacheResultHandle>> handles;
+  for (int i = 0; i < kNumEntries; ++i) {
+    handles.push_back(Lookup(Key(i), /*wait=*/false));
+    ASSERT_NE(handles.back(), nullptr);
+  }
+  handles[0]->Wait();
+  std::vector<SecondaryCacheResultHandle*> pending;
+  for (int i = 1; i < kNumEntries; ++i) {
+    if (!handles[i]->IsReady()) {
+      pending.push_back(handles[i].get());
+    }
+  }
+  sec_cache_->WaitAll(pending);
+  for (int i = 0; i < kNumEntries; ++i) {
+    ASSERT_EQ(TakeValue(handles[i].get()), values[i]);
+  }
+}
+
+TEST_F(LogStructuredSecondaryCacheTest, SegmentEviction) {
+  ASSERT_OK(NewLogStructuredSecondaryCache(opts_, &sec_cache_));
+  auto* cache = static_cast<LogStructuredSecondaryCache*>(sec_cache_.get());
+  Random rnd(301);
+  const int kNumEntries = 30;
+  std::vector<std::string> values;
+  for (int i = 0; i < kNumEntries; ++i) {
+    values.push_back(rnd.RandomString(1200));
+    ASSERT_OK(sec_cache_->InsertSaved(Key(i), values.back()));
+  }
+  // At most three entries in each of the four segments
+  ASSERT_LE(cache->TEST_NumEntries(), 12u);
+  ASSERT_GE(cache->TEST_NumEntries(), 9u);
+
+  // The oldest entries are evicted, the newest are kept
+  ASSERT_EQ(Lookup(Key(0), /*wait=*/true), nullptr);
+  for (int i = kNumEntries - 9; i < kNumEntries; ++i) {
+    auto handle = Lookup(Key(i), /*wait=*/true);
+    ASSERT_NE(handle, nullptr);
+    ASSERT_EQ(TakeValue(handle.get()), values[i]);
+  }
+
+  // Entries are not inserted again unless forced
+  ASSERT_OK(sec_cache_->InsertSaved(Key(kNumEntries - 1), "new value"));
+  auto handle = Lookup(Key(kNumEntries - 1), /*wait=*/true);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_EQ(TakeValue(handle.get()), values[kNumEntries - 1]);
+  TestItem item("new value", 9);
+  ASSERT_OK(sec_cache_->Insert(Key(kNumEntries - 1), &item,
+                               WithCacheType::GetHelper(),
+                               /*force_insert=*/true));
+  handle = Lookup(Key(kNumEntries - 1), /*wait=*/true);
+  ASSERT_NE(handle, nullptr);
+  ASSERT_EQ(TakeValue(handle.get()), "new value");
+}
+
+TEST_F(LogStructuredSecondaryCacheTest, InvalidOptions) {
+  opts_.capacity = opts_.segment_size;
+  ASSERT_TRUE(NewLogStructuredSecondaryCache(opts_, &sec_cache_)
+                  .IsInvalidArgument());
+  opts_.capacity = 4 * opts_.segment_size;
+  opts_.file_path.clear();
+  ASSERT_TRUE(NewLogStructuredSecondaryCache(opts_, &sec_cache_)
+                  .IsInvalidArgument());
+  ASSERT_EQ(sec_cache_, nullptr);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2248,6 +2248,91 @@ TEST_P(DBSecondaryCacheTest, LRUCacheDumpLoadBasic) {
   Destroy(options);
 }
 
+TEST_P(DBSecondaryCacheTest, CacheDumpLoadToBlockCache) {
+  std::shared_ptr<Cache> cache =
+      NewCache(1024 * 1024 /* capacity */, 0 /* num_shard_bits */,
+               false /* strict_capacity_limit */);
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = cache;
+  table_options.block_size = 4 * 1024;
+  Options options = GetDefaultOptions();
+  options.create_if_missing = true;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  options.env = fault_env_.get();
+  options.statistics = CreateDBStatistics();
+  DestroyAndReopen(options);
+  fault_fs_->SetFailGetUniqueId(true);
+
+  Random rnd(301);
+  const int N = 256;
+  std::vector<std::string> value(N);
+  for (int i = 0; i < N; i++) {
+    value[i] = rnd.RandomString(1000);
+    ASSERT_OK(Put(Key(i), value[i]));
+  }
+  ASSERT_OK(Flush());
+  Compact("a", "z");
+  for (int i = 0; i < N; i++) {
+    ASSERT_EQ(Get(Key(i)), value[i]);
+  }
+
+  CacheDumpOptions cd_options;
+  cd_options.clock = fault_env_->GetSystemClock().get();
+  std::string dump_path = db_->GetName() + "/cache_dump";
+  std::unique_ptr<CacheDumpWriter> dump_writer;
+  ASSERT_OK(NewToFileCacheDumpWriter(fault_fs_, FileOptions(), dump_path,
+                                     &dump_writer));
+  std::unique_ptr<CacheDumper> cache_dumper;
+  ASSERT_OK(NewDefaultCacheDumper(cd_options, cache, std::move(dump_writer),
+                                  &cache_dumper));
+  ASSERT_OK(cache_dumper->SetDumpFilter({db_}));
+  ASSERT_OK(cache_dumper->DumpCacheEntriesToWriter());
+  cache_dumper.reset();
+
+  // Restart with an empty block cache, and load the dump into it
+  Close();
+  cache = NewCache(1024 * 1024 /* capacity */, 0 /* num_shard_bits */,
+                   false /* strict_capacity_limit */);
+  table_options.block_cache = cache;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  std::unique_ptr<CacheDumpReader> dump_reader;
+  ASSERT_OK(NewFromFileCacheDumpReader(fault_fs_, FileOptions(), dump_path,
+                                       &dump_reader));
+  std::unique_ptr<CacheDumpedLoader> cache_loader;
+  ASSERT_OK(NewDefaultCacheDumpedLoader(cd_options, table_options,
+                                        /*secondary_cache=*/nullptr,
+                                        std::move(dump_reader), &cache_loader));
+  ASSERT_OK(cache_loader->RestoreCacheEntriesToBlockCache());
+  ASSERT_GT(cache->GetUsage(), 0);
+
+  Reopen(options);
+  ASSERT_OK(options.statistics->Reset());
+  for (int i = 0; i < N; i++) {
+    ASSERT_EQ(Get(Key(i)), value[i]);
+  }
+  // All the data blocks are found in the block cache
+  ASSERT_EQ(options.statistics->getTickerCount(BLOCK_CACHE_DATA_MISS), 0);
+  ASSERT_GT(options.statistics->getTickerCount(BLOCK_CACHE_DATA_HIT), 0);
+
+  // Loading stops once the block cache is full
+  std::shared_ptr<Cache> small_cache =
+      NewCache(16 * 1024 /* capacity */, 0 /* num_shard_bits */,
+               false /* strict_capacity_limit */);
+  table_options.block_cache = small_cache;
+  ASSERT_OK(NewFromFileCacheDumpReader(fault_fs_, FileOptions(), dump_path,
+                                       &dump_reader));
+  ASSERT_OK(NewDefaultCacheDumpedLoader(cd_options, table_options,
+                                        /*secondary_cache=*/nullptr,
+                                        std::move(dump_reader), &cache_loader));
+  ASSERT_OK(cache_loader->RestoreCacheEntriesToBlockCache());
+  ASSERT_GT(small_cache->GetUsage(), 0);
+  ASSERT_LE(small_cache->GetUsage(), small_cache->GetCapacity());
+
+  fault_fs_->SetFailGetUniqueId(false);
+  Destroy(options);
+}
+
 TEST_P(DBSecondaryCacheTest, LRUCacheDumpLoadWithFilter) {
   std::shared_ptr<Cache> base_cache =
       NewCache(1024 * 1024 /* capacity */, 0 /* num_shard_bits */,
@@ -79,6 +79,13 @@ class ArenaWrappedDBIter : public Iterator {
   bool IsBlob() const { return db_iter_->IsBlob(); }
 
   Status GetProperty(std::string prop_name, std::string* prop) override;
+  size_t NextBatch(size_t max_entries, std::vector<PinnableSlice>* keys,
+                   std::vector<PinnableSlice>* values) override {
+    return db_iter_->NextBatch(max_entries, keys, values);
+  }
+  void PrepareSeek(const Slice& target) override {
+    db_iter_->PrepareSeek(target);
+  }
 
   Status Refresh() override;
   Status Refresh(const Snapshot*) override;
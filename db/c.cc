@@ -6896,6 +6896,43 @@ const char* rocksdb_pinnableslice_value(const rocksdb_pinnableslice_t* v,
   return v->rep.data();
 }
 
+rocksdb_pinnableslice_t* rocksdb_pinnableslice_create() {
+  return new rocksdb_pinnableslice_t;
+}
+
+void rocksdb_pinnableslice_reset(rocksdb_pinnableslice_t* v) {
+  v->rep.Reset();
+}
+
+unsigned char rocksdb_get_pinned_into(rocksdb_t* db,
+                                      const rocksdb_readoptions_t* options,
+                                      const char* key, size_t keylen,
+                                      rocksdb_pinnableslice_t* value,
+                                      char** errptr) {
+  return rocksdb_get_pinned_into_cf(
+      db, options, nullptr, key, keylen, value, errptr);
+}
+
+unsigned char rocksdb_get_pinned_into_cf(
+    rocksdb_t* db, const rocksdb_readoptions_t* options,
+    rocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, rocksdb_pinnableslice_t* value, char** errptr) {
+  value->rep.Reset();
+  Status s = db->rep->Get(options->rep,
+                          column_family == nullptr
+                              ? db->rep->DefaultColumnFamily()
+                              : column_family->rep,
+                          Slice(key, keylen), &value->rep);
+  if (!s.ok()) {
+    value->rep.Reset();
+    if (!s.IsNotFound()) {
+      SaveError(errptr, s);
+    }
+    return 0;
+  }
+  return 1;
+}
+
 // container to keep databases and caches in order to use
 // ROCKSDB_NAMESPACE::MemoryUtil
 struct rocksdb_memory_consumers_t {
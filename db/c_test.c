@@ -137,6 +137,21 @@ static void CheckPinGet(rocksdb_t* db, const rocksdb_readoptions_t* options,
   val = rocksdb_pinnableslice_value(p, &val_len);
   CheckEqual(expected, val, val_len);
   rocksdb_pinnableslice_destroy(p);
+
+  // Reading into a caller-owned slice, twice to exercise reuse
+  p = rocksdb_pinnableslice_create();
+  for (int i = 0; i < 2; i++) {
+    unsigned char found =
+        rocksdb_get_pinned_into(db, options, key, strlen(key), p, &err);
+    CheckNoError(err);
+    CheckCondition(found == (expected != NULL));
+    val = rocksdb_pinnableslice_value(p, &val_len);
+    CheckEqual(expected, found ? val : NULL, val_len);
+  }
+  rocksdb_pinnableslice_reset(p);
+  rocksdb_pinnableslice_value(p, &val_len);
+  CheckCondition(val_len == 0);
+  rocksdb_pinnableslice_destroy(p);
 }
 
 static void CheckPinGetCF(rocksdb_t* db, const rocksdb_readoptions_t* options,
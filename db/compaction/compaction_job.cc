@@ -1967,6 +1967,7 @@ Status CompactionJob::OpenCompactionOutputFile(SubcompactionState* sub_compact,
       preclude_last_level_min_seqno_ == kMaxSequenceNumber
           ? preclude_last_level_min_seqno_
           : std::min(earliest_snapshot_, preclude_last_level_min_seqno_));
+  sub_compact->compaction->input_version()->SetFilterBuildingStats(&tboptions);
 
   outputs.NewBuilder(tboptions);
 
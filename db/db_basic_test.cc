@@ -3076,6 +3076,107 @@ TEST_F(DBBasicTest, MultiGetStats) {
   ASSERT_EQ(hist_level.max, 2);
 }
 
+TEST_F(DBBasicTest, MultiGetParallelRanges) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  CreateAndReopenWithCF({"pikachu"}, options);
+
+  constexpr int kNumKeys = 1000;
+  // Every other key exists, in L2, L1 or the memtable
+  for (int cf = 0; cf < 2; ++cf) {
+    for (int i = 0; i < kNumKeys; i += 2) {
+      ASSERT_OK(Put(cf, Key(i), "l2_" + std::to_string(i)));
+    }
+    ASSERT_OK(Flush(cf));
+    MoveFilesToLevel(2, cf);
+    for (int i = 0; i < kNumKeys; i += 6) {
+      ASSERT_OK(Put(cf, Key(i), "l1_" + std::to_string(i)));
+    }
+    ASSERT_OK(Flush(cf));
+    MoveFilesToLevel(1, cf);
+    for (int i = 0; i < kNumKeys; i += 10) {
+      ASSERT_OK(Put(cf, Key(i), "mem_" + std::to_string(i)));
+    }
+  }
+
+  std::vector<size_t> num_ranges;
+  SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::ParallelMultiGetImpl:Done",
+      [&](void* arg) { num_ranges.push_back(*static_cast<size_t*>(arg)); });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  std::vector<std::string> key_strs;
+  std::vector<Slice> keys;
+  // Unsorted, the batch is sorted before being split
+  for (int i = kNumKeys - 1; i >= 0; --i) {
+    key_strs.push_back(Key(i));
+  }
+  for (const auto& key : key_strs) {
+    keys.emplace_back(key);
+  }
+
+  auto verify = [&](const std::vector<PinnableSlice>& values,
+                    const std::vector<Status>& statuses, size_t offset) {
+    for (size_t j = 0; j < key_strs.size(); ++j) {
+      const int i = kNumKeys - 1 - static_cast<int>(j);
+      const Status& s = statuses[offset + j];
+      const std::string& value = values[offset + j].ToString();
+      if (i % 2 != 0) {
+        ASSERT_TRUE(s.IsNotFound());
+      } else if (i % 10 == 0) {
+        ASSERT_OK(s);
+        ASSERT_EQ(value, "mem_" + std::to_string(i));
+      } else if (i % 6 == 0) {
+        ASSERT_OK(s);
+        ASSERT_EQ(value, "l1_" + std::to_string(i));
+      } else {
+        ASSERT_OK(s);
+        ASSERT_EQ(value, "l2_" + std::to_string(i));
+      }
+    }
+  };
+
+  ReadOptions read_opts;
+  read_opts.multiget_parallelism = 4;
+  {
+    std::vector<PinnableSlice> values(kNumKeys);
+    std::vector<Status> statuses(kNumKeys);
+    db_->MultiGet(read_opts, handles_[1], kNumKeys, keys.data(), values.data(),
+                  statuses.data());
+    verify(values, statuses, 0);
+    ASSERT_EQ(num_ranges, std::vector<size_t>({4}));
+  }
+
+  // Each column family is split separately
+  num_ranges.clear();
+  {
+    std::vector<ColumnFamilyHandle*> cfs(kNumKeys, handles_[0]);
+    cfs.resize(2 * kNumKeys, handles_[1]);
+    std::vector<Slice> cf_keys(keys);
+    cf_keys.insert(cf_keys.end(), keys.begin(), keys.end());
+    std::vector<PinnableSlice> values(2 * kNumKeys);
+    std::vector<Status> statuses(2 * kNumKeys);
+    db_->MultiGet(read_opts, 2 * kNumKeys, cfs.data(), cf_keys.data(),
+                  values.data(), statuses.data());
+    verify(values, statuses, 0);
+    verify(values, statuses, kNumKeys);
+    ASSERT_EQ(num_ranges, std::vector<size_t>({4, 4}));
+  }
+
+  // Small batches are not split
+  num_ranges.clear();
+  {
+    std::vector<PinnableSlice> values(kNumKeys);
+    std::vector<Status> statuses(kNumKeys);
+    db_->MultiGet(read_opts, handles_[1], 40, keys.data(), values.data(),
+                  statuses.data());
+    ASSERT_TRUE(num_ranges.empty());
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 // Test class for batched MultiGet with prefix extractor
 // Param bool - If true, use partitioned filters
 //              If false, use full filter block
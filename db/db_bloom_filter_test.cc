@@ -3903,6 +3903,109 @@ TEST_F(DBBloomFilterTest, SstQueryFilter) {
   EXPECT_EQ(TestGetAndResetTickerCount(options, NON_LAST_LEVEL_SEEK_DATA), 0);
 }
 
+TEST_F(DBBloomFilterTest, RangeFilter) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.range_filter_bits_per_key = 20;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // 8-byte big-endian keys, so the whole key is covered by the filter
+  auto BigEndianKey = [](uint64_t n) {
+    std::string key(sizeof(n), '\0');
+    for (size_t i = 0; i < sizeof(n); ++i) {
+      key[i] = static_cast<char>(n >> (56 - 8 * i));
+    }
+    return key;
+  };
+  // Two L0 files with overlapping key ranges but interleaved keys
+  const int kNumKeys = 100;
+  for (int file = 0; file < 2; ++file) {
+    for (int i = 0; i < kNumKeys; ++i) {
+      ASSERT_OK(Put(BigEndianKey(i * 1000 + file * 500), "v"));
+    }
+    ASSERT_OK(Flush());
+  }
+  ASSERT_OK(Delete(BigEndianKey(7000)));
+  ASSERT_OK(Flush());
+
+  int num_filtered = 0;
+  for (int i = 0; i < kNumKeys; ++i) {
+    std::string lower = BigEndianKey(i * 1000);
+    std::string upper = BigEndianKey(i * 1000 + 100);
+    Slice upper_bound(upper);
+    ReadOptions read_options;
+    read_options.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek(lower);
+    if (i == 7) {
+      // Deleted, so the file with the tombstone must not be skipped
+      ASSERT_FALSE(iter->Valid());
+    } else {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(lower, iter->key());
+      iter->Next();
+      ASSERT_FALSE(iter->Valid());
+    }
+    ASSERT_OK(iter->status());
+    num_filtered += static_cast<int>(
+        TestGetAndResetTickerCount(options, NON_LAST_LEVEL_SEEK_FILTERED));
+  }
+  // The file with keys i * 1000 + 500 is skipped for nearly every range
+  EXPECT_GE(num_filtered, kNumKeys * 8 / 10);
+
+  // SeekToFirst() uses iterate_lower_bound
+  {
+    std::string lower = BigEndianKey(2000);
+    std::string upper = BigEndianKey(2001);
+    Slice lower_bound(lower);
+    Slice upper_bound(upper);
+    ReadOptions read_options;
+    read_options.iterate_lower_bound = &lower_bound;
+    read_options.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(lower, iter->key());
+    iter->Next();
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+    EXPECT_GE(TestGetAndResetTickerCount(options, NON_LAST_LEVEL_SEEK_FILTERED),
+              1);
+  }
+
+  // Without an upper bound, the range filter is not used
+  {
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    iter->Seek(BigEndianKey(3000));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(BigEndianKey(3000), iter->key());
+    iter->Next();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(BigEndianKey(3500), iter->key());
+    ASSERT_OK(iter->status());
+    EXPECT_EQ(TestGetAndResetTickerCount(options, NON_LAST_LEVEL_SEEK_FILTERED),
+              0);
+  }
+
+  // A range deletion disables skipping of the file that has it
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             BigEndianKey(4000), BigEndianKey(4001)));
+  ASSERT_OK(Flush());
+  {
+    std::string upper = BigEndianKey(4100);
+    Slice upper_bound(upper);
+    ReadOptions read_options;
+    read_options.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+    iter->Seek(BigEndianKey(4000));
+    ASSERT_FALSE(iter->Valid());
+    ASSERT_OK(iter->status());
+  }
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
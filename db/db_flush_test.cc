@@ -1903,6 +1903,89 @@ TEST_P(DBFlushDirectIOTest, DirectIO) {
   delete options.env;
 }
 
+TEST_F(DBFlushTest, PartitionedFlush) {
+  Options options = CurrentOptions();
+  options.env = env_;
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.max_flush_partitions = 4;
+  Reopen(options);
+
+  // Partition any non-empty flush.
+  SyncPoint::GetInstance()->SetCallBack(
+      "FlushJob::PickPartitionBoundaries:min_partition_size",
+      [](void* arg) { *static_cast<uint64_t*>(arg) = 1; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  const int kNumKeys = 10000;
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), "v1_" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  const int num_files = NumTableFilesAtLevel(0);
+  ASSERT_GT(num_files, 1);
+  ASSERT_LE(num_files, 4);
+
+  // The output files cover disjoint key ranges.
+  std::vector<LiveFileMetaData> metadata;
+  db_->GetLiveFilesMetaData(&metadata);
+  ASSERT_EQ(static_cast<size_t>(num_files), metadata.size());
+  std::sort(metadata.begin(), metadata.end(),
+            [](const LiveFileMetaData& a, const LiveFileMetaData& b) {
+              return a.smallestkey < b.smallestkey;
+            });
+  for (size_t i = 1; i < metadata.size(); i++) {
+    ASSERT_LT(metadata[i - 1].largestkey, metadata[i].smallestkey);
+  }
+
+  // Overwrite and delete some keys, so that reads have to go through the
+  // newer partitioned flush first.
+  for (int i = 0; i < kNumKeys; i += 2) {
+    ASSERT_OK(Put(Key(i), "v2_" + std::to_string(i)));
+  }
+  for (int i = 1; i < kNumKeys; i += 10) {
+    ASSERT_OK(Delete(Key(i)));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_GT(NumTableFilesAtLevel(0), num_files + 1);
+
+  auto verify = [&]() {
+    for (int i = 0; i < kNumKeys; i++) {
+      if (i % 2 == 0) {
+        ASSERT_EQ("v2_" + std::to_string(i), Get(Key(i)));
+      } else if (i % 10 == 1) {
+        ASSERT_EQ("NOT_FOUND", Get(Key(i)));
+      } else {
+        ASSERT_EQ("v1_" + std::to_string(i), Get(Key(i)));
+      }
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      count++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys - kNumKeys / 10, count);
+  };
+  verify();
+  Reopen(options);
+  verify();
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  verify();
+
+  // Range deletions are not split across partitions.
+  ASSERT_OK(db_->DeleteRange(WriteOptions(), db_->DefaultColumnFamily(),
+                             Key(0), Key(10)));
+  ASSERT_OK(Put(Key(0), "v3"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(1, NumTableFilesAtLevel(0));
+  ASSERT_EQ("v3", Get(Key(0)));
+  ASSERT_EQ("NOT_FOUND", Get(Key(2)));
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
+
 TEST_F(DBFlushTest, FlushError) {
   Options options;
   std::unique_ptr<FaultInjectionTestEnv> fault_injection_env(
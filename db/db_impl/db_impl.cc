@@ -14,9 +14,11 @@
 #endif
 
 #include <cinttypes>
+#include <condition_variable>
 #include <cstdio>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <stdexcept>
@@ -218,6 +220,7 @@ DBImpl::DBImpl(const DBOptions& options, const std::string& dbname,
       bg_flush_scheduled_(0),
       num_running_flushes_(0),
       bg_purge_scheduled_(0),
+      bg_open_files_scheduled_(0),
       disable_delete_obsolete_files_(0),
       pending_purge_obsolete_files_(0),
       delete_obsolete_files_last_run_(immutable_db_options_.clock->NowMicros()),
@@ -567,7 +570,7 @@ Status DBImpl::CloseHelper() {
   // Wait for background work to finish
   while (bg_bottom_compaction_scheduled_ || bg_compaction_scheduled_ ||
          bg_flush_scheduled_ || bg_purge_scheduled_ ||
-         pending_purge_obsolete_files_ ||
+         bg_open_files_scheduled_ || pending_purge_obsolete_files_ ||
          error_handler_.IsRecoveryInProgress()) {
     TEST_SYNC_POINT("DBImpl::~DBImpl:WaitJob");
     bg_cv_.Wait();
@@ -748,6 +751,10 @@ DBImpl::~DBImpl() {
     closing_status_ = CloseImpl();
     closing_status_.PermitUncheckedError();
   }
+  if (multiget_thread_pool_) {
+    // No MultiGet is running anymore, so the pool has no jobs left
+    multiget_thread_pool_->JoinAllThreads();
+  }
   ThreadStatusUtil::SetThreadOperation(cur_op_type);
 }
 
@@ -1927,6 +1934,52 @@ void DBImpl::SchedulePurge() {
   env_->Schedule(&DBImpl::BGWorkPurge, this, Env::Priority::HIGH, nullptr);
 }
 
+void DBImpl::ScheduleOpenTableFiles() {
+  mutex_.AssertHeld();
+
+  bg_open_files_scheduled_++;
+  env_->Schedule(&DBImpl::BGWorkOpenTableFiles, this, Env::Priority::LOW,
+                 nullptr);
+}
+
+void DBImpl::BackgroundCallOpenTableFiles() {
+  mutex_.Lock();
+  std::vector<Version*> versions;
+  if (!shutting_down_.load(std::memory_order_acquire)) {
+    for (ColumnFamilyData* cfd : *versions_->GetColumnFamilySet()) {
+      if (cfd->IsDropped() || !cfd->initialized()) {
+        continue;
+      }
+      cfd->Ref();
+      Version* current = cfd->current();
+      current->Ref();
+      versions.push_back(current);
+    }
+  }
+  mutex_.Unlock();
+
+  // TODO: plumb Env::IOActivity, Env::IOPriority
+  const ReadOptions read_options;
+  for (Version* version : versions) {
+    version->OpenTableFiles(read_options,
+                            immutable_db_options_.max_file_opening_threads,
+                            shutting_down_);
+  }
+
+  mutex_.Lock();
+  for (Version* version : versions) {
+    ColumnFamilyData* cfd = version->cfd();
+    version->Unref();
+    cfd->UnrefAndTryDelete();
+  }
+  assert(bg_open_files_scheduled_ > 0);
+  bg_open_files_scheduled_--;
+  bg_cv_.SignalAll();
+  // IMPORTANT: there should be no code after calling SignalAll. This call may
+  // signal the DB destructor that it's OK to proceed with destruction.
+  mutex_.Unlock();
+}
+
 void DBImpl::BackgroundCallPurge() {
   TEST_SYNC_POINT("DBImpl::BackgroundCallPurge:beforeMutexLock");
   mutex_.Lock();
@@ -2181,6 +2234,7 @@ Status DBImpl::GetEntity(const ReadOptions& _read_options,
     read_options.io_activity = Env::IOActivity::kGetEntity;
   }
   columns->Reset();
+  columns->SetProjection(read_options.wide_column_projection);
 
   GetImplOptions get_impl_options;
   get_impl_options.column_family = column_family;
@@ -2842,6 +2896,7 @@ void DBImpl::MultiGetCommon(const ReadOptions& read_options,
 
       col = &columns[i];
       col->Reset();
+      col->SetProjection(read_options.wide_column_projection);
     }
 
     key_context.emplace_back(column_families[i], keys[i], val, col,
@@ -2906,10 +2961,10 @@ void DBImpl::MultiGetCommon(const ReadOptions& read_options,
   auto cf_sv_pair_iter = cf_sv_pairs.begin();
   while (key_range_per_cf_iter != key_range_per_cf.end() &&
          cf_sv_pair_iter != cf_sv_pairs.end()) {
-    s = MultiGetImpl(read_options, key_range_per_cf_iter->start,
-                     key_range_per_cf_iter->num_keys, &sorted_keys,
-                     cf_sv_pair_iter->super_version, consistent_seqnum,
-                     read_callback);
+    s = ParallelMultiGetImpl(read_options, key_range_per_cf_iter->start,
+                             key_range_per_cf_iter->num_keys, &sorted_keys,
+                             cf_sv_pair_iter->super_version, consistent_seqnum,
+                             read_callback);
     if (!s.ok()) {
       break;
     }
@@ -3032,6 +3087,7 @@ void DBImpl::MultiGetCommon(const ReadOptions& read_options,
 
       col = &columns[i];
       col->Reset();
+      col->SetProjection(read_options.wide_column_projection);
     }
 
     key_context.emplace_back(column_family, keys[i], val, col,
@@ -3115,14 +3171,86 @@ void DBImpl::MultiGetWithCallbackImpl(
     read_callback = &timestamp_read_callback;
   }
 
-  s = MultiGetImpl(read_options, 0, num_keys, sorted_keys,
-                   cf_sv_pairs[0].super_version, consistent_seqnum,
-                   read_callback);
+  if (callback) {
+    // Transaction read callbacks are not necessarily thread safe
+    s = MultiGetImpl(read_options, 0, num_keys, sorted_keys,
+                     cf_sv_pairs[0].super_version, consistent_seqnum,
+                     read_callback);
+  } else {
+    s = ParallelMultiGetImpl(read_options, 0, num_keys, sorted_keys,
+                             cf_sv_pairs[0].super_version, consistent_seqnum,
+                             read_callback);
+  }
   assert(s.ok() || s.IsTimedOut() || s.IsAborted());
   ReturnAndCleanupSuperVersion(cf_sv_pairs[0].cfd,
                                cf_sv_pairs[0].super_version);
 }
 
+Status DBImpl::ParallelMultiGetImpl(
+    const ReadOptions& read_options, size_t start_key, size_t num_keys,
+    autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
+    SuperVersion* super_version, SequenceNumber snapshot,
+    ReadCallback* callback) {
+  // Every range gets at least one full batch
+  const size_t num_ranges =
+      std::min(read_options.multiget_parallelism,
+               num_keys / MultiGetContext::MAX_BATCH_SIZE);
+  if (num_ranges <= 1) {
+    return MultiGetImpl(read_options, start_key, num_keys, sorted_keys,
+                        super_version, snapshot, callback);
+  }
+
+  ThreadPoolImpl* thread_pool;
+  {
+    InstrumentedMutexLock lock(&multiget_thread_pool_mutex_);
+    if (!multiget_thread_pool_) {
+      multiget_thread_pool_.reset(new ThreadPoolImpl());
+      multiget_thread_pool_->SetHostEnv(env_);
+    }
+    multiget_thread_pool_->IncBackgroundThreadsIfNeeded(
+        static_cast<int>(num_ranges - 1));
+    thread_pool = multiget_thread_pool_.get();
+  }
+
+  // The keys are sorted, so each range covers a disjoint part of the key space
+  // and only touches the files overlapping with it
+  std::vector<Status> range_statuses(num_ranges);
+  auto lookup_range = [&](size_t range) {
+    const size_t range_start = start_key + num_keys * range / num_ranges;
+    const size_t range_end = start_key + num_keys * (range + 1) / num_ranges;
+    range_statuses[range] =
+        MultiGetImpl(read_options, range_start, range_end - range_start,
+                     sorted_keys, super_version, snapshot, callback);
+  };
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t ranges_pending = num_ranges - 1;
+  for (size_t range = 1; range < num_ranges; ++range) {
+    thread_pool->SubmitJob([&, range]() {
+      lookup_range(range);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--ranges_pending == 0) {
+        cv.notify_one();
+      }
+    });
+  }
+  lookup_range(0);
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() { return ranges_pending == 0; });
+  }
+  TEST_SYNC_POINT_CALLBACK("DBImpl::ParallelMultiGetImpl:Done",
+                           const_cast<size_t*>(&num_ranges));
+
+  for (const auto& s : range_statuses) {
+    if (!s.ok()) {
+      return s;
+    }
+  }
+  return Status::OK();
+}
+
 // The actual implementation of batched MultiGet. Parameters -
 // start_key - Index in the sorted_keys vector to start processing from
 // num_keys - Number of keys to lookup, starting with sorted_keys[start_key]
@@ -67,6 +67,7 @@
 #include "util/repeatable_thread.h"
 #include "util/stop_watch.h"
 #include "util/thread_local.h"
+#include "util/threadpool_imp.h"
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -873,6 +874,10 @@ class DBImpl : public DB {
   // Schedule a background job to actually delete obsolete files.
   void SchedulePurge();
 
+  // Schedules opening the table files that DB::Open() left unopened with
+  // open_files_in_background
+  void ScheduleOpenTableFiles();
+
   const SnapshotList& snapshots() const { return snapshots_; }
 
   // load list of snapshots to `snap_vector` that is no newer than `max_seq`
@@ -1348,6 +1353,10 @@ class DBImpl : public DB {
       recovered_transactions_;
   std::unique_ptr<Tracer> tracer_;
   InstrumentedMutex trace_mutex_;
+  // Created on the first MultiGet with ReadOptions::multiget_parallelism > 1,
+  // and grown to the largest parallelism requested.
+  std::unique_ptr<ThreadPoolImpl> multiget_thread_pool_;
+  InstrumentedMutex multiget_thread_pool_mutex_;
   BlockCacheTracer block_cache_tracer_;
 
   // constant false canceled flag, used when the compaction is not manual
@@ -2154,6 +2163,31 @@ class DBImpl : public DB {
                       SequenceNumber sequence,
                       LogFileNumberSize& log_file_number_size);
 
+  // With parallel_wal_checksum, the batches of a write group are written to
+  // the WAL as the same record as MergeBatch() and WriteToWAL() would write,
+  // but passed to the log writer as separate pieces with the checksums
+  // computed by their writers. PrepareWALPieces() collects the pieces of the
+  // batches without the header, and needs no lock.
+  Status PrepareWALPieces(const WriteThread::WriteGroup& write_group,
+                          std::vector<log::RecordPiece>* pieces,
+                          uint32_t* count, size_t* write_with_wal,
+                          WriteBatch** to_be_cached_state);
+
+  // Writes the record prepared by PrepareWALPieces() with a header for
+  // `sequence` and `count` entries. Requires the same synchronization as
+  // WriteToWAL().
+  IOStatus WriteWALPieces(const WriteThread::WriteGroup& write_group,
+                          const WriteOptions& write_options,
+                          log::Writer* log_writer,
+                          std::vector<log::RecordPiece>* pieces,
+                          uint32_t count, SequenceNumber sequence,
+                          uint64_t* log_used, uint64_t* log_size,
+                          LogFileNumberSize& log_file_number_size);
+
+  // With parallel_wal_checksum, computes the checksum of the WAL part of the
+  // batch of `w` in its own thread, before it joins a write group.
+  void MaybeComputeWALPayloadChecksum(WriteThread::Writer* w);
+
   IOStatus ConcurrentWriteToWAL(const WriteThread::WriteGroup& write_group,
                                 uint64_t* log_used,
                                 SequenceNumber* last_sequence, size_t seq_inc);
@@ -2221,12 +2255,14 @@ class DBImpl : public DB {
   static void BGWorkBottomCompaction(void* arg);
   static void BGWorkFlush(void* arg);
   static void BGWorkPurge(void* arg);
+  static void BGWorkOpenTableFiles(void* arg);
   static void UnscheduleCompactionCallback(void* arg);
   static void UnscheduleFlushCallback(void* arg);
   void BackgroundCallCompaction(PrepickedCompaction* prepicked_compaction,
                                 Env::Priority thread_pri);
   void BackgroundCallFlush(Env::Priority thread_pri);
   void BackgroundCallPurge();
+  void BackgroundCallOpenTableFiles();
   Status BackgroundCompaction(bool* madeProgress, JobContext* job_context,
                               LogBuffer* log_buffer,
                               PrepickedCompaction* prepicked_compaction,
@@ -2477,6 +2513,14 @@ class DBImpl : public DB {
       autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
       SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback);
 
+  // Same as MultiGetImpl(), but splits the keys into up to
+  // read_options.multiget_parallelism ranges that are looked up concurrently
+  // in the current thread and in multiget_thread_pool_.
+  Status ParallelMultiGetImpl(
+      const ReadOptions& read_options, size_t start_key, size_t num_keys,
+      autovector<KeyContext*, MultiGetContext::MAX_BATCH_SIZE>* sorted_keys,
+      SuperVersion* sv, SequenceNumber snap_seqnum, ReadCallback* callback);
+
   void MultiGetWithCallbackImpl(
       const ReadOptions& read_options, ColumnFamilyHandle* column_family,
       ReadCallback* callback,
@@ -2686,6 +2730,9 @@ class DBImpl : public DB {
 
   WriteThread write_thread_;
   WriteBatch tmp_batch_;
+  // The pieces of a WAL record written by WriteToWAL() with
+  // parallel_wal_checksum
+  std::vector<log::RecordPiece> tmp_wal_pieces_;
   // The write thread when the writers have no memtable write. This will be used
   // in 2PC to batch the prepares separately from the serial commit.
   WriteThread nonmem_write_thread_;
@@ -2777,6 +2824,10 @@ class DBImpl : public DB {
   // number of background obsolete file purge jobs, submitted to the HIGH pool
   int bg_purge_scheduled_;
 
+  // number of background jobs opening table files after DB::Open(), submitted
+  // to the LOW pool
+  int bg_open_files_scheduled_;
+
   std::deque<ManualCompactionState*> manual_compaction_dequeue_;
 
   // shall we disable deletion of obsolete files
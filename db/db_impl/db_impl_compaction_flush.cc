@@ -367,13 +367,15 @@ Status DBImpl::FlushMemTableToOutputFile(
     auto sfm = static_cast<SstFileManagerImpl*>(
         immutable_db_options_.sst_file_manager.get());
     if (sfm) {
-      // Notify sst_file_manager that a new file was added
-      std::string file_path = MakeTableFileName(
-          cfd->ioptions()->cf_paths[0].path, file_meta.fd.GetNumber());
-      // TODO (PR7798).  We should only add the file to the FileManager if it
-      // exists. Otherwise, some tests may fail.  Ignore the error in the
-      // interim.
-      sfm->OnAddFile(file_path).PermitUncheckedError();
+      // Notify sst_file_manager that new files were added
+      for (uint64_t file_number : flush_job.GetOutputFileNumbers()) {
+        std::string file_path = MakeTableFileName(
+            cfd->ioptions()->cf_paths[0].path, file_number);
+        // TODO (PR7798).  We should only add the file to the FileManager if
+        // it exists. Otherwise, some tests may fail.  Ignore the error in the
+        // interim.
+        sfm->OnAddFile(file_path).PermitUncheckedError();
+      }
       if (sfm->IsMaxAllowedSpaceReached()) {
         Status new_bg_error =
             Status::SpaceLimit("Max allowed space was reached");
@@ -833,12 +835,14 @@ Status DBImpl::AtomicFlushMemTablesToOutputFiles(
       NotifyOnFlushCompleted(cfds[i], all_mutable_cf_options[i],
                              jobs[i]->GetCommittedFlushJobsInfo());
       if (sfm) {
-        std::string file_path = MakeTableFileName(
-            cfds[i]->ioptions()->cf_paths[0].path, file_meta[i].fd.GetNumber());
-        // TODO (PR7798).  We should only add the file to the FileManager if it
-        // exists. Otherwise, some tests may fail.  Ignore the error in the
-        // interim.
-        sfm->OnAddFile(file_path).PermitUncheckedError();
+        for (uint64_t file_number : jobs[i]->GetOutputFileNumbers()) {
+          std::string file_path = MakeTableFileName(
+              cfds[i]->ioptions()->cf_paths[0].path, file_number);
+          // TODO (PR7798).  We should only add the file to the FileManager if
+          // it exists. Otherwise, some tests may fail.  Ignore the error in
+          // the interim.
+          sfm->OnAddFile(file_path).PermitUncheckedError();
+        }
         if (sfm->IsMaxAllowedSpaceReached() &&
             error_handler_.GetBGError().ok()) {
           Status new_bg_error =
@@ -3101,6 +3105,13 @@ void DBImpl::BGWorkPurge(void* db) {
   TEST_SYNC_POINT("DBImpl::BGWorkPurge:end");
 }
 
+void DBImpl::BGWorkOpenTableFiles(void* db) {
+  IOSTATS_SET_THREAD_POOL_ID(Env::Priority::LOW);
+  TEST_SYNC_POINT("DBImpl::BGWorkOpenTableFiles:start");
+  static_cast<DBImpl*>(db)->BackgroundCallOpenTableFiles();
+  TEST_SYNC_POINT("DBImpl::BGWorkOpenTableFiles:end");
+}
+
 void DBImpl::UnscheduleCompactionCallback(void* arg) {
   CompactionArg* ca_ptr = static_cast<CompactionArg*>(arg);
   Env::Priority compaction_pri = ca_ptr->compaction_pri_;
@@ -12,6 +12,7 @@
 #include "db/db_impl/db_impl.h"
 #include "db/error_handler.h"
 #include "db/periodic_task_scheduler.h"
+#include "db/wal_replay_pipeline.h"
 #include "env/composite_env_wrapper.h"
 #include "file/filename.h"
 #include "file/read_write_util.h"
@@ -25,6 +26,7 @@
 #include "rocksdb/table.h"
 #include "rocksdb/wal_filter.h"
 #include "test_util/sync_point.h"
+#include "util/defer.h"
 #include "util/rate_limiter_impl.h"
 #include "util/string_util.h"
 #include "util/udt_util.h"
@@ -1146,6 +1148,64 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     min_wal_number =
         std::max(min_wal_number, versions_->MinLogNumberWithUnflushedData());
   }
+  const bool ignore_corruption =
+      !immutable_db_options_.paranoid_checks ||
+      immutable_db_options_.wal_recovery_mode ==
+          WALRecoveryMode::kSkipAnyCorruptedRecords;
+
+  // With wal_recovery_threads > 1, WAL records are read ahead on a
+  // background thread. If memtables also allow concurrent writes, batches are
+  // inserted on a pool of threads, and memtables that fill up are switched
+  // out and flushed, in the order they filled up, while insertion continues.
+  constexpr size_t kMaxPendingWalRecords = 256;
+  constexpr size_t kMaxPendingWalBatches = 256;
+  const bool read_ahead = immutable_db_options_.wal_recovery_threads > 1;
+  std::deque<std::pair<ColumnFamilyData*, MemTable*>> memtables_to_flush;
+  Defer release_memtables_to_flush([&memtables_to_flush]() {
+    for (auto& cfd_and_mem : memtables_to_flush) {
+      delete cfd_and_mem.second->Unref();
+      cfd_and_mem.first->UnrefAndTryDelete();
+    }
+  });
+  std::unique_ptr<ConcurrentWalBatchInserter> concurrent_inserter;
+  if (read_ahead && immutable_db_options_.allow_concurrent_memtable_write &&
+      !allow_2pc() && !seq_per_batch_) {
+    concurrent_inserter.reset(new ConcurrentWalBatchInserter(
+        immutable_db_options_.wal_recovery_threads - 1,
+        column_family_memtables_.get(), &flush_scheduler_,
+        &trim_history_scheduler_, this, kMaxPendingWalBatches));
+  }
+  auto flush_next_memtable = [&]() {
+    ColumnFamilyData* cfd = memtables_to_flush.front().first;
+    MemTable* mem = memtables_to_flush.front().second;
+    memtables_to_flush.pop_front();
+    auto iter = version_edits.find(cfd->GetID());
+    assert(iter != version_edits.end());
+    Status s = WriteLevel0TableForRecovery(job_id, cfd, mem, &iter->second);
+    delete mem->Unref();
+    cfd->UnrefAndTryDelete();
+    flushed = true;
+    return s;
+  };
+  auto wait_for_concurrent_inserts = [&]() {
+    Status s = concurrent_inserter->WaitForPending();
+    MaybeIgnoreError(&s);
+    if (!s.ok() && ignore_corruption) {
+      ROCKS_LOG_WARN(immutable_db_options_.info_log,
+                     "(ignoring error) failed to insert WAL batch: %s",
+                     s.ToString().c_str());
+      s = Status::OK();
+    }
+    return s;
+  };
+  auto finish_concurrent_replay = [&]() {
+    Status s = wait_for_concurrent_inserts();
+    while (s.ok() && !memtables_to_flush.empty()) {
+      s = flush_next_memtable();
+    }
+    return s;
+  };
+
   for (auto wal_number : wal_numbers) {
     if (wal_number < min_wal_number) {
       ROCKS_LOG_INFO(immutable_db_options_.info_log,
@@ -1204,19 +1264,27 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     reporter.info_log = immutable_db_options_.info_log.get();
     reporter.fname = fname.c_str();
     reporter.old_log_record = &old_log_record;
-    if (!immutable_db_options_.paranoid_checks ||
-        immutable_db_options_.wal_recovery_mode ==
-            WALRecoveryMode::kSkipAnyCorruptedRecords) {
+    if (ignore_corruption) {
       reporter.status = nullptr;
     } else {
       reporter.status = &status;
     }
+    // When reading ahead, the reader reports into its own status, which only
+    // applies if replay got to the end of what the reader read
+    LogReporter read_ahead_reporter = reporter;
+    Status read_ahead_status;
+    bool read_ahead_old_log_record = false;
+    read_ahead_reporter.old_log_record = &read_ahead_old_log_record;
+    if (reporter.status != nullptr) {
+      read_ahead_reporter.status = &read_ahead_status;
+    }
     // We intentially make log::Reader do checksumming even if
     // paranoid_checks==false so that corruptions cause entire commits
     // to be skipped instead of propagating bad information (like overly
     // large sequence numbers).
     log::Reader reader(immutable_db_options_.info_log, std::move(file_reader),
-                       &reporter, true /*checksum*/, wal_number);
+                       read_ahead ? &read_ahead_reporter : &reporter,
+                       true /*checksum*/, wal_number);
 
     // Determine if we should tolerate incomplete records at the tail end of the
     // Read all the records and add to a memtable
@@ -1229,11 +1297,27 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
     TEST_SYNC_POINT_CALLBACK("DBImpl::RecoverLogFiles:BeforeReadWal",
                              /*arg=*/nullptr);
     uint64_t record_checksum;
-    while (!stop_replay_by_wal_filter &&
-           reader.ReadRecord(&record, &scratch,
-                             immutable_db_options_.wal_recovery_mode,
-                             &record_checksum) &&
-           status.ok()) {
+    std::unique_ptr<WalRecordReadAhead> record_read_ahead;
+    WalRecordReadAhead::Record read_ahead_record;
+    if (read_ahead) {
+      record_read_ahead.reset(new WalRecordReadAhead(
+          &reader, immutable_db_options_.wal_recovery_mode,
+          read_ahead_reporter.status, kMaxPendingWalRecords));
+    }
+    auto read_record = [&]() {
+      if (record_read_ahead == nullptr) {
+        return reader.ReadRecord(&record, &scratch,
+                                 immutable_db_options_.wal_recovery_mode,
+                                 &record_checksum);
+      }
+      if (!record_read_ahead->Next(&read_ahead_record)) {
+        return false;
+      }
+      record = read_ahead_record.contents;
+      record_checksum = read_ahead_record.checksum;
+      return true;
+    };
+    while (!stop_replay_by_wal_filter && read_record() && status.ok()) {
       if (record.size() < WriteBatchInternal::kHeader) {
         reporter.Corruption(record.size(),
                             Status::Corruption("log record too small"));
@@ -1250,7 +1334,8 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
       }
 
       const UnorderedMap<uint32_t, size_t>& record_ts_sz =
-          reader.GetRecordedTimestampSize();
+          record_read_ahead != nullptr ? *read_ahead_record.ts_sz
+                                       : reader.GetRecordedTimestampSize();
       status = HandleWriteBatchTimestampSizeDifference(
           &batch, running_ts_sz, record_ts_sz,
           TimestampSizeConsistencyMode::kReconcileInconsistency, &new_batch);
@@ -1305,6 +1390,50 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
         continue;
       }
 
+      // Like the write path, batches with merges are not inserted
+      // concurrently
+      if (concurrent_inserter != nullptr && !batch_to_use->HasMerge()) {
+        // Without seq_per_batch_, each entry of the batch takes a sequence
+        // number, whether or not it is inserted
+        *next_sequence = sequence + WriteBatchInternal::Count(batch_to_use);
+        concurrent_inserter->Schedule(
+            batch_updated ? std::move(new_batch)
+                          : std::make_unique<WriteBatch>(std::move(batch)),
+            wal_number);
+        if (!read_only && !flush_scheduler_.Empty()) {
+          // Switch the full memtables once the batches inserted into them are
+          // done. They are flushed later, while new batches are inserted.
+          status = wait_for_concurrent_inserts();
+          if (!status.ok()) {
+            return status;
+          }
+          ColumnFamilyData* cfd;
+          while ((cfd = flush_scheduler_.TakeNextColumnFamily()) != nullptr) {
+            assert(cfd->GetLogNumber() <= wal_number);
+            MemTable* mem = cfd->mem();
+            mem->Ref();
+            cfd->CreateNewMemtable(*cfd->GetLatestMutableCFOptions(),
+                                   *next_sequence - 1);
+            // Keeps the reference on cfd taken by the flush scheduler
+            memtables_to_flush.emplace_back(cfd, mem);
+          }
+        } else if (!memtables_to_flush.empty() &&
+                   concurrent_inserter->NumPending() >=
+                       kMaxPendingWalBatches / 2) {
+          status = flush_next_memtable();
+          if (!status.ok()) {
+            return status;
+          }
+        }
+        continue;
+      }
+      if (concurrent_inserter != nullptr) {
+        status = finish_concurrent_replay();
+        if (!status.ok()) {
+          return status;
+        }
+      }
+
       // If column family was not found, it might mean that the WAL write
       // batch references to the column family that was dropped after the
       // insert. We don't want to fail the whole write batch in that case --
@@ -1351,6 +1480,26 @@ Status DBImpl::RecoverLogFiles(const std::vector<uint64_t>& wal_numbers,
       }
     }
 
+    if (concurrent_inserter != nullptr) {
+      Status s = finish_concurrent_replay();
+      if (!s.ok()) {
+        status.PermitUncheckedError();
+        return s;
+      }
+    }
+    if (record_read_ahead != nullptr) {
+      const bool replayed_all_read = record_read_ahead->ReachedEnd();
+      // Waits for the read-ahead thread before looking at what it reported
+      record_read_ahead.reset();
+      if (replayed_all_read) {
+        if (status.ok()) {
+          status = read_ahead_status;
+        }
+        old_log_record = old_log_record || read_ahead_old_log_record;
+      }
+    }
+    read_ahead_status.PermitUncheckedError();
+
     if (!status.ok() || old_log_record) {
       if (status.IsNotSupported()) {
         // We should not treat NotSupported as corruption. It is rather a clear
@@ -2273,6 +2422,10 @@ Status DBImpl::Open(const DBOptions& db_options, const std::string& dbname,
     impl->DeleteObsoleteFiles();
     TEST_SYNC_POINT("DBImpl::Open:AfterDeleteFiles");
     impl->MaybeScheduleFlushOrCompaction();
+    if (impl->immutable_db_options_.open_files_in_background &&
+        impl->mutable_db_options_.max_open_files == -1) {
+      impl->ScheduleOpenTableFiles();
+    }
     impl->mutex_.Unlock();
   }
 
@@ -16,6 +16,8 @@
 #include "options/options_helper.h"
 #include "test_util/sync_point.h"
 #include "util/cast_util.h"
+#include "util/coding.h"
+#include "util/crc32c.h"
 
 namespace ROCKSDB_NAMESPACE {
 // Convenience methods
@@ -347,6 +349,7 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
                         pre_release_callback, post_memtable_callback);
   StopWatch write_sw(immutable_db_options_.clock, stats_, DB_WRITE);
 
+  MaybeComputeWALPayloadChecksum(&w);
   write_thread_.JoinBatchGroup(&w);
   if (w.state == WriteThread::STATE_PARALLEL_MEMTABLE_CALLER) {
     write_thread_.SetMemWritersEachStride(&w);
@@ -713,6 +716,7 @@ Status DBImpl::PipelinedWriteImpl(const WriteOptions& write_options,
   WriteThread::Writer w(write_options, my_batch, callback, user_write_cb,
                         log_ref, disable_memtable, /*_batch_cnt=*/0,
                         /*_pre_release_callback=*/nullptr);
+  MaybeComputeWALPayloadChecksum(&w);
   write_thread_.JoinBatchGroup(&w);
   TEST_SYNC_POINT("DBImplWrite::PipelinedWriteImpl:AfterJoinBatchGroup");
   if (w.state == WriteThread::STATE_GROUP_LEADER) {
@@ -954,6 +958,7 @@ Status DBImpl::WriteImplWALOnly(
                         pre_release_callback);
   StopWatch write_sw(immutable_db_options_.clock, stats_, DB_WRITE);
 
+  MaybeComputeWALPayloadChecksum(&w);
   write_thread->JoinBatchGroup(&w);
   assert(w.state != WriteThread::STATE_PARALLEL_MEMTABLE_WRITER);
   if (w.state == WriteThread::STATE_COMPLETED) {
@@ -1425,31 +1430,47 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
   // Same holds for all in the batch group
   size_t write_with_wal = 0;
   WriteBatch* to_be_cached_state = nullptr;
-  WriteBatch* merged_batch;
-  io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch_, &merged_batch,
-                                        &write_with_wal, &to_be_cached_state));
-  if (UNLIKELY(!io_s.ok())) {
-    return io_s;
-  }
-
-  if (merged_batch == write_group.leader->batch) {
-    write_group.leader->log_used = logfile_number_;
-  } else if (write_with_wal > 1) {
-    for (auto writer : write_group) {
-      writer->log_used = logfile_number_;
-    }
-  }
-
-  WriteBatchInternal::SetSequence(merged_batch, sequence);
-
+  WriteBatch* merged_batch = nullptr;
   uint64_t log_size;
 
   // TODO: plumb Env::IOActivity, Env::IOPriority
   WriteOptions write_options;
   write_options.rate_limiter_priority =
       write_group.leader->rate_limiter_priority;
-  io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
-                    &log_size, log_file_number_size);
+  if (immutable_db_options_.parallel_wal_checksum &&
+      immutable_db_options_.wal_compression == kNoCompression) {
+    uint32_t count = 0;
+    io_s = status_to_io_status(
+        PrepareWALPieces(write_group, &tmp_wal_pieces_, &count,
+                         &write_with_wal, &to_be_cached_state));
+    if (UNLIKELY(!io_s.ok())) {
+      // Failed before writing, like MergeBatch() failures
+      return io_s;
+    }
+    io_s = WriteWALPieces(write_group, write_options, log_writer,
+                          &tmp_wal_pieces_, count, sequence, log_used,
+                          &log_size, log_file_number_size);
+  } else {
+    io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch_,
+                                          &merged_batch, &write_with_wal,
+                                          &to_be_cached_state));
+    if (UNLIKELY(!io_s.ok())) {
+      return io_s;
+    }
+
+    if (merged_batch == write_group.leader->batch) {
+      write_group.leader->log_used = logfile_number_;
+    } else if (write_with_wal > 1) {
+      for (auto writer : write_group) {
+        writer->log_used = logfile_number_;
+      }
+    }
+
+    WriteBatchInternal::SetSequence(merged_batch, sequence);
+
+    io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
+                      &log_size, log_file_number_size);
+  }
   if (to_be_cached_state) {
     cached_recoverable_state_ = *to_be_cached_state;
     cached_recoverable_state_empty_ = false;
@@ -1526,6 +1547,113 @@ IOStatus DBImpl::WriteToWAL(const WriteThread::WriteGroup& write_group,
   return io_s;
 }
 
+Status DBImpl::PrepareWALPieces(const WriteThread::WriteGroup& write_group,
+                                std::vector<log::RecordPiece>* pieces,
+                                uint32_t* count, size_t* write_with_wal,
+                                WriteBatch** to_be_cached_state) {
+  assert(*write_with_wal == 0);
+
+  // The record is the header of the merged batch followed by the WAL part of
+  // each batch, as MergeBatch() builds it. The header is filled in by
+  // WriteWALPieces() once the sequence number is known.
+  pieces->clear();
+  pieces->emplace_back();
+  *count = 0;
+  WriteBatch* cached_state = nullptr;
+  for (auto writer : write_group) {
+    if (writer->CallbackFailed()) {
+      continue;
+    }
+    const WriteBatch* batch = writer->batch;
+    Status s = batch->VerifyChecksum();
+    if (!s.ok()) {
+      return s;
+    }
+    const SavePoint& wal_end = batch->GetWalTerminationPoint();
+    const Slice contents = WriteBatchInternal::Contents(batch);
+    log::RecordPiece piece;
+    if (wal_end.is_cleared()) {
+      piece.data = Slice(contents.data() + WriteBatchInternal::kHeader,
+                         contents.size() - WriteBatchInternal::kHeader);
+      *count += WriteBatchInternal::Count(batch);
+    } else {
+      piece.data = Slice(contents.data() + WriteBatchInternal::kHeader,
+                         wal_end.size - WriteBatchInternal::kHeader);
+      *count += wal_end.count;
+    }
+    piece.has_crc = writer->has_wal_payload_crc;
+    piece.crc = writer->wal_payload_crc;
+    pieces->push_back(piece);
+    if (WriteBatchInternal::IsLatestPersistentState(batch)) {
+      // We only need to cache the last of such write batch
+      cached_state = writer->batch;
+    }
+  }
+  *write_with_wal = pieces->size() - 1;
+  *to_be_cached_state = cached_state;
+  return Status::OK();
+}
+
+IOStatus DBImpl::WriteWALPieces(const WriteThread::WriteGroup& write_group,
+                                const WriteOptions& write_options,
+                                log::Writer* log_writer,
+                                std::vector<log::RecordPiece>* pieces,
+                                uint32_t count, SequenceNumber sequence,
+                                uint64_t* log_used, uint64_t* log_size,
+                                LogFileNumberSize& log_file_number_size) {
+  assert(log_size != nullptr);
+  assert(!pieces->empty());
+
+  for (auto writer : write_group) {
+    writer->log_used = logfile_number_;
+  }
+
+  char header[WriteBatchInternal::kHeader];
+  EncodeFixed64(header, sequence);
+  EncodeFixed32(header + 8, count);
+  (*pieces)[0].data = Slice(header, WriteBatchInternal::kHeader);
+  *log_size = 0;
+  for (const auto& piece : *pieces) {
+    *log_size += piece.data.size();
+  }
+
+  // See WriteToWAL() for the locking
+  const bool needs_locking = manual_wal_flush_ && !two_write_queues_;
+  if (UNLIKELY(needs_locking)) {
+    log_write_mutex_.Lock();
+  }
+  IOStatus io_s = log_writer->MaybeAddUserDefinedTimestampSizeRecord(
+      write_options, versions_->GetColumnFamiliesTimestampSizeForRecord());
+  if (io_s.ok()) {
+    io_s = log_writer->AddRecord(write_options, pieces->data(), pieces->size());
+  }
+  if (UNLIKELY(needs_locking)) {
+    log_write_mutex_.Unlock();
+  }
+  (*pieces)[0].data = Slice();
+  if (log_used != nullptr) {
+    *log_used = logfile_number_;
+  }
+  total_log_size_ += *log_size;
+  log_file_number_size.AddSize(*log_size);
+  log_empty_ = false;
+  return io_s;
+}
+
+void DBImpl::MaybeComputeWALPayloadChecksum(WriteThread::Writer* w) {
+  if (!immutable_db_options_.parallel_wal_checksum || w->disable_wal) {
+    return;
+  }
+  const WriteBatch* batch = w->batch;
+  const SavePoint& wal_end = batch->GetWalTerminationPoint();
+  const Slice contents = WriteBatchInternal::Contents(batch);
+  const size_t wal_size = wal_end.is_cleared() ? contents.size() : wal_end.size;
+  w->wal_payload_crc =
+      crc32c::Value(contents.data() + WriteBatchInternal::kHeader,
+                    wal_size - WriteBatchInternal::kHeader);
+  w->has_wal_payload_crc = true;
+}
+
 IOStatus DBImpl::ConcurrentWriteToWAL(
     const WriteThread::WriteGroup& write_group, uint64_t* log_used,
     SequenceNumber* last_sequence, size_t seq_inc) {
@@ -1537,9 +1665,23 @@ IOStatus DBImpl::ConcurrentWriteToWAL(
   WriteBatch tmp_batch;
   size_t write_with_wal = 0;
   WriteBatch* to_be_cached_state = nullptr;
-  WriteBatch* merged_batch;
-  io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch, &merged_batch,
-                                        &write_with_wal, &to_be_cached_state));
+  WriteBatch* merged_batch = nullptr;
+  // With parallel_wal_checksum, the record is gathered from the batches of
+  // the group before taking log_write_mutex_, so that the time other write
+  // groups wait for the WAL is only that of the WAL write itself.
+  const bool in_pieces =
+      immutable_db_options_.parallel_wal_checksum &&
+      immutable_db_options_.wal_compression == kNoCompression;
+  std::vector<log::RecordPiece> pieces;
+  uint32_t count = 0;
+  if (in_pieces) {
+    io_s = status_to_io_status(PrepareWALPieces(
+        write_group, &pieces, &count, &write_with_wal, &to_be_cached_state));
+  } else {
+    io_s = status_to_io_status(MergeBatch(write_group, &tmp_batch,
+                                          &merged_batch, &write_with_wal,
+                                          &to_be_cached_state));
+  }
   if (UNLIKELY(!io_s.ok())) {
     return io_s;
   }
@@ -1549,14 +1691,13 @@ IOStatus DBImpl::ConcurrentWriteToWAL(
   log_write_mutex_.Lock();
   if (merged_batch == write_group.leader->batch) {
     write_group.leader->log_used = logfile_number_;
-  } else if (write_with_wal > 1) {
+  } else if (write_with_wal > 1 && !in_pieces) {
     for (auto writer : write_group) {
       writer->log_used = logfile_number_;
     }
   }
   *last_sequence = versions_->FetchAddLastAllocatedSequence(seq_inc);
   auto sequence = *last_sequence + 1;
-  WriteBatchInternal::SetSequence(merged_batch, sequence);
 
   log::Writer* log_writer = logs_.back().writer;
   LogFileNumberSize& log_file_number_size = alive_log_files_.back();
@@ -1569,8 +1710,15 @@ IOStatus DBImpl::ConcurrentWriteToWAL(
   WriteOptions write_options;
   write_options.rate_limiter_priority =
       write_group.leader->rate_limiter_priority;
-  io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
-                    &log_size, log_file_number_size);
+  if (in_pieces) {
+    io_s = WriteWALPieces(write_group, write_options, log_writer, &pieces,
+                          count, sequence, log_used, &log_size,
+                          log_file_number_size);
+  } else {
+    WriteBatchInternal::SetSequence(merged_batch, sequence);
+    io_s = WriteToWAL(*merged_batch, write_options, log_writer, log_used,
+                      &log_size, log_file_number_size);
+  }
   if (to_be_cached_state) {
     cached_recoverable_state_ = *to_be_cached_state;
     cached_recoverable_state_empty_ = false;
@@ -82,7 +82,8 @@ DBIter::DBIter(Env* _env, const ReadOptions& read_options,
       cfh_(cfh),
       timestamp_ub_(read_options.timestamp),
       timestamp_lb_(read_options.iter_start_ts),
-      timestamp_size_(timestamp_ub_ ? timestamp_ub_->size() : 0) {
+      timestamp_size_(timestamp_ub_ ? timestamp_ub_->size() : 0),
+      wide_column_projection_(read_options.wide_column_projection) {
   RecordTick(statistics_, NO_ITERATOR_CREATED);
   if (pin_thru_lifetime_) {
     pinned_iters_mgr_.StartPinning();
@@ -129,6 +130,32 @@ Status DBIter::GetProperty(std::string prop_name, std::string* prop) {
   return Status::InvalidArgument("Unidentified property.");
 }
 
+size_t DBIter::NextBatch(size_t max_entries, std::vector<PinnableSlice>* keys,
+                         std::vector<PinnableSlice>* values) {
+  assert(keys != nullptr);
+  assert(values != nullptr);
+  size_t num_entries = 0;
+  for (; num_entries < max_entries && valid_; ++num_entries) {
+    // Same conditions as the "rocksdb.iterator.is-key-pinned" and
+    // "rocksdb.iterator.is-value-pinned" properties.
+    keys->emplace_back();
+    if (pin_thru_lifetime_ && saved_key_.IsKeyPinned()) {
+      keys->back().PinSlice(key(), nullptr /* cleanable */);
+    } else {
+      keys->back().PinSelf(key());
+    }
+    values->emplace_back();
+    if (pin_thru_lifetime_ && iter_.Valid() &&
+        iter_.value().data() == value_.data()) {
+      values->back().PinSlice(value_, nullptr /* cleanable */);
+    } else {
+      values->back().PinSelf(value_);
+    }
+    Next();
+  }
+  return num_entries;
+}
+
 bool DBIter::ParseKey(ParsedInternalKey* ikey) {
   Status s = ParseInternalKey(iter_.key(), ikey, false /* log_err_key */);
   if (!s.ok()) {
@@ -236,7 +263,11 @@ bool DBIter::SetValueAndColumnsFromEntity(Slice slice) {
   assert(value_.empty());
   assert(wide_columns_.empty());
 
-  const Status s = WideColumnSerialization::Deserialize(slice, wide_columns_);
+  const Status s =
+      wide_column_projection_ != nullptr
+          ? WideColumnSerialization::DeserializeColumns(
+                slice, *wide_column_projection_, wide_columns_)
+          : WideColumnSerialization::Deserialize(slice, wide_columns_);
 
   if (!s.ok()) {
     status_ = s;
@@ -1503,6 +1534,19 @@ void DBIter::SetSavedKeyToSeekForPrevTarget(const Slice& target) {
   }
 }
 
+void DBIter::PrepareSeek(const Slice& target) {
+  status_ = Status::OK();
+  ReleaseTempPinnedData();
+  ResetBlobValue();
+  ResetValueAndColumns();
+  valid_ = false;
+
+  // Seek() builds the same internal key, so that the table iterators find the
+  // reads they started for it
+  SetSavedKeyToSeekTarget(target);
+  iter_.PrepareSeek(saved_key_.GetInternalKey());
+}
+
 void DBIter::Seek(const Slice& target) {
   PERF_COUNTER_ADD(iter_seek_count, 1);
   PERF_CPU_TIMER_GUARD(iter_seek_cpu_nanos, clock_);
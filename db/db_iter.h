@@ -13,6 +13,7 @@
 
 #include "db/db_impl/db_impl.h"
 #include "db/range_del_aggregator.h"
+#include "db/wide/wide_column_serialization.h"
 #include "memory/arena.h"
 #include "options/cf_options.h"
 #include "rocksdb/db.h"
@@ -199,6 +200,11 @@ class DBIter final : public Iterator {
   }
 
   Status GetProperty(std::string prop_name, std::string* prop) override;
+  size_t NextBatch(size_t max_entries, std::vector<PinnableSlice>* keys,
+                   std::vector<PinnableSlice>* values) override;
+  // 'target' does not contain timestamp, even if user timestamp feature is
+  // enabled.
+  void PrepareSeek(const Slice& target) override;
 
   void Next() final override;
   void Prev() final override;
@@ -313,7 +319,11 @@ class DBIter final : public Iterator {
     assert(wide_columns_.empty());
 
     value_ = slice;
-    wide_columns_.emplace_back(kDefaultWideColumnName, slice);
+    if (wide_column_projection_ == nullptr ||
+        WideColumnSerialization::IsProjected(*wide_column_projection_,
+                                             kDefaultWideColumnName)) {
+      wide_columns_.emplace_back(kDefaultWideColumnName, slice);
+    }
   }
 
   bool SetValueAndColumnsFromEntity(Slice slice);
@@ -427,6 +437,7 @@ class DBIter final : public Iterator {
   const Slice* const timestamp_ub_;
   const Slice* const timestamp_lb_;
   const size_t timestamp_size_;
+  const std::vector<Slice>* const wide_column_projection_;
   std::string saved_timestamp_;
 };
 
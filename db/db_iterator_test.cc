@@ -159,6 +159,72 @@ TEST_P(DBIteratorTest, IteratorProperty) {
   Close();
 }
 
+TEST_P(DBIteratorTest, NextBatch) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  DestroyAndReopen(options);
+
+  // Spread the keys over an SST file and the memtable, with overwrites and
+  // deletions that NextBatch() must skip.
+  const int kNumKeys = 1000;
+  std::map<std::string, std::string> expected;
+  for (int i = 0; i < kNumKeys; i++) {
+    ASSERT_OK(Put(Key(i), "v1_" + std::to_string(i)));
+    expected[Key(i)] = "v1_" + std::to_string(i);
+  }
+  ASSERT_OK(Flush());
+  for (int i = 0; i < kNumKeys; i += 3) {
+    ASSERT_OK(Put(Key(i), "v2_" + std::to_string(i)));
+    expected[Key(i)] = "v2_" + std::to_string(i);
+  }
+  for (int i = 1; i < kNumKeys; i += 7) {
+    ASSERT_OK(Delete(Key(i)));
+    expected.erase(Key(i));
+  }
+
+  for (bool pin_data : {false, true}) {
+    ReadOptions ro;
+    ro.pin_data = pin_data;
+    for (size_t batch_size : {1, 7, 2000}) {
+      std::unique_ptr<Iterator> iter(NewIterator(ro));
+      // The slices returned by earlier batches stay valid while the
+      // iterator moves on.
+      std::vector<PinnableSlice> keys;
+      std::vector<PinnableSlice> values;
+      for (iter->SeekToFirst(); iter->Valid();) {
+        size_t num_entries = iter->NextBatch(batch_size, &keys, &values);
+        ASSERT_GT(num_entries, 0);
+        ASSERT_LE(num_entries, batch_size);
+      }
+      ASSERT_OK(iter->status());
+      ASSERT_EQ(0, iter->NextBatch(batch_size, &keys, &values));
+
+      ASSERT_EQ(expected.size(), keys.size());
+      ASSERT_EQ(expected.size(), values.size());
+      size_t i = 0;
+      for (const auto& kv : expected) {
+        ASSERT_EQ(kv.first, keys[i].ToString());
+        ASSERT_EQ(kv.second, values[i].ToString());
+        i++;
+      }
+    }
+  }
+
+  // Through the public DB::NewIterator() and after a Seek().
+  std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+  iter->Seek(Key(500));
+  std::vector<PinnableSlice> keys;
+  std::vector<PinnableSlice> values;
+  ASSERT_EQ(10, iter->NextBatch(10, &keys, &values));
+  auto it = expected.lower_bound(Key(500));
+  for (size_t i = 0; i < keys.size(); i++, ++it) {
+    ASSERT_EQ(it->first, keys[i].ToString());
+    ASSERT_EQ(it->second, values[i].ToString());
+  }
+  ASSERT_TRUE(iter->Valid());
+  ASSERT_EQ(it->first, iter->key().ToString());
+}
+
 TEST_P(DBIteratorTest, PersistedTierOnIterator) {
   // The test needs to be changed if kPersistedTier is supported in iterator.
   Options options = CurrentOptions();
@@ -277,6 +277,151 @@ TEST_F(DBMemTableTest, ConcurrentMergeWrite) {
   delete mem;
 }
 
+TEST_F(DBMemTableTest, ConcurrentWriteHashMemTables) {
+  const int kNumThreads = 4;
+  const int kNumKeysPerThread = 500;
+  // A single byte prefix over 8 distinct prefixes, so that buckets fill up
+  // and hash link list buckets are converted to skip lists while writing.
+  auto key_of = [](int k) {
+    return std::string(1, static_cast<char>('a' + k % 8)) + std::to_string(k);
+  };
+
+  std::vector<std::shared_ptr<MemTableRepFactory>> factories = {
+      std::shared_ptr<MemTableRepFactory>(NewHashSkipListRepFactory(4)),
+      std::shared_ptr<MemTableRepFactory>(
+          NewHashLinkListRepFactory(4, 0, 0, false, 3))};
+  for (auto& factory : factories) {
+    SCOPED_TRACE(factory->Name());
+    ASSERT_TRUE(factory->IsInsertConcurrentlySupported());
+    Options options;
+    options.prefix_extractor.reset(NewFixedPrefixTransform(1));
+    options.memtable_factory = factory;
+    options.allow_concurrent_memtable_write = true;
+    InternalKeyComparator cmp(BytewiseComparator());
+    ImmutableOptions ioptions(options);
+    WriteBufferManager wb(options.db_write_buffer_size);
+    std::unique_ptr<MemTable> mem(
+        new MemTable(cmp, ioptions, MutableCFOptions(options), &wb,
+                     kMaxSequenceNumber, 0 /* column_family_id */));
+
+    // Interleave a non-concurrent insert for every batch of concurrent ones,
+    // like a write group that has a single writer.
+    int num_keys = 0;
+    for (int round = 0; round < 2; round++) {
+      ASSERT_OK(mem->Add(num_keys + 1, kTypeValue, key_of(num_keys),
+                         std::to_string(num_keys), nullptr /* kv_prot_info */));
+      num_keys++;
+
+      const int base = num_keys;
+      std::vector<port::Thread> threads;
+      for (int t = 0; t < kNumThreads; t++) {
+        threads.emplace_back([&, t]() {
+          MemTablePostProcessInfo post_process_info;
+          for (int i = 0; i < kNumKeysPerThread; i++) {
+            int k = base + i * kNumThreads + t;
+            ASSERT_OK(mem->Add(k + 1, kTypeValue, key_of(k), std::to_string(k),
+                               nullptr /* kv_prot_info */, true,
+                               &post_process_info));
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+      num_keys += kNumThreads * kNumKeysPerThread;
+    }
+
+    for (int k = 0; k < num_keys; k++) {
+      std::string value;
+      Status status;
+      MergeContext merge_context;
+      SequenceNumber max_covering_tombstone_seq = 0;
+      LookupKey lkey(key_of(k), kMaxSequenceNumber);
+      ASSERT_TRUE(mem->Get(lkey, &value, /*columns=*/nullptr,
+                           /*timestamp=*/nullptr, &status, &merge_context,
+                           &max_covering_tombstone_seq, ReadOptions(),
+                           false /* immutable_memtable */));
+      ASSERT_OK(status);
+      ASSERT_EQ(std::to_string(k), value);
+    }
+
+    Arena arena;
+    ReadOptions ro;
+    ro.total_order_seek = true;
+    ScopedArenaPtr<InternalIterator> iter(
+        mem->NewIterator(ro, /*seqno_to_time_mapping=*/nullptr, &arena));
+    int count = 0;
+    std::string prev_key;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      if (count > 0) {
+        ASSERT_LT(cmp.Compare(prev_key, iter->key()), 0);
+      }
+      prev_key = iter->key().ToString();
+      count++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(num_keys, count);
+  }
+}
+
+TEST_F(DBMemTableTest, BTreeMemTable) {
+  const int kNumThreads = 4;
+  const int kNumKeysPerThread = 1000;
+  Options options = CurrentOptions();
+  options.memtable_factory = std::make_shared<BTreeRepFactory>();
+  options.allow_concurrent_memtable_write = true;
+  options.enable_write_thread_adaptive_yield = true;
+  Reopen(options);
+
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNumKeysPerThread; i++) {
+        int k = i * kNumThreads + t;
+        ASSERT_OK(Put(Key(k), "v" + std::to_string(k)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  // Overwrite and delete some keys so the memtable holds several versions.
+  const int kNumKeys = kNumThreads * kNumKeysPerThread;
+  for (int k = 0; k < kNumKeys; k += 3) {
+    ASSERT_OK(Put(Key(k), "w" + std::to_string(k)));
+  }
+  for (int k = 1; k < kNumKeys; k += 3) {
+    ASSERT_OK(Delete(Key(k)));
+  }
+
+  auto verify = [&]() {
+    for (int k = 0; k < kNumKeys; k++) {
+      if (k % 3 == 0) {
+        ASSERT_EQ("w" + std::to_string(k), Get(Key(k)));
+      } else if (k % 3 == 1) {
+        ASSERT_EQ("NOT_FOUND", Get(Key(k)));
+      } else {
+        ASSERT_EQ("v" + std::to_string(k), Get(Key(k)));
+      }
+    }
+    std::unique_ptr<Iterator> iter(db_->NewIterator(ReadOptions()));
+    int count = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      count++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(kNumKeys - (kNumKeys + 1) / 3, count);
+    for (iter->SeekToLast(); iter->Valid(); iter->Prev()) {
+      count--;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(0, count);
+  };
+  verify();
+  ASSERT_OK(Flush());
+  verify();
+}
+
 TEST_F(DBMemTableTest, InsertWithHint) {
   Options options;
   options.allow_concurrent_memtable_write = false;
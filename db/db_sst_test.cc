@@ -1502,6 +1502,68 @@ TEST_F(DBSSTTest, OpenDBWithInfiniteMaxOpenFiles) {
   }
 }
 
+TEST_F(DBSSTTest, OpenDBWithInfiniteMaxOpenFilesInBackground) {
+  Options options = CurrentOptions();
+  options.create_if_missing = true;
+  options.disable_auto_compactions = true;
+  options.max_open_files = -1;
+  options.max_file_opening_threads = 2;
+  options.open_files_in_background = true;
+  DestroyAndReopen(options);
+
+  // One file in each of L0, L1 and L2
+  for (int i = 0; i < 2; i++) {
+    ASSERT_OK(Put("L2_" + Key(i), "v" + std::to_string(i)));
+  }
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(2);
+  ASSERT_OK(Put("L1_" + Key(0), "v"));
+  ASSERT_OK(Flush());
+  MoveFilesToLevel(1);
+  ASSERT_OK(Put("L0_" + Key(0), "v"));
+  ASSERT_OK(Flush());
+  ASSERT_EQ("1,1,1", FilesPerLevel(0));
+  Close();
+
+  // Hold the background job until DB::Open() has returned
+  SyncPoint::GetInstance()->LoadDependency(
+      {{"DBSSTTest::OpenDBWithInfiniteMaxOpenFilesInBackground:Opened",
+        "DBImpl::BGWorkOpenTableFiles:start"},
+       {"DBImpl::BGWorkOpenTableFiles:end",
+        "DBSSTTest::OpenDBWithInfiniteMaxOpenFilesInBackground:Done"}});
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  options.statistics = CreateDBStatistics();
+  Reopen(options);
+  // Only the files of L0 and L1 were opened by DB::Open()
+  EXPECT_EQ(2, options.statistics->getTickerCount(NO_FILE_OPENS));
+  std::vector<std::vector<FileMetaData>> files;
+  dbfull()->TEST_GetFilesMetaData(db_->DefaultColumnFamily(), &files);
+  ASSERT_EQ(1, files[0].size());
+  ASSERT_TRUE(files[0][0].table_reader_handle != nullptr);
+  ASSERT_EQ(1, files[1].size());
+  ASSERT_TRUE(files[1][0].table_reader_handle != nullptr);
+  ASSERT_EQ(1, files[2].size());
+  ASSERT_TRUE(files[2][0].table_reader_handle == nullptr);
+
+  TEST_SYNC_POINT(
+      "DBSSTTest::OpenDBWithInfiniteMaxOpenFilesInBackground:Opened");
+  TEST_SYNC_POINT("DBSSTTest::OpenDBWithInfiniteMaxOpenFilesInBackground:Done");
+  EXPECT_EQ(3, options.statistics->getTickerCount(NO_FILE_OPENS));
+
+  // Reads find the L2 file already open
+  for (int i = 0; i < 2; i++) {
+    ASSERT_EQ("v" + std::to_string(i), Get("L2_" + Key(i)));
+  }
+  ASSERT_EQ("v", Get("L1_" + Key(0)));
+  ASSERT_EQ("v", Get("L0_" + Key(0)));
+  EXPECT_EQ(3, options.statistics->getTickerCount(NO_FILE_OPENS));
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  Close();
+}
+
 TEST_F(DBSSTTest, OpenDBWithInfiniteMaxOpenFilesSubjectToMemoryLimit) {
   for (CacheEntryRoleOptions::Decision charge_table_reader :
        {CacheEntryRoleOptions::Decision::kEnabled,
@@ -4355,15 +4355,14 @@ TEST_F(DBTest, ConcurrentMemtableNotSupported) {
   options.create_if_missing = true;
   Close();
   ASSERT_OK(DestroyDB(dbname_, options));
-  options.memtable_factory.reset(NewHashLinkListRepFactory(4, 0, 3, true, 4));
+  options.memtable_factory.reset(new VectorRepFactory);
   ASSERT_NOK(TryReopen(options));
 
   options.memtable_factory.reset(new SkipListFactory);
   ASSERT_OK(TryReopen(options));
 
   ColumnFamilyOptions cf_options(options);
-  cf_options.memtable_factory.reset(
-      NewHashLinkListRepFactory(4, 0, 3, true, 4));
+  cf_options.memtable_factory.reset(new VectorRepFactory);
   ColumnFamilyHandle* handle;
   ASSERT_NOK(db_->CreateColumnFamily(cf_options, "name", &handle));
 }
@@ -5667,6 +5667,92 @@ TEST_F(DBTest2, RowCacheSnapshot) {
   db_->ReleaseSnapshot(s3);
 }
 
+TEST_F(DBTest2, RowCacheAdmissionThreshold) {
+  Options options = CurrentOptions();
+  options.statistics = ROCKSDB_NAMESPACE::CreateDBStatistics();
+  options.row_cache = NewLRUCache(8 * 8192);
+  options.row_cache_admission_threshold = 3;
+  DestroyAndReopen(options);
+
+  ASSERT_OK(Put("cold", "value1"));
+  ASSERT_OK(Put("hot", "value2"));
+  ASSERT_OK(Flush());
+
+  // Cold keys are never inserted into the row cache
+  ASSERT_EQ(Get("cold"), "value1");
+  ASSERT_EQ(Get("cold"), "value1");
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_HIT), 0);
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_MISS), 2);
+
+  // A key is inserted on the lookup that makes it hot
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(Get("hot"), "value2");
+  }
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_HIT), 0);
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_MISS), 5);
+  ASSERT_EQ(Get("hot"), "value2");
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_HIT), 1);
+  ASSERT_EQ(TestGetTickerCount(options, ROW_CACHE_MISS), 5);
+
+  std::map<std::string, std::string> hot_keys;
+  ASSERT_TRUE(
+      db_->GetMapProperty(DB::Properties::kRowCacheHotKeys, &hot_keys));
+  ASSERT_EQ(hot_keys.size(), 1U);
+  ASSERT_EQ(hot_keys.begin()->first, "hot");
+  ASSERT_GE(std::stoul(hot_keys.begin()->second), 3U);
+
+  std::string hot_keys_str;
+  ASSERT_TRUE(
+      db_->GetProperty(DB::Properties::kRowCacheHotKeys, &hot_keys_str));
+  ASSERT_EQ(hot_keys_str.find(Slice("hot").ToString(/*hex=*/true)), 0U);
+
+  // Not available without an admission threshold
+  options.row_cache_admission_threshold = 0;
+  Reopen(options);
+  ASSERT_FALSE(
+      db_->GetProperty(DB::Properties::kRowCacheHotKeys, &hot_keys_str));
+}
+
+TEST_F(DBTest2, ManifestSpaceAmpRollover) {
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  options.max_manifest_file_size = 1;
+  options.max_manifest_space_amp_pct = 100;
+  DestroyAndReopen(options);
+  constexpr int kNumFiles = 20;
+  for (int i = 0; i < kNumFiles; ++i) {
+    ASSERT_OK(Put(Key(i), "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+  }
+
+  // Reopening writes a new manifest whose snapshot includes all the files,
+  // so a single flush afterwards does not roll it over even though the
+  // manifest is larger than max_manifest_file_size
+  Reopen(options);
+  uint64_t manifest_number = dbfull()->TEST_Current_Manifest_FileNo();
+  ASSERT_OK(Put(Key(kNumFiles), "v" + std::to_string(kNumFiles)));
+  ASSERT_OK(Flush());
+  ASSERT_EQ(manifest_number, dbfull()->TEST_Current_Manifest_FileNo());
+
+  // Once the flushes appended as many bytes as the snapshot, it rolls over
+  int num_rollovers = 0;
+  for (int i = kNumFiles + 1; i < 3 * kNumFiles; ++i) {
+    ASSERT_OK(Put(Key(i), "v" + std::to_string(i)));
+    ASSERT_OK(Flush());
+    if (dbfull()->TEST_Current_Manifest_FileNo() != manifest_number) {
+      manifest_number = dbfull()->TEST_Current_Manifest_FileNo();
+      ++num_rollovers;
+    }
+  }
+  ASSERT_GT(num_rollovers, 0);
+  ASSERT_LT(num_rollovers, kNumFiles / 2);
+
+  Reopen(options);
+  for (int i = 0; i < 3 * kNumFiles; ++i) {
+    ASSERT_EQ("v" + std::to_string(i), Get(Key(i)));
+  }
+}
+
 // When DB is reopened with multiple column families, the manifest file
 // is written after the first CF is flushed, and it is written again
 // after each flush. If DB crashes between the flushes, the flushed CF
@@ -609,6 +609,50 @@ TEST_F(DBWALTest, RecoverWithTableHandle) {
   } while (ChangeWalOptions());
 }
 
+TEST_F(DBWALTest, ParallelRecovery) {
+  constexpr int kNumKeys = 2000;
+  for (bool concurrent_insert : {false, true}) {
+    SCOPED_TRACE("concurrent_insert=" + std::to_string(concurrent_insert));
+    Options options = CurrentOptions();
+    options.disable_auto_compactions = true;
+    options.avoid_flush_during_shutdown = true;
+    options.merge_operator = MergeOperators::CreateStringAppendOperator();
+    DestroyAndReopen(options);
+    CreateAndReopenWithCF({"pikachu"}, options);
+
+    Random rnd(301);
+    std::vector<std::string> values;
+    for (int i = 0; i < kNumKeys; ++i) {
+      values.push_back(rnd.RandomString(200));
+      WriteBatch batch;
+      ASSERT_OK(batch.Put(handles_[0], Key(i), values[i]));
+      ASSERT_OK(batch.Put(handles_[1], Key(i), values[i]));
+      if (i % 10 == 0) {
+        // Batches with merges are replayed one at a time
+        ASSERT_OK(batch.Merge(handles_[1], Key(i), "m"));
+      }
+      ASSERT_OK(dbfull()->Write(WriteOptions(), &batch));
+    }
+    ASSERT_EQ(NumTableFilesAtLevel(0, 0), 0);
+    ASSERT_EQ(NumTableFilesAtLevel(0, 1), 0);
+
+    // Small memtables make replay flush in the middle of the WAL
+    options.write_buffer_size = 64 << 10;
+    options.wal_recovery_threads = 4;
+    options.allow_concurrent_memtable_write = concurrent_insert;
+    ReopenWithColumnFamilies({"default", "pikachu"}, options);
+    ASSERT_GT(NumTableFilesAtLevel(0, 0), 1);
+    ASSERT_GT(NumTableFilesAtLevel(0, 1), 1);
+
+    for (int i = 0; i < kNumKeys; ++i) {
+      ASSERT_EQ(Get(0, Key(i)), values[i]);
+      ASSERT_EQ(Get(1, Key(i)), i % 10 == 0 ? values[i] + ",m" : values[i]);
+    }
+    ASSERT_OK(Put(1, "foo", "bar"));
+    ASSERT_EQ(Get(1, "foo"), "bar");
+  }
+}
+
 TEST_F(DBWALTest, RecoverWithBlob) {
   // Write a value that's below the prospective size limit for blobs and another
   // one that's above. Note that blob files are not actually enabled at this
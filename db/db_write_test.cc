@@ -922,6 +922,92 @@ void CorruptLogFile(Env* env, Options& options, std::string log_path,
   }
 }
 
+TEST_P(DBWriteTest, ParallelWALChecksum) {
+  Options options = GetOptions();
+  options.parallel_wal_checksum = true;
+  Reopen(options);
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumBatches = 100;
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNumBatches; ++i) {
+        WriteBatch batch;
+        std::string prefix = std::to_string(t) + "_" + std::to_string(i);
+        ASSERT_OK(batch.Put(prefix + "_a", "value_a" + prefix));
+        ASSERT_OK(batch.Put(prefix + "_b", "value_b" + prefix));
+        if (i % 10 == 0) {
+          ASSERT_OK(batch.Delete(prefix + "_a"));
+        }
+        WriteOptions write_options;
+        write_options.sync = (i % 25 == 0);
+        ASSERT_OK(dbfull()->Write(write_options, &batch));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Recover everything from the WAL
+  Reopen(options);
+  for (int t = 0; t < kNumThreads; ++t) {
+    for (int i = 0; i < kNumBatches; ++i) {
+      std::string prefix = std::to_string(t) + "_" + std::to_string(i);
+      if (i % 10 == 0) {
+        ASSERT_EQ("NOT_FOUND", Get(prefix + "_a"));
+      } else {
+        ASSERT_EQ("value_a" + prefix, Get(prefix + "_a"));
+      }
+      ASSERT_EQ("value_b" + prefix, Get(prefix + "_b"));
+    }
+  }
+}
+
+TEST_P(DBWriteTest, ParallelWALChecksumConcurrentWALWrites) {
+  Options options = GetOptions();
+  if (options.enable_pipelined_write) {
+    ROCKSDB_GTEST_SKIP("unordered_write is incompatible with pipelined write");
+    return;
+  }
+  // With unordered_write, write groups write the WAL through
+  // ConcurrentWriteToWAL() from WriteImplWALOnly()
+  options.parallel_wal_checksum = true;
+  options.unordered_write = true;
+  Reopen(options);
+
+  constexpr int kNumThreads = 8;
+  constexpr int kNumBatches = 100;
+  std::vector<port::Thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kNumBatches; ++i) {
+        WriteBatch batch;
+        std::string prefix = std::to_string(t) + "_" + std::to_string(i);
+        ASSERT_OK(batch.Put(prefix + "_a", "value_a" + prefix));
+        ASSERT_OK(batch.Put(prefix + "_b", "value_b" + prefix));
+        WriteOptions write_options;
+        write_options.sync = (i % 25 == 0);
+        ASSERT_OK(dbfull()->Write(write_options, &batch));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Recover everything from the WAL
+  Reopen(options);
+  for (int t = 0; t < kNumThreads; ++t) {
+    for (int i = 0; i < kNumBatches; ++i) {
+      std::string prefix = std::to_string(t) + "_" + std::to_string(i);
+      ASSERT_EQ("value_a" + prefix, Get(prefix + "_a"));
+      ASSERT_EQ("value_b" + prefix, Get(prefix + "_b"));
+    }
+  }
+}
+
 TEST_P(DBWriteTest, RecycleLogTest) {
   Options options = GetOptions();
   options.recycle_log_file_num = 0;
@@ -11,9 +11,11 @@
 
 #include <algorithm>
 #include <cinttypes>
+#include <unordered_set>
 #include <vector>
 
 #include "db/builder.h"
+#include "db/compaction/clipping_iterator.h"
 #include "db/db_iter.h"
 #include "db/dbformat.h"
 #include "db/event_helpers.h"
@@ -958,42 +960,27 @@ Status FlushJob::WriteLevel0Table() {
       uint64_t num_input_entries = 0;
       uint64_t memtable_payload_bytes = 0;
       uint64_t memtable_garbage_bytes = 0;
-      IOStatus io_s;
-
-      const std::string* const full_history_ts_low =
-          (full_history_ts_low_.empty()) ? nullptr : &full_history_ts_low_;
-      ReadOptions read_options(Env::IOActivity::kFlush);
-      read_options.rate_limiter_priority = io_priority;
-      const WriteOptions write_options(io_priority, Env::IOActivity::kFlush);
-      TableBuilderOptions tboptions(
-          *cfd_->ioptions(), mutable_cf_options_, read_options, write_options,
-          cfd_->internal_comparator(), cfd_->internal_tbl_prop_coll_factories(),
-          output_compression_, mutable_cf_options_.compression_opts,
-          cfd_->GetID(), cfd_->GetName(), 0 /* level */,
-          false /* is_bottommost */, TableFileCreationReason::kFlush,
-          oldest_key_time, current_time, db_id_, db_session_id_,
-          0 /* target_file_size */, meta_.fd.GetNumber(),
-          preclude_last_level_min_seqno_ == kMaxSequenceNumber
-              ? preclude_last_level_min_seqno_
-              : std::min(earliest_snapshot_, preclude_last_level_min_seqno_));
-      const SequenceNumber job_snapshot_seq =
-          job_context_->GetJobSnapshotSequence();
-
-      s = BuildTable(
-          dbname_, versions_, db_options_, tboptions, file_options_,
-          cfd_->table_cache(), iter.get(), std::move(range_del_iters), &meta_,
-          &blob_file_additions, existing_snapshots_, earliest_snapshot_,
-          earliest_write_conflict_snapshot_, job_snapshot_seq,
-          snapshot_checker_, mutable_cf_options_.paranoid_file_checks,
-          cfd_->internal_stats(), &io_s, io_tracer_,
-          BlobFileCreationReason::kFlush, seqno_to_time_mapping_.get(),
-          event_logger_, job_context_->job_id, &table_properties_, write_hint,
-          full_history_ts_low, blob_callback_, base_, &num_input_entries,
-          &memtable_payload_bytes, &memtable_garbage_bytes);
+
+      std::vector<std::string> boundaries = PickPartitionBoundaries(
+          total_num_entries, total_data_size, !range_del_iters.empty());
+      if (boundaries.empty()) {
+        s = BuildOutputTable(iter.get(), std::move(range_del_iters),
+                             io_priority, write_hint, oldest_key_time,
+                             current_time, &meta_, &blob_file_additions,
+                             &table_properties_, &num_input_entries,
+                             &memtable_payload_bytes, &memtable_garbage_bytes);
+      } else {
+        ROCKS_LOG_INFO(db_options_.info_log,
+                       "[%s] [JOB %d] Level-0 flush split into %" ROCKSDB_PRIszt
+                       " partitions",
+                       cfd_->GetName().c_str(), job_context_->job_id,
+                       boundaries.size() + 1);
+        s = BuildPartitionedOutputTables(
+            iter.get(), boundaries, io_priority, write_hint, oldest_key_time,
+            current_time, &num_input_entries, &memtable_payload_bytes,
+            &memtable_garbage_bytes);
+      }
       TEST_SYNC_POINT_CALLBACK("FlushJob::WriteLevel0Table:s", &s);
-      // TODO: Cleanup io_status in BuildTable and table builders
-      assert(!s.ok() || io_s.ok());
-      io_s.PermitUncheckedError();
       if (num_input_entries != total_num_entries && s.ok()) {
         std::string msg = "Expected " + std::to_string(total_num_entries) +
                           " entries in memtables, but read " +
@@ -1005,13 +992,11 @@ Status FlushJob::WriteLevel0Table() {
           s = Status::Corruption(msg);
         }
       }
-      if (tboptions.reason == TableFileCreationReason::kFlush) {
-        TEST_SYNC_POINT("DBImpl::FlushJob:Flush");
-        RecordTick(stats_, MEMTABLE_PAYLOAD_BYTES_AT_FLUSH,
-                   memtable_payload_bytes);
-        RecordTick(stats_, MEMTABLE_GARBAGE_BYTES_AT_FLUSH,
-                   memtable_garbage_bytes);
-      }
+      TEST_SYNC_POINT("DBImpl::FlushJob:Flush");
+      RecordTick(stats_, MEMTABLE_PAYLOAD_BYTES_AT_FLUSH,
+                 memtable_payload_bytes);
+      RecordTick(stats_, MEMTABLE_GARBAGE_BYTES_AT_FLUSH,
+                 memtable_garbage_bytes);
       LogFlush(db_options_.info_log);
     }
     ROCKS_LOG_BUFFER(log_buffer_,
@@ -1022,6 +1007,14 @@ Status FlushJob::WriteLevel0Table() {
                      meta_.fd.GetNumber(), meta_.fd.GetFileSize(),
                      s.ToString().c_str(),
                      meta_.marked_for_compaction ? " (needs compaction)" : "");
+    for (const auto& meta : partition_metas_) {
+      ROCKS_LOG_BUFFER(log_buffer_,
+                       "[%s] [JOB %d] Level-0 flush table #%" PRIu64
+                       ": %" PRIu64 " bytes%s",
+                       cfd_->GetName().c_str(), job_context_->job_id,
+                       meta.fd.GetNumber(), meta.fd.GetFileSize(),
+                       meta.marked_for_compaction ? " (needs compaction)" : "");
+    }
 
     if (s.ok() && output_file_directory_ != nullptr && sync_output_directory_) {
       s = output_file_directory_->FsyncWithDirOptions(
@@ -1035,7 +1028,16 @@ Status FlushJob::WriteLevel0Table() {
 
   // Note that if file_size is zero, the file has been deleted and
   // should not be added to the manifest.
-  const bool has_output = meta_.fd.GetFileSize() > 0;
+  autovector<const FileMetaData*> outputs;
+  if (meta_.fd.GetFileSize() > 0) {
+    outputs.push_back(&meta_);
+  }
+  for (const auto& meta : partition_metas_) {
+    if (meta.fd.GetFileSize() > 0) {
+      outputs.push_back(&meta);
+    }
+  }
+  const bool has_output = !outputs.empty();
 
   if (s.ok() && has_output) {
     TEST_SYNC_POINT("DBImpl::FlushJob:SSTFileCreated");
@@ -1043,16 +1045,19 @@ Status FlushJob::WriteLevel0Table() {
     // insert files directly into higher levels because some other
     // threads could be concurrently producing compacted files for
     // that key range.
-    // Add file to L0
-    edit_->AddFile(0 /* level */, meta_.fd.GetNumber(), meta_.fd.GetPathId(),
-                   meta_.fd.GetFileSize(), meta_.smallest, meta_.largest,
-                   meta_.fd.smallest_seqno, meta_.fd.largest_seqno,
-                   meta_.marked_for_compaction, meta_.temperature,
-                   meta_.oldest_blob_file_number, meta_.oldest_ancester_time,
-                   meta_.file_creation_time, meta_.epoch_number,
-                   meta_.file_checksum, meta_.file_checksum_func_name,
-                   meta_.unique_id, meta_.compensated_range_deletion_size,
-                   meta_.tail_size, meta_.user_defined_timestamps_persisted);
+    // Add files to L0. The tables of a partitioned flush share the epoch
+    // number but have disjoint key ranges.
+    for (const FileMetaData* meta : outputs) {
+      edit_->AddFile(0 /* level */, meta->fd.GetNumber(), meta->fd.GetPathId(),
+                     meta->fd.GetFileSize(), meta->smallest, meta->largest,
+                     meta->fd.smallest_seqno, meta->fd.largest_seqno,
+                     meta->marked_for_compaction, meta->temperature,
+                     meta->oldest_blob_file_number, meta->oldest_ancester_time,
+                     meta->file_creation_time, meta->epoch_number,
+                     meta->file_checksum, meta->file_checksum_func_name,
+                     meta->unique_id, meta->compensated_range_deletion_size,
+                     meta->tail_size, meta->user_defined_timestamps_persisted);
+    }
     edit_->SetBlobFileAdditions(std::move(blob_file_additions));
   }
   // Piggyback FlushJobInfo on the first first flushed memtable.
@@ -1071,9 +1076,9 @@ Status FlushJob::WriteLevel0Table() {
                  cfd_->GetName().c_str(), job_context_->job_id, micros,
                  cpu_micros);
 
-  if (has_output) {
-    stats.bytes_written = meta_.fd.GetFileSize();
-    stats.num_output_files = 1;
+  for (const FileMetaData* meta : outputs) {
+    stats.bytes_written += meta->fd.GetFileSize();
+    stats.num_output_files++;
   }
 
   const auto& blobs = edit_->GetBlobFileAdditions();
@@ -1093,6 +1098,248 @@ Status FlushJob::WriteLevel0Table() {
   return s;
 }
 
+Status FlushJob::BuildOutputTable(
+    InternalIterator* iter,
+    std::vector<std::unique_ptr<FragmentedRangeTombstoneIterator>>
+        range_del_iters,
+    Env::IOPriority io_priority, Env::WriteLifeTimeHint write_hint,
+    uint64_t oldest_key_time, uint64_t current_time, FileMetaData* meta,
+    std::vector<BlobFileAddition>* blob_file_additions,
+    TableProperties* table_properties, uint64_t* num_input_entries,
+    uint64_t* memtable_payload_bytes, uint64_t* memtable_garbage_bytes) {
+  IOStatus io_s;
+
+  const std::string* const full_history_ts_low =
+      (full_history_ts_low_.empty()) ? nullptr : &full_history_ts_low_;
+  ReadOptions read_options(Env::IOActivity::kFlush);
+  read_options.rate_limiter_priority = io_priority;
+  const WriteOptions write_options(io_priority, Env::IOActivity::kFlush);
+  TableBuilderOptions tboptions(
+      *cfd_->ioptions(), mutable_cf_options_, read_options, write_options,
+      cfd_->internal_comparator(), cfd_->internal_tbl_prop_coll_factories(),
+      output_compression_, mutable_cf_options_.compression_opts, cfd_->GetID(),
+      cfd_->GetName(), 0 /* level */, false /* is_bottommost */,
+      TableFileCreationReason::kFlush, oldest_key_time, current_time, db_id_,
+      db_session_id_, 0 /* target_file_size */, meta->fd.GetNumber(),
+      preclude_last_level_min_seqno_ == kMaxSequenceNumber
+          ? preclude_last_level_min_seqno_
+          : std::min(earliest_snapshot_, preclude_last_level_min_seqno_));
+  if (base_ != nullptr) {
+    base_->SetFilterBuildingStats(&tboptions);
+  }
+  const SequenceNumber job_snapshot_seq =
+      job_context_->GetJobSnapshotSequence();
+
+  Status s = BuildTable(
+      dbname_, versions_, db_options_, tboptions, file_options_,
+      cfd_->table_cache(), iter, std::move(range_del_iters), meta,
+      blob_file_additions, existing_snapshots_, earliest_snapshot_,
+      earliest_write_conflict_snapshot_, job_snapshot_seq, snapshot_checker_,
+      mutable_cf_options_.paranoid_file_checks, cfd_->internal_stats(), &io_s,
+      io_tracer_, BlobFileCreationReason::kFlush, seqno_to_time_mapping_.get(),
+      event_logger_, job_context_->job_id, table_properties, write_hint,
+      full_history_ts_low, blob_callback_, base_, num_input_entries,
+      memtable_payload_bytes, memtable_garbage_bytes);
+  // TODO: Cleanup io_status in BuildTable and table builders
+  assert(!s.ok() || io_s.ok());
+  io_s.PermitUncheckedError();
+  return s;
+}
+
+namespace {
+// A flush is only partitioned if every output table would be at least this
+// large; below that the extra L0 files cost more than the parallelism saves.
+constexpr uint64_t kMinFlushPartitionSize = 16 << 20;
+// Number of keys sampled from the memtables per partition when picking the
+// partition boundaries.
+constexpr uint64_t kFlushPartitionSampleSize = 128;
+}  // anonymous namespace
+
+std::vector<std::string> FlushJob::PickPartitionBoundaries(
+    uint64_t total_num_entries, uint64_t total_data_size,
+    bool has_range_deletions) const {
+  std::vector<std::string> boundaries;
+  // Range tombstones and blob files would have to be split across the
+  // outputs, and the boundaries below are picked without timestamps.
+  if (db_options_.max_flush_partitions <= 1 || total_num_entries == 0 ||
+      has_range_deletions || mutable_cf_options_.enable_blob_files ||
+      cfd_->user_comparator()->timestamp_size() > 0) {
+    return boundaries;
+  }
+  // Sampling is only implemented by the skip list and B-tree memtables.
+  const MemTableRepFactory* factory = cfd_->ioptions()->memtable_factory.get();
+  if (!factory->IsInstanceOf(SkipListFactory::kClassName()) &&
+      !factory->IsInstanceOf(BTreeRepFactory::kClassName())) {
+    return boundaries;
+  }
+
+  uint64_t min_partition_size = kMinFlushPartitionSize;
+  TEST_SYNC_POINT_CALLBACK(
+      "FlushJob::PickPartitionBoundaries:min_partition_size",
+      &min_partition_size);
+  const uint64_t num_partitions =
+      std::min(static_cast<uint64_t>(db_options_.max_flush_partitions),
+               total_data_size / std::max(min_partition_size, uint64_t{1}));
+  if (num_partitions <= 1) {
+    return boundaries;
+  }
+
+  // Sample each memtable in proportion to its number of entries. The sampled
+  // keys point into the memtables, which are immutable until the flush is
+  // done.
+  const uint64_t target_sample_size =
+      num_partitions * kFlushPartitionSampleSize;
+  std::vector<Slice> sampled_keys;
+  for (MemTable* m : mems_) {
+    const uint64_t num_entries = m->num_entries();
+    if (num_entries == 0) {
+      continue;
+    }
+    std::unordered_set<const char*> entries;
+    m->UniqueRandomSample(
+        std::max(target_sample_size * num_entries / total_num_entries,
+                 uint64_t{1}),
+        &entries);
+    for (const char* entry : entries) {
+      sampled_keys.push_back(ExtractUserKey(GetLengthPrefixedSlice(entry)));
+    }
+  }
+
+  const Comparator* ucmp = cfd_->user_comparator();
+  std::sort(sampled_keys.begin(), sampled_keys.end(),
+            [ucmp](const Slice& a, const Slice& b) {
+              return ucmp->Compare(a, b) < 0;
+            });
+  sampled_keys.erase(std::unique(sampled_keys.begin(), sampled_keys.end(),
+                                 [ucmp](const Slice& a, const Slice& b) {
+                                   return ucmp->Compare(a, b) == 0;
+                                 }),
+                     sampled_keys.end());
+  // Each boundary is the first user key of a partition. With fewer distinct
+  // sampled keys than partitions, some quantiles coincide and are dropped.
+  for (uint64_t i = 1; i < num_partitions; i++) {
+    const size_t idx =
+        static_cast<size_t>(i * sampled_keys.size() / num_partitions);
+    if (idx == 0 ||
+        (!boundaries.empty() &&
+         ucmp->Compare(sampled_keys[idx], boundaries.back()) <= 0)) {
+      continue;
+    }
+    boundaries.push_back(sampled_keys[idx].ToString());
+  }
+  return boundaries;
+}
+
+Status FlushJob::BuildPartitionedOutputTables(
+    InternalIterator* iter, const std::vector<std::string>& boundaries,
+    Env::IOPriority io_priority, Env::WriteLifeTimeHint write_hint,
+    uint64_t oldest_key_time, uint64_t current_time,
+    uint64_t* num_input_entries, uint64_t* memtable_payload_bytes,
+    uint64_t* memtable_garbage_bytes) {
+  assert(!boundaries.empty());
+  const InternalKeyComparator& icmp = cfd_->internal_comparator();
+  const size_t num_partitions = boundaries.size() + 1;
+
+  // All versions of a user key go to the partition that starts at or before
+  // it, so each boundary is the smallest internal key of its user key.
+  std::vector<InternalKey> bound_keys;
+  std::vector<Slice> bounds;
+  bound_keys.reserve(boundaries.size());
+  bounds.reserve(boundaries.size());
+  for (const std::string& boundary : boundaries) {
+    bound_keys.emplace_back(boundary, kMaxSequenceNumber, kValueTypeForSeek);
+    bounds.push_back(bound_keys.back().Encode());
+  }
+
+  // The first partition is written to meta_. The others get their own file
+  // numbers but otherwise share its metadata, including the epoch number.
+  partition_metas_.resize(num_partitions - 1);
+  for (FileMetaData& meta : partition_metas_) {
+    meta.fd = FileDescriptor(versions_->NewFileNumber(), 0, 0);
+    meta.epoch_number = meta_.epoch_number;
+    meta.temperature = meta_.temperature;
+    meta.oldest_ancester_time = meta_.oldest_ancester_time;
+    meta.file_creation_time = meta_.file_creation_time;
+  }
+
+  struct PartitionResult {
+    Status status;
+    TableProperties table_properties;
+    uint64_t num_input_entries = 0;
+    uint64_t memtable_payload_bytes = 0;
+    uint64_t memtable_garbage_bytes = 0;
+  };
+  std::vector<PartitionResult> results(num_partitions);
+
+  auto build_partition = [&](size_t i, InternalIterator* input) {
+    ClippingIterator clip(input, i > 0 ? &bounds[i - 1] : nullptr,
+                          i < bounds.size() ? &bounds[i] : nullptr, &icmp);
+    FileMetaData* meta = i == 0 ? &meta_ : &partition_metas_[i - 1];
+    PartitionResult& result = results[i];
+    // Blob files are not written by partitioned flushes.
+    std::vector<BlobFileAddition> blob_file_additions;
+    result.status = BuildOutputTable(
+        &clip, {} /* range_del_iters */, io_priority, write_hint,
+        oldest_key_time, current_time, meta, &blob_file_additions,
+        &result.table_properties, &result.num_input_entries,
+        &result.memtable_payload_bytes, &result.memtable_garbage_bytes);
+    assert(blob_file_additions.empty());
+  };
+
+  // Like subcompactions, the additional partitions run in dedicated threads
+  // and the first one in the current thread.
+  std::vector<port::Thread> threads;
+  threads.reserve(num_partitions - 1);
+  for (size_t i = 1; i < num_partitions; i++) {
+    threads.emplace_back([&, i]() {
+      ReadOptions ro;
+      ro.total_order_seek = true;
+      ro.io_activity = Env::IOActivity::kFlush;
+      Arena arena;
+      std::vector<InternalIterator*> memtables;
+      for (MemTable* m : mems_) {
+        memtables.push_back(
+            m->NewIterator(ro, /*seqno_to_time_mapping=*/nullptr, &arena));
+      }
+      ScopedArenaPtr<InternalIterator> partition_iter(
+          NewMergingIterator(&icmp, memtables.data(),
+                             static_cast<int>(memtables.size()), &arena));
+      build_partition(i, partition_iter.get());
+    });
+  }
+  build_partition(0, iter);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  Status s;
+  table_properties_ = results[0].table_properties;
+  for (size_t i = 0; i < num_partitions; i++) {
+    const PartitionResult& result = results[i];
+    if (s.ok() && !result.status.ok()) {
+      s = result.status;
+    }
+    if (i > 0) {
+      table_properties_.Add(result.table_properties);
+    }
+    *num_input_entries += result.num_input_entries;
+    *memtable_payload_bytes += result.memtable_payload_bytes;
+    *memtable_garbage_bytes += result.memtable_garbage_bytes;
+  }
+  return s;
+}
+
+std::vector<uint64_t> FlushJob::GetOutputFileNumbers() const {
+  std::vector<uint64_t> file_numbers;
+  file_numbers.push_back(meta_.fd.GetNumber());
+  for (const auto& meta : partition_metas_) {
+    if (meta.fd.GetFileSize() > 0) {
+      file_numbers.push_back(meta.fd.GetNumber());
+    }
+  }
+  return file_numbers;
+}
+
 Env::IOPriority FlushJob::GetRateLimiterPriority() {
   if (versions_ && versions_->GetColumnFamilySet() &&
       versions_->GetColumnFamilySet()->write_controller()) {
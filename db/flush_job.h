@@ -97,6 +97,11 @@ class FlushJob {
     return &committed_flush_jobs_info_;
   }
 
+  // Numbers of all table files written by Run(), starting with the one
+  // returned through `file_meta`. There is more than one when the flush was
+  // partitioned (see DBOptions::max_flush_partitions).
+  std::vector<uint64_t> GetOutputFileNumbers() const;
+
  private:
   friend class FlushJobTest_GetRateLimiterPriorityForWrite_Test;
 
@@ -105,6 +110,35 @@ class FlushJob {
   void RecordFlushIOStats();
   Status WriteLevel0Table();
 
+  // Builds one output table from `iter`. Thread-safe as long as each caller
+  // passes its own iterator and outputs.
+  Status BuildOutputTable(
+      InternalIterator* iter,
+      std::vector<std::unique_ptr<FragmentedRangeTombstoneIterator>>
+          range_del_iters,
+      Env::IOPriority io_priority, Env::WriteLifeTimeHint write_hint,
+      uint64_t oldest_key_time, uint64_t current_time, FileMetaData* meta,
+      std::vector<BlobFileAddition>* blob_file_additions,
+      TableProperties* table_properties, uint64_t* num_input_entries,
+      uint64_t* memtable_payload_bytes, uint64_t* memtable_garbage_bytes);
+
+  // Returns the user keys at which the picked memtables should be split into
+  // separately built output tables, or an empty vector if the flush should
+  // produce a single table.
+  std::vector<std::string> PickPartitionBoundaries(
+      uint64_t total_num_entries, uint64_t total_data_size,
+      bool has_range_deletions) const;
+
+  // Builds one output table per key range delimited by `boundaries`,
+  // concurrently. `iter` iterates over all picked memtables and is used for
+  // the first range, which is written to meta_.
+  Status BuildPartitionedOutputTables(
+      InternalIterator* iter, const std::vector<std::string>& boundaries,
+      Env::IOPriority io_priority, Env::WriteLifeTimeHint write_hint,
+      uint64_t oldest_key_time, uint64_t current_time,
+      uint64_t* num_input_entries, uint64_t* memtable_payload_bytes,
+      uint64_t* memtable_garbage_bytes);
+
   // Memtable Garbage Collection algorithm: a MemPurge takes the list
   // of immutable memtables and filters out (or "purge") the outdated bytes
   // out of it. The output (the filtered bytes, or "useful payload") is
@@ -179,7 +213,10 @@ class FlushJob {
   CompressionType output_compression_;
   Statistics* stats_;
   EventLogger* event_logger_;
+  // Properties of all output tables.
   TableProperties table_properties_;
+  // Output tables after the first one (meta_) of a partitioned flush.
+  std::vector<FileMetaData> partition_metas_;
   bool measure_io_stats_;
   // True if this flush job should call fsync on the output directory. False
   // otherwise.
@@ -0,0 +1,125 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/hot_key_tracker.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "util/hash.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+HotKeyTracker::HotKeyTracker(uint32_t hot_threshold, size_t max_hot_keys)
+    : hot_threshold_(hot_threshold),
+      max_hot_keys_(max_hot_keys),
+      counters_(new std::atomic<uint32_t>[kDepth * kWidth]) {
+  for (size_t i = 0; i < kDepth * kWidth; ++i) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+uint32_t HotKeyTracker::Record(const Slice& key, uint32_t weight) {
+  const uint64_t hash = GetSliceHash64(key);
+  uint32_t estimate = std::numeric_limits<uint32_t>::max();
+  for (int row = 0; row < kDepth; ++row) {
+    uint32_t count = counters_[CounterIndex(hash, row)].fetch_add(
+                         weight, std::memory_order_relaxed) +
+                     weight;
+    estimate = std::min(estimate, count);
+  }
+
+  uint64_t prev = num_recorded_.fetch_add(weight, std::memory_order_relaxed);
+  if ((prev + weight) / kDecayInterval != prev / kDecayInterval) {
+    Decay();
+  }
+  if (IsHot(estimate)) {
+    UpdateHotKeys(key, estimate);
+  }
+  return estimate;
+}
+
+uint32_t HotKeyTracker::Estimate(const Slice& key) const {
+  const uint64_t hash = GetSliceHash64(key);
+  uint32_t estimate = std::numeric_limits<uint32_t>::max();
+  for (int row = 0; row < kDepth; ++row) {
+    estimate = std::min(estimate, counters_[CounterIndex(hash, row)].load(
+                                      std::memory_order_relaxed));
+  }
+  return estimate;
+}
+
+void HotKeyTracker::GetHotKeys(
+    std::vector<std::pair<std::string, uint32_t>>* hot_keys) const {
+  hot_keys->clear();
+  {
+    MutexLock l(&mutex_);
+    hot_keys->reserve(hot_keys_.size());
+    for (const auto& entry : hot_keys_) {
+      hot_keys->emplace_back(entry.first, 0);
+    }
+  }
+  // Report current estimates, dropping keys that cooled down since they were
+  // last seen
+  for (auto& entry : *hot_keys) {
+    entry.second = Estimate(entry.first);
+  }
+  hot_keys->erase(
+      std::remove_if(hot_keys->begin(), hot_keys->end(),
+                     [this](const std::pair<std::string, uint32_t>& entry) {
+                       return !IsHot(entry.second);
+                     }),
+      hot_keys->end());
+  std::sort(hot_keys->begin(), hot_keys->end(),
+            [](const std::pair<std::string, uint32_t>& a,
+               const std::pair<std::string, uint32_t>& b) {
+              return a.second > b.second ||
+                     (a.second == b.second && a.first < b.first);
+            });
+}
+
+void HotKeyTracker::UpdateHotKeys(const Slice& key, uint32_t estimate) {
+  MutexLock l(&mutex_);
+  std::string key_str = key.ToString();
+  auto it = hot_keys_.find(key_str);
+  if (it != hot_keys_.end()) {
+    it->second = std::max(it->second, estimate);
+    return;
+  }
+  if (hot_keys_.size() >= max_hot_keys_) {
+    auto coldest = std::min_element(
+        hot_keys_.begin(), hot_keys_.end(),
+        [](const std::pair<const std::string, uint32_t>& a,
+           const std::pair<const std::string, uint32_t>& b) {
+          return a.second < b.second;
+        });
+    if (coldest == hot_keys_.end() || coldest->second >= estimate) {
+      return;
+    }
+    hot_keys_.erase(coldest);
+  }
+  hot_keys_.emplace(std::move(key_str), estimate);
+}
+
+void HotKeyTracker::Decay() {
+  // Concurrent increments racing with the halving may be partially lost,
+  // which is acceptable for an estimate
+  for (size_t i = 0; i < kDepth * kWidth; ++i) {
+    counters_[i].store(counters_[i].load(std::memory_order_relaxed) >> 1,
+                       std::memory_order_relaxed);
+  }
+  MutexLock l(&mutex_);
+  for (auto it = hot_keys_.begin(); it != hot_keys_.end();) {
+    it->second >>= 1;
+    if (IsHot(it->second)) {
+      ++it;
+    } else {
+      it = hot_keys_.erase(it);
+    }
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,71 @@
+//  Copyright (c) 2011-present, Facebook, Inc.  All rights reserved.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "port/port.h"
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// HotKeyTracker estimates how often each key is looked up with a count-min
+// sketch, and remembers a bounded set of the keys whose estimate reached
+// `hot_threshold` (the heavy hitters). Counts decay by half periodically so
+// that the tracker follows shifts in the workload. Used by TableCache to only
+// admit hot keys to the row cache. All methods are thread-safe.
+class HotKeyTracker {
+ public:
+  static constexpr size_t kDefaultMaxHotKeys = 32;
+
+  explicit HotKeyTracker(uint32_t hot_threshold,
+                         size_t max_hot_keys = kDefaultMaxHotKeys);
+
+  // Records `weight` lookups of `key` and returns its new estimated count.
+  uint32_t Record(const Slice& key, uint32_t weight = 1);
+
+  // Returns the estimated count of `key` without recording a lookup. The
+  // estimate never undercounts since the last decay, but may overcount.
+  uint32_t Estimate(const Slice& key) const;
+
+  bool IsHot(uint32_t estimate) const { return estimate >= hot_threshold_; }
+
+  // Returns the keys that are currently hot along with their estimated
+  // counts, hottest first.
+  void GetHotKeys(std::vector<std::pair<std::string, uint32_t>>* hot_keys) const;
+
+ private:
+  static constexpr int kDepth = 4;
+  static constexpr uint32_t kWidthBits = 12;
+  static constexpr uint32_t kWidth = uint32_t{1} << kWidthBits;
+  // Counts are halved each time this many lookups have been recorded
+  static constexpr uint64_t kDecayInterval = uint64_t{16} * kWidth;
+
+  static size_t CounterIndex(uint64_t hash, int row) {
+    return static_cast<size_t>(row) * kWidth +
+           ((hash >> (row * 16)) & (kWidth - 1));
+  }
+
+  void UpdateHotKeys(const Slice& key, uint32_t estimate);
+  void Decay();
+
+  const uint32_t hot_threshold_;
+  const size_t max_hot_keys_;
+  std::unique_ptr<std::atomic<uint32_t>[]> counters_;
+  std::atomic<uint64_t> num_recorded_{0};
+
+  mutable port::Mutex mutex_;
+  // Protected by mutex_
+  std::unordered_map<std::string, uint32_t> hot_keys_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -24,6 +24,7 @@
 #include "cache/cache_entry_stats.h"
 #include "db/column_family.h"
 #include "db/db_impl/db_impl.h"
+#include "db/table_cache.h"
 #include "db/write_stall_stats.h"
 #include "port/port.h"
 #include "rocksdb/system_clock.h"
@@ -319,6 +320,7 @@ static const std::string live_blob_file_garbage_size =
 static const std::string blob_cache_capacity = "blob-cache-capacity";
 static const std::string blob_cache_usage = "blob-cache-usage";
 static const std::string blob_cache_pinned_usage = "blob-cache-pinned-usage";
+static const std::string row_cache_hot_keys = "row-cache-hot-keys";
 
 const std::string DB::Properties::kNumFilesAtLevelPrefix =
     rocksdb_prefix + num_files_at_level_prefix;
@@ -435,6 +437,8 @@ const std::string DB::Properties::kBlobCacheUsage =
     rocksdb_prefix + blob_cache_usage;
 const std::string DB::Properties::kBlobCachePinnedUsage =
     rocksdb_prefix + blob_cache_pinned_usage;
+const std::string DB::Properties::kRowCacheHotKeys =
+    rocksdb_prefix + row_cache_hot_keys;
 
 const std::string InternalStats::kPeriodicCFStats =
     DB::Properties::kCFStats + ".periodic";
@@ -624,6 +628,9 @@ const UnorderedMap<std::string, DBPropertyInfo>
         {DB::Properties::kBlobCachePinnedUsage,
          {false, nullptr, &InternalStats::HandleBlobCachePinnedUsage, nullptr,
           nullptr}},
+        {DB::Properties::kRowCacheHotKeys,
+         {false, &InternalStats::HandleRowCacheHotKeys, nullptr,
+          &InternalStats::HandleRowCacheHotKeysMap, nullptr}},
 };
 
 InternalStats::InternalStats(int num_levels, SystemClock* clock,
@@ -634,6 +641,7 @@ InternalStats::InternalStats(int num_levels, SystemClock* clock,
       comp_stats_(num_levels),
       comp_stats_by_pri_(Env::Priority::TOTAL),
       file_read_latency_(num_levels),
+      point_lookup_misses_(num_levels),
       has_cf_change_since_dump_(true),
       bg_error_count_(0),
       number_levels_(num_levels),
@@ -957,6 +965,45 @@ bool InternalStats::HandleBlobCachePinnedUsage(uint64_t* value, DBImpl* /*db*/,
   return false;
 }
 
+bool InternalStats::HandleRowCacheHotKeys(std::string* value,
+                                          Slice /*suffix*/) {
+  std::vector<std::pair<std::string, uint32_t>> hot_keys;
+  if (!GetRowCacheHotKeys(&hot_keys)) {
+    return false;
+  }
+  std::ostringstream oss;
+  for (const auto& hot_key : hot_keys) {
+    oss << Slice(hot_key.first).ToString(/*hex=*/true) << ": "
+        << hot_key.second << "\n";
+  }
+  *value = oss.str();
+  return true;
+}
+
+bool InternalStats::HandleRowCacheHotKeysMap(
+    std::map<std::string, std::string>* values, Slice /*suffix*/) {
+  std::vector<std::pair<std::string, uint32_t>> hot_keys;
+  if (!GetRowCacheHotKeys(&hot_keys)) {
+    return false;
+  }
+  values->clear();
+  for (const auto& hot_key : hot_keys) {
+    values->emplace(hot_key.first, std::to_string(hot_key.second));
+  }
+  return true;
+}
+
+bool InternalStats::GetRowCacheHotKeys(
+    std::vector<std::pair<std::string, uint32_t>>* hot_keys) {
+  assert(cfd_);
+  TableCache* table_cache = cfd_->table_cache();
+  if (table_cache == nullptr || table_cache->hot_key_tracker() == nullptr) {
+    return false;
+  }
+  table_cache->hot_key_tracker()->GetHotKeys(hot_keys);
+  return true;
+}
+
 const DBPropertyInfo* GetPropertyInfo(const Slice& property) {
   std::string ppt_name = GetPropertyNameAndArg(property).first.ToString();
   auto ppt_info_iter = InternalStats::ppt_name_to_info.find(ppt_name);
@@ -18,6 +18,7 @@
 #include "cache/cache_entry_roles.h"
 #include "db/version_set.h"
 #include "rocksdb/system_clock.h"
+#include "util/atomic.h"
 #include "util/hash_containers.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -518,6 +519,9 @@ class InternalStats {
       h.Clear();
     }
     blob_file_read_latency_.Clear();
+    for (auto& misses : point_lookup_misses_) {
+      misses.StoreRelaxed(0);
+    }
     cf_stats_snapshot_.Clear();
     db_stats_snapshot_.Clear();
     bg_error_count_ = 0;
@@ -571,6 +575,19 @@ class InternalStats {
 
   HistogramImpl* GetBlobFileReadHist() { return &blob_file_read_latency_; }
 
+  // Records `count` point lookups that searched `level` without finding
+  // their key there.
+  void AddPointLookupMisses(int level, uint64_t count) {
+    point_lookup_misses_[level].FetchAddRelaxed(count);
+  }
+
+  void GetPointLookupMisses(std::vector<uint64_t>* misses) const {
+    misses->clear();
+    for (const auto& level_misses : point_lookup_misses_) {
+      misses->push_back(level_misses.LoadRelaxed());
+    }
+  }
+
   uint64_t GetBackgroundErrorCount() const { return bg_error_count_; }
 
   uint64_t BumpAndGetBackgroundErrorCount() { return ++bg_error_count_; }
@@ -641,6 +658,9 @@ class InternalStats {
 
   Cache* GetBlockCacheForStats();
   Cache* GetBlobCacheForStats();
+  // Returns false if the column family does not track row cache hot keys
+  bool GetRowCacheHotKeys(
+      std::vector<std::pair<std::string, uint32_t>>* hot_keys);
 
   // Per-DB stats
   std::atomic<uint64_t> db_stats_[kIntStatsNumMax];
@@ -660,6 +680,8 @@ class InternalStats {
   CompactionStats per_key_placement_comp_stats_;
   std::vector<HistogramImpl> file_read_latency_;
   HistogramImpl blob_file_read_latency_;
+  // Per-level point lookup misses, sampled like file reads
+  std::vector<RelaxedAtomic<uint64_t>> point_lookup_misses_;
   bool has_cf_change_since_dump_;
   // How many periods of no change since the last time stats are dumped for
   // a periodic dump.
@@ -859,6 +881,9 @@ class InternalStats {
   bool HandleBlobCacheUsage(uint64_t* value, DBImpl* db, Version* version);
   bool HandleBlobCachePinnedUsage(uint64_t* value, DBImpl* db,
                                   Version* version);
+  bool HandleRowCacheHotKeys(std::string* value, Slice suffix);
+  bool HandleRowCacheHotKeysMap(std::map<std::string, std::string>* values,
+                                Slice suffix);
 
   // Total number of background errors encountered. Every time a flush task
   // or compaction task fails, this counter is incremented. The failure can
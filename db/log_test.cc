@@ -349,6 +349,46 @@ TEST_P(LogTest, Fragmentation) {
   ASSERT_EQ("EOF", Read());
 }
 
+TEST_P(LogTest, RecordPieces) {
+  auto write_pieces = [&](const std::vector<std::string>& parts,
+                          bool with_crcs) {
+    std::vector<RecordPiece> pieces(parts.size());
+    for (size_t i = 0; i < parts.size(); ++i) {
+      pieces[i].data = parts[i];
+      if (with_crcs) {
+        pieces[i].has_crc = true;
+        pieces[i].crc = crc32c::Value(parts[i].data(), parts[i].size());
+      }
+    }
+    EXPECT_OK(writer_->AddRecord(WriteOptions(), pieces.data(), pieces.size()));
+    std::string record;
+    for (const auto& part : parts) {
+      record += part;
+    }
+    return record;
+  };
+
+  std::vector<std::string> records;
+  records.push_back(write_pieces({}, /*with_crcs=*/true));
+  records.push_back(write_pieces({"foo", "", "bar"}, /*with_crcs=*/true));
+  records.push_back(write_pieces({"small"}, /*with_crcs=*/false));
+  // Pieces split across blocks
+  records.push_back(write_pieces(
+      {"header", BigString("medium", 50000), BigString("large", 100000)},
+      /*with_crcs=*/true));
+  std::vector<std::string> many_parts;
+  for (int i = 0; i < 1000; i++) {
+    many_parts.push_back(BigString(NumberString(i), 100 + i));
+  }
+  records.push_back(write_pieces(many_parts, /*with_crcs=*/true));
+  records.push_back(write_pieces(many_parts, /*with_crcs=*/false));
+
+  for (const auto& record : records) {
+    ASSERT_EQ(record, Read());
+  }
+  ASSERT_EQ("EOF", Read());
+}
+
 TEST_P(LogTest, MarginalTrailer) {
   // Make a trailer that is exactly the same length as an empty record.
   int header_size =
@@ -9,6 +9,7 @@
 
 #include "db/log_writer.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "file/writable_file_writer.h"
@@ -117,23 +118,9 @@ IOStatus Writer::AddRecord(const WriteOptions& write_options,
   s = WritableFileWriter::PrepareIOOptions(write_options, opts);
   if (s.ok()) {
     do {
-      const int64_t leftover = kBlockSize - block_offset_;
-      assert(leftover >= 0);
-      if (leftover < header_size_) {
-        // Switch to a new block
-        if (leftover > 0) {
-          // Fill the trailer (literal below relies on kHeaderSize and
-          // kRecyclableHeaderSize being <= 11)
-          assert(header_size_ <= 11);
-          s = dest_->Append(opts,
-                            Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
-                                  static_cast<size_t>(leftover)),
-                            0 /* crc32c_checksum */);
-          if (!s.ok()) {
-            break;
-          }
-        }
-        block_offset_ = 0;
+      s = MaybeSwitchToNewBlock(opts);
+      if (!s.ok()) {
+        break;
       }
 
       // Invariant: we never leave < header_size bytes in a block.
@@ -193,6 +180,125 @@ IOStatus Writer::AddRecord(const WriteOptions& write_options,
   return s;
 }
 
+IOStatus Writer::AddRecord(const WriteOptions& write_options,
+                           const RecordPiece* pieces, size_t num_pieces) {
+  if (compress_) {
+    // The record is compressed as a whole
+    std::string record;
+    for (size_t i = 0; i < num_pieces; ++i) {
+      record.append(pieces[i].data.data(), pieces[i].data.size());
+    }
+    return AddRecord(write_options, record);
+  }
+  if (dest_->seen_error()) {
+#ifndef NDEBUG
+    if (dest_->seen_injected_error()) {
+      return IOStatus::IOError("Seen injected error. Skip writing buffer.");
+    }
+#endif  // NDEBUG
+    return IOStatus::IOError("Seen error. Skip writing buffer.");
+  }
+
+  size_t left = 0;
+  for (size_t i = 0; i < num_pieces; ++i) {
+    left += pieces[i].data.size();
+  }
+  // Position of the next payload byte
+  size_t piece_index = 0;
+  size_t piece_offset = 0;
+  bool begin = true;
+  std::vector<PayloadPart>& parts = payload_parts_;
+
+  IOStatus s;
+  IOOptions opts;
+  s = WritableFileWriter::PrepareIOOptions(write_options, opts);
+  if (s.ok()) {
+    do {
+      s = MaybeSwitchToNewBlock(opts);
+      if (!s.ok()) {
+        break;
+      }
+
+      const size_t avail = kBlockSize - block_offset_ - header_size_;
+      const size_t fragment_length = (left < avail) ? left : avail;
+
+      // Split the fragment into the parts of the pieces it covers
+      parts.clear();
+      uint32_t payload_crc = 0;
+      size_t part_left = fragment_length;
+      while (part_left > 0) {
+        assert(piece_index < num_pieces);
+        const RecordPiece& piece = pieces[piece_index];
+        const size_t part_length =
+            std::min(piece.data.size() - piece_offset, part_left);
+        if (part_length > 0) {
+          const char* part_data = piece.data.data() + piece_offset;
+          const uint32_t part_crc =
+              (piece.has_crc && part_length == piece.data.size())
+                  ? piece.crc
+                  : crc32c::Value(part_data, part_length);
+          payload_crc =
+              crc32c::Crc32cCombine(payload_crc, part_crc, part_length);
+          parts.emplace_back(Slice(part_data, part_length), part_crc);
+          piece_offset += part_length;
+          part_left -= part_length;
+        }
+        if (piece_offset == piece.data.size()) {
+          ++piece_index;
+          piece_offset = 0;
+        }
+      }
+
+      RecordType type;
+      const bool end = (left == fragment_length);
+      if (begin && end) {
+        type = recycle_log_files_ ? kRecyclableFullType : kFullType;
+      } else if (begin) {
+        type = recycle_log_files_ ? kRecyclableFirstType : kFirstType;
+      } else if (end) {
+        type = recycle_log_files_ ? kRecyclableLastType : kLastType;
+      } else {
+        type = recycle_log_files_ ? kRecyclableMiddleType : kMiddleType;
+      }
+
+      s = EmitPhysicalRecord(write_options, type, parts.data(), parts.size(),
+                             fragment_length, payload_crc);
+      left -= fragment_length;
+      begin = false;
+    } while (s.ok() && left > 0);
+  }
+  if (s.ok()) {
+    if (!manual_flush_) {
+      s = dest_->Flush(opts);
+    }
+  }
+
+  return s;
+}
+
+IOStatus Writer::MaybeSwitchToNewBlock(const IOOptions& opts) {
+  const int64_t leftover = kBlockSize - block_offset_;
+  assert(leftover >= 0);
+  if (leftover < header_size_) {
+    // Switch to a new block
+    if (leftover > 0) {
+      // Fill the trailer (literal below relies on kHeaderSize and
+      // kRecyclableHeaderSize being <= 11)
+      assert(header_size_ <= 11);
+      IOStatus s = dest_->Append(
+          opts,
+          Slice("\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+                static_cast<size_t>(leftover)),
+          0 /* crc32c_checksum */);
+      if (!s.ok()) {
+        return s;
+      }
+    }
+    block_offset_ = 0;
+  }
+  return IOStatus::OK();
+}
+
 IOStatus Writer::AddCompressionTypeRecord(const WriteOptions& write_options) {
   // Should be the first record
   assert(block_offset_ == 0);
@@ -292,6 +398,14 @@ bool Writer::BufferIsEmpty() { return dest_->BufferIsEmpty(); }
 
 IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
                                     RecordType t, const char* ptr, size_t n) {
+  const PayloadPart part(Slice(ptr, n), crc32c::Value(ptr, n));
+  return EmitPhysicalRecord(write_options, t, &part, 1, n, part.second);
+}
+
+IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
+                                    RecordType t, const PayloadPart* parts,
+                                    size_t num_parts, size_t n,
+                                    uint32_t payload_crc) {
   assert(n <= 0xffff);  // Must fit in two bytes
 
   size_t header_size;
@@ -323,7 +437,6 @@ IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
   }
 
   // Compute the crc of the record type and the payload.
-  uint32_t payload_crc = crc32c::Value(ptr, n);
   crc = crc32c::Crc32cCombine(crc, payload_crc, n);
   crc = crc32c::Mask(crc);  // Adjust for storage
   TEST_SYNC_POINT_CALLBACK("LogWriter::EmitPhysicalRecord:BeforeEncodeChecksum",
@@ -336,8 +449,8 @@ IOStatus Writer::EmitPhysicalRecord(const WriteOptions& write_options,
   if (s.ok()) {
     s = dest_->Append(opts, Slice(buf, header_size), 0 /* crc32c_checksum */);
   }
-  if (s.ok()) {
-    s = dest_->Append(opts, Slice(ptr, n), payload_crc);
+  for (size_t i = 0; s.ok() && i < num_parts; ++i) {
+    s = dest_->Append(opts, parts[i].first, parts[i].second);
   }
   block_offset_ += header_size + n;
   return s;
@@ -71,6 +71,15 @@ namespace log {
  * Log number = 32bit log file number, so that we can distinguish between
  * records written by the most recent log writer vs a previous one.
  */
+
+// A part of a record that is passed to Writer::AddRecord() in several parts,
+// with the crc32c checksum of its data if that was computed ahead of time.
+struct RecordPiece {
+  Slice data;
+  bool has_crc = false;
+  uint32_t crc = 0;
+};
+
 class Writer {
  public:
   // Create a writer that will append data to "*dest".
@@ -87,6 +96,14 @@ class Writer {
   ~Writer();
 
   IOStatus AddRecord(const WriteOptions& write_options, const Slice& slice);
+
+  // Same as AddRecord() for the concatenation of `pieces`, without copying
+  // them into one buffer. The checksum of each physical record combines the
+  // checksums of the pieces that it fully contains, so only the parts of
+  // pieces without a checksum, or split by a block boundary, are read to
+  // compute it.
+  IOStatus AddRecord(const WriteOptions& write_options,
+                     const RecordPiece* pieces, size_t num_pieces);
   IOStatus AddCompressionTypeRecord(const WriteOptions& write_options);
 
   // If there are column families in `cf_to_ts_sz` not included in
@@ -128,8 +145,21 @@ class Writer {
   // record type stored in the header.
   uint32_t type_crc_[kMaxRecordType + 1];
 
+  // A contiguous part of the payload of a physical record, and its checksum
+  using PayloadPart = std::pair<Slice, uint32_t>;
+
   IOStatus EmitPhysicalRecord(const WriteOptions& write_options,
                               RecordType type, const char* ptr, size_t length);
+  // Emits a physical record of `length` bytes made of the given parts, whose
+  // combined checksum is `payload_crc`.
+  IOStatus EmitPhysicalRecord(const WriteOptions& write_options,
+                              RecordType type, const PayloadPart* parts,
+                              size_t num_parts, size_t length,
+                              uint32_t payload_crc);
+
+  // Pads the rest of the current block and starts a new one if the current
+  // block cannot fit another record header.
+  IOStatus MaybeSwitchToNewBlock(const IOOptions& opts);
 
   // If true, it does not flush after each write. Instead it relies on the upper
   // layer to manually does the flush by calling ::WriteBuffer()
@@ -140,6 +170,8 @@ class Writer {
   StreamingCompress* compress_;
   // Reusable compressed output buffer
   std::unique_ptr<char[]> compressed_buffer_;
+  // Reusable parts of a physical record written from RecordPieces
+  std::vector<PayloadPart> payload_parts_;
 
   // The recorded user-defined timestamp size that have been written so far.
   // Since the user-defined timestamp size cannot be changed while the DB is
@@ -145,6 +145,88 @@ TEST_F(MergeHelperTest, SingleOperand) {
   ASSERT_EQ(1U, merge_helper_->values().size());
 }
 
+// Stacked operands are partially merged into one, treating corrupted
+// operands as 0.
+TEST_F(MergeHelperTest, PartialMergeUInt64Add) {
+  merge_op_ = MergeOperators::CreateUInt64AddOperator();
+
+  AddKeyVal("a", 50, kTypeMerge, test::EncodeInt(1U));
+  AddKeyVal("a", 40, kTypeMerge, test::EncodeInt(3U));
+  AddKeyVal("a", 30, kTypeMerge, "bad");
+  AddKeyVal("a", 20, kTypeMerge, test::EncodeInt(5U));
+
+  ASSERT_TRUE(Run(0, false).IsMergeInProgress());
+  ASSERT_FALSE(iter_->Valid());
+  ASSERT_EQ(test::KeyStr("a", 50, kTypeMerge), merge_helper_->keys()[0]);
+  ASSERT_EQ(test::EncodeInt(9U), merge_helper_->values()[0]);
+  ASSERT_EQ(1U, merge_helper_->keys().size());
+  ASSERT_EQ(1U, merge_helper_->values().size());
+}
+
+// Keeps the largest operand, failing merges with corrupted operands
+class StrictMaxOperator : public TypedAssociativeMergeOperator<uint64_t> {
+ public:
+  const char* Name() const override { return "StrictMaxOperator"; }
+
+  bool Decode(const Slice& value, uint64_t* decoded,
+              Logger* /*logger*/) const override {
+    if (value.size() != sizeof(uint64_t)) {
+      return false;
+    }
+    *decoded = DecodeFixed64(value.data());
+    return true;
+  }
+
+  void Fold(const uint64_t& value, uint64_t* acc) const override {
+    *acc = std::max(*acc, value);
+  }
+
+  void Encode(const uint64_t& acc, std::string* encoded) const override {
+    PutFixed64(encoded, acc);
+  }
+};
+
+// Typed associative operators fold all operands in full and partial merges
+TEST_F(MergeHelperTest, TypedAssociativeMerge) {
+  merge_op_ = std::make_shared<StrictMaxOperator>();
+
+  AddKeyVal("a", 50, kTypeMerge, test::EncodeInt(7U));
+  AddKeyVal("a", 40, kTypeMerge, test::EncodeInt(9U));
+  AddKeyVal("a", 30, kTypeMerge, test::EncodeInt(2U));
+  AddKeyVal("a", 20, kTypeValue, test::EncodeInt(5U));  // <- iter_ after merge
+  AddKeyVal("b", 10, kTypeMerge, test::EncodeInt(4U));
+
+  ASSERT_OK(Run(0, false));
+  ASSERT_EQ(ks_[4], iter_->key());
+  ASSERT_EQ(test::KeyStr("a", 50, kTypeValue), merge_helper_->keys()[0]);
+  ASSERT_EQ(test::EncodeInt(9U), merge_helper_->values()[0]);
+  ASSERT_EQ(1U, merge_helper_->keys().size());
+
+  ks_.erase(ks_.begin() + 3, ks_.end());
+  vs_.erase(vs_.begin() + 3, vs_.end());
+  ASSERT_TRUE(Run(0, false).IsMergeInProgress());
+  ASSERT_FALSE(iter_->Valid());
+  ASSERT_EQ(test::KeyStr("a", 50, kTypeMerge), merge_helper_->keys()[0]);
+  ASSERT_EQ(test::EncodeInt(9U), merge_helper_->values()[0]);
+  ASSERT_EQ(1U, merge_helper_->keys().size());
+}
+
+// A corrupted operand fails a typed full merge, and leaves the operands
+// unmerged when they cannot be partially merged
+TEST_F(MergeHelperTest, TypedAssociativeMergeCorruption) {
+  merge_op_ = std::make_shared<StrictMaxOperator>();
+
+  AddKeyVal("a", 50, kTypeMerge, test::EncodeInt(7U));
+  AddKeyVal("a", 40, kTypeMerge, "bad");
+  AddKeyVal("a", 30, kTypeMerge, test::EncodeInt(9U));
+
+  ASSERT_TRUE(Run(0, false).IsMergeInProgress());
+  ASSERT_EQ(3U, merge_helper_->keys().size());
+  ASSERT_EQ(3U, merge_helper_->values().size());
+
+  ASSERT_TRUE(Run(0, true).IsCorruption());
+}
+
 // Merging with a deletion turns the deletion into a value
 TEST_F(MergeHelperTest, MergeDeletion) {
   merge_op_ = MergeOperators::CreateUInt64AddOperator();
@@ -136,11 +136,14 @@ bool MergeOperator::PartialMergeMulti(const Slice& key,
 bool AssociativeMergeOperator::FullMergeV2(
     const MergeOperationInput& merge_in,
     MergeOperationOutput* merge_out) const {
-  // Simply loop through the operands
+  // Simply loop through the operands. Merge results alternate between
+  // temp_value and new_value, so after the first two operands the strings'
+  // capacity is reused instead of allocating a string per operand.
   Slice temp_existing;
   const Slice* existing_value = merge_in.existing_value;
+  std::string temp_value;
   for (const auto& operand : merge_in.operand_list) {
-    std::string temp_value;
+    temp_value.clear();
     if (!Merge(merge_in.key, existing_value, operand, &temp_value,
                merge_in.logger)) {
       return false;
@@ -29,6 +29,7 @@
 #include "test_util/sync_point.h"
 #include "util/cast_util.h"
 #include "util/coding.h"
+#include "util/random.h"
 #include "util/stop_watch.h"
 
 // Generate the regular and coroutine versions of some methods by
@@ -82,6 +83,10 @@ TableCache::TableCache(const ImmutableOptions& ioptions,
     // If the same cache is shared by multiple instances, we need to
     // disambiguate its entries.
     PutVarint64(&row_cache_id_, ioptions_.row_cache->NewId());
+    if (ioptions_.row_cache_admission_threshold > 0) {
+      hot_key_tracker_.reset(
+          new HotKeyTracker(ioptions_.row_cache_admission_threshold));
+    }
   }
 }
 
@@ -422,6 +427,12 @@ bool TableCache::GetFromRowCache(const Slice& user_key, IterKey& row_cache_key,
     *read_status = replayGetContextLog(*row_cache.Value(row_handle), user_key,
                                        get_context, &value_pinner, seq_no);
     RecordTick(ioptions_.stats, ROW_CACHE_HIT);
+    // Keep hot keys that are already cached tracked, without contending on
+    // the sketch counters for every hit
+    if (hot_key_tracker_ &&
+        Random::GetTLSInstance()->OneIn(kRowCacheHitSampleRate)) {
+      hot_key_tracker_->Record(user_key, kRowCacheHitSampleRate);
+    }
     found = true;
   } else {
     RecordTick(ioptions_.stats, ROW_CACHE_MISS);
@@ -429,6 +440,11 @@ bool TableCache::GetFromRowCache(const Slice& user_key, IterKey& row_cache_key,
   return found;
 }
 
+bool TableCache::AdmitToRowCache(const Slice& user_key) {
+  return hot_key_tracker_ == nullptr ||
+         hot_key_tracker_->IsHot(hot_key_tracker_->Record(user_key));
+}
+
 Status TableCache::Get(
     const ReadOptions& options,
     const InternalKeyComparator& internal_comparator,
@@ -452,7 +468,7 @@ Status TableCache::Get(
         CreateRowCacheKeyPrefix(options, fd, k, get_context, row_cache_key);
     done = GetFromRowCache(user_key, row_cache_key, row_cache_key.Size(),
                            get_context, &s, cache_entry_seq_no);
-    if (!done) {
+    if (!done && AdmitToRowCache(user_key)) {
       row_cache_entry = &row_cache_entry_buffer;
     }
   }
@@ -11,11 +11,13 @@
 
 #pragma once
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "cache/typed_cache.h"
 #include "db/dbformat.h"
+#include "db/hot_key_tracker.h"
 #include "db/range_del_aggregator.h"
 #include "options/cf_options.h"
 #include "port/port.h"
@@ -57,6 +59,10 @@ class TableCache {
              const std::string& db_session_id);
   ~TableCache();
 
+  // Tracks the keys looked up in the row cache when
+  // row_cache_admission_threshold is set, otherwise nullptr
+  HotKeyTracker* hot_key_tracker() const { return hot_key_tracker_.get(); }
+
   // Cache interface for table cache
   using CacheInterface =
       BasicTypedCacheInterface<TableReader, CacheEntryRole::kMisc>;
@@ -284,10 +290,21 @@ class TableCache {
                        Status* read_status,
                        SequenceNumber seq_no = kMaxSequenceNumber);
 
+  // Records a row cache miss of user_key and returns whether its row should
+  // be inserted into the row cache after it is read from the table. Always
+  // true unless row_cache_admission_threshold is set.
+  bool AdmitToRowCache(const Slice& user_key);
+
+  // Row cache hits are recorded in the hot key tracker one in this many
+  // times, with a matching weight
+  static constexpr uint32_t kRowCacheHitSampleRate = 16;
+
   const ImmutableOptions& ioptions_;
   const FileOptions& file_options_;
   CacheInterface cache_;
   std::string row_cache_id_;
+  // Set when row_cache_admission_threshold is non-zero
+  std::unique_ptr<HotKeyTracker> hot_key_tracker_;
   bool immortal_tables_;
   BlockCacheTracer* const block_cache_tracer_;
   Striped<CacheAlignedWrapper<port::Mutex>> loader_mutex_;
@@ -61,7 +61,9 @@ DEFINE_SYNC_AND_ASYNC(Status, TableCache::MultiGet)
         table_range.SkipKey(miter);
       } else {
         row_cache_entries.emplace_back();
-        get_context->SetReplayLog(&(row_cache_entries.back()));
+        if (AdmitToRowCache(user_key)) {
+          get_context->SetReplayLog(&(row_cache_entries.back()));
+        }
       }
     }
   }
@@ -1299,10 +1299,18 @@ class VersionBuilder::Rep {
       }
     }
 
+    // With open_files_in_background, the initial load only opens the levels
+    // most reads start with. DBImpl opens the rest once DB::Open() returns.
+    int max_level = num_levels_ - 1;
+    if (always_load && is_initial_load && version_set_ != nullptr &&
+        version_set_->db_options()->open_files_in_background) {
+      max_level = std::min(max_level, 1);
+    }
+
     // <file metadata, level>
     std::vector<std::pair<FileMetaData*, int>> files_meta;
     std::vector<Status> statuses;
-    for (int level = 0; level < num_levels_; level++) {
+    for (int level = 0; level <= max_level; level++) {
       for (auto& file_meta_pair : levels_[level].added_files) {
         auto* file_meta = file_meta_pair.second;
         // If the file has been opened before, just skip it.
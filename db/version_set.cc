@@ -66,6 +66,7 @@
 #include "table/meta_blocks.h"
 #include "table/multiget_context.h"
 #include "table/plain/plain_table_factory.h"
+#include "table/table_builder.h"
 #include "table/table_reader.h"
 #include "table/two_level_iterator.h"
 #include "table/unique_id_impl.h"
@@ -1009,7 +1010,10 @@ class LevelIterator final : public InternalIterator {
     }
   }
 
-  ~LevelIterator() override { delete file_iter_.Set(nullptr); }
+  ~LevelIterator() override {
+    DropPrefetchedFileIterator();
+    delete file_iter_.Set(nullptr);
+  }
 
   // Seek to the first file with a key >= target.
   // If range_tombstone_iter_ is not nullptr, then we pretend that file
@@ -1020,6 +1024,7 @@ class LevelIterator final : public InternalIterator {
   void SeekForPrev(const Slice& target) override;
   void SeekToFirst() override;
   void SeekToLast() override;
+  void PrepareSeek(const Slice& target) override;
   void Next() final override;
   bool NextAndGetResult(IterateResult* result) override;
   void Prev() override;
@@ -1099,6 +1104,18 @@ class LevelIterator final : public InternalIterator {
   void SetFileIterator(InternalIterator* iter);
   void InitFileIterator(size_t new_file_index);
 
+  // With ReadOptions::async_io, once a forward scan reaches the last data
+  // block of the current file, creates the iterator of the next file and
+  // starts reading its first data block asynchronously, so that moving to
+  // that file does not wait for a synchronous read.
+  void MaybePrefetchNextFile();
+  // Moves file_iter_ to the iterator created by MaybePrefetchNextFile().
+  void UsePrefetchedFileIterator();
+  void DropPrefetchedFileIterator() {
+    prefetched_file_iter_.reset();
+    prefetched_range_tombstone_iter_.reset();
+  }
+
   const Slice& file_smallest_key(size_t file_index) {
     assert(file_index < flevel_->num_files);
     return flevel_->files[file_index].smallest_key;
@@ -1126,8 +1143,19 @@ class LevelIterator final : public InternalIterator {
   // range_tombstone_iter_ is updated with a range tombstone iterator
   // into the new file. Old range tombstone iterator is cleared.
   InternalIterator* NewFileIterator() {
-    assert(file_index_ < flevel_->num_files);
-    auto file_meta = flevel_->files[file_index_];
+    CheckMayBeOutOfLowerBound();
+    ClearRangeTombstoneIter();
+    return NewFileIterator(file_index_, range_tombstone_iter_);
+  }
+
+  // Creates an iterator into the file at `file_index`. If
+  // `range_tombstone_iter` is not nullptr, it is set to a range tombstone
+  // iterator into the file.
+  InternalIterator* NewFileIterator(
+      size_t file_index,
+      std::unique_ptr<TruncatedRangeDelIterator>* range_tombstone_iter) {
+    assert(file_index < flevel_->num_files);
+    auto file_meta = flevel_->files[file_index];
     if (should_sample_) {
       sample_file_read_inc(file_meta.file_metadata);
     }
@@ -1135,11 +1163,9 @@ class LevelIterator final : public InternalIterator {
     const InternalKey* smallest_compaction_key = nullptr;
     const InternalKey* largest_compaction_key = nullptr;
     if (compaction_boundaries_ != nullptr) {
-      smallest_compaction_key = (*compaction_boundaries_)[file_index_].smallest;
-      largest_compaction_key = (*compaction_boundaries_)[file_index_].largest;
+      smallest_compaction_key = (*compaction_boundaries_)[file_index].smallest;
+      largest_compaction_key = (*compaction_boundaries_)[file_index].largest;
     }
-    CheckMayBeOutOfLowerBound();
-    ClearRangeTombstoneIter();
     return table_cache_->NewIterator(
         read_options_, file_options_, icomparator_, *file_meta.file_metadata,
         range_del_agg_, prefix_extractor_,
@@ -1147,7 +1173,7 @@ class LevelIterator final : public InternalIterator {
         /*arena=*/nullptr, skip_filters_, level_,
         /*max_file_size_for_l0_meta_pin=*/0, smallest_compaction_key,
         largest_compaction_key, allow_unprepared_value_,
-        block_protection_bytes_per_key_, &read_seq_, range_tombstone_iter_);
+        block_protection_bytes_per_key_, &read_seq_, range_tombstone_iter);
   }
 
   // Check if current file being fully within iterate_lower_bound.
@@ -1203,6 +1229,14 @@ class LevelIterator final : public InternalIterator {
   // *range_tombstone_iter_ points to range tombstones of the current SST file
   std::unique_ptr<TruncatedRangeDelIterator>* range_tombstone_iter_;
 
+  // Iterator into the file at prefetched_file_index_, with its first data
+  // block being read, see MaybePrefetchNextFile(). Not positioned. Its range
+  // tombstones are kept in prefetched_range_tombstone_iter_ until it becomes
+  // file_iter_.
+  std::unique_ptr<InternalIterator> prefetched_file_iter_;
+  std::unique_ptr<TruncatedRangeDelIterator> prefetched_range_tombstone_iter_;
+  size_t prefetched_file_index_ = 0;
+
   // The sentinel key to be returned
   Slice sentinel_;
   SequenceNumber read_seq_;
@@ -1237,7 +1271,22 @@ void LevelIterator::TrySetDeleteRangeSentinel(const Slice& boundary_key) {
   }
 }
 
+void LevelIterator::PrepareSeek(const Slice& target) {
+  if (!read_options_.async_io) {
+    return;
+  }
+  DropPrefetchedFileIterator();
+  ClearSentinel();
+  // Open the file that Seek(target) will use, and start reading its block.
+  // Seek() keeps this file iterator as it is the same file.
+  InitFileIterator(FindFile(icomparator_, *flevel_, target));
+  if (file_iter_.iter() != nullptr) {
+    file_iter_.PrepareSeek(target);
+  }
+}
+
 void LevelIterator::Seek(const Slice& target) {
+  DropPrefetchedFileIterator();
   prefix_exhausted_ = false;
   ClearSentinel();
   // Check whether the seek key fall under the same file
@@ -1331,6 +1380,7 @@ void LevelIterator::Seek(const Slice& target) {
 }
 
 void LevelIterator::SeekForPrev(const Slice& target) {
+  DropPrefetchedFileIterator();
   prefix_exhausted_ = false;
   ClearSentinel();
   size_t new_file_index = FindFile(icomparator_, *flevel_, target);
@@ -1366,6 +1416,7 @@ void LevelIterator::SeekForPrev(const Slice& target) {
 }
 
 void LevelIterator::SeekToFirst() {
+  DropPrefetchedFileIterator();
   prefix_exhausted_ = false;
   ClearSentinel();
   InitFileIterator(0);
@@ -1382,6 +1433,7 @@ void LevelIterator::SeekToFirst() {
 }
 
 void LevelIterator::SeekToLast() {
+  DropPrefetchedFileIterator();
   prefix_exhausted_ = false;
   ClearSentinel();
   InitFileIterator(flevel_->num_files - 1);
@@ -1407,6 +1459,9 @@ void LevelIterator::Next() {
     }
   }
   SkipEmptyFileForward();
+  if (read_options_.async_io) {
+    MaybePrefetchNextFile();
+  }
 }
 
 bool LevelIterator::NextAndGetResult(IterateResult* result) {
@@ -1440,11 +1495,15 @@ bool LevelIterator::NextAndGetResult(IterateResult* result) {
       }
     }
   }
+  if (read_options_.async_io) {
+    MaybePrefetchNextFile();
+  }
   return is_valid;
 }
 
 void LevelIterator::Prev() {
   assert(Valid());
+  DropPrefetchedFileIterator();
   if (to_return_sentinel_) {
     ClearSentinel();
   } else {
@@ -1473,8 +1532,14 @@ bool LevelIterator::SkipEmptyFileForward() {
       ClearRangeTombstoneIter();
       break;
     }
-    // may init a new *range_tombstone_iter
-    InitFileIterator(file_index_ + 1);
+    if (prefetched_file_iter_ != nullptr &&
+        prefetched_file_index_ == file_index_ + 1) {
+      UsePrefetchedFileIterator();
+    } else {
+      DropPrefetchedFileIterator();
+      // may init a new *range_tombstone_iter
+      InitFileIterator(file_index_ + 1);
+    }
     // We moved to a new SST file
     // Seek range_tombstone_iter_ to reset its !Valid() default state.
     // We do not need to call range_tombstone_iter_.Seek* in
@@ -1543,6 +1608,36 @@ void LevelIterator::SetFileIterator(InternalIterator* iter) {
   }
 }
 
+void LevelIterator::MaybePrefetchNextFile() {
+  // Iterators created for compaction add range tombstones to range_del_agg_
+  // as soon as they are created, so only prefetch for user reads.
+  if (prefetched_file_iter_ != nullptr || range_del_agg_ != nullptr ||
+      !file_iter_.Valid() || prefix_exhausted_ ||
+      file_index_ + 1 >= flevel_->num_files ||
+      KeyReachedUpperBound(file_smallest_key(file_index_ + 1)) ||
+      !file_iter_.iter()->IsInLastDataBlock()) {
+    return;
+  }
+  prefetched_file_index_ = file_index_ + 1;
+  prefetched_file_iter_.reset(NewFileIterator(
+      prefetched_file_index_,
+      range_tombstone_iter_ ? &prefetched_range_tombstone_iter_ : nullptr));
+  TEST_SYNC_POINT_CALLBACK("LevelIterator::MaybePrefetchNextFile",
+                           &prefetched_file_index_);
+  prefetched_file_iter_->PrepareSeekToFirst();
+}
+
+void LevelIterator::UsePrefetchedFileIterator() {
+  assert(prefetched_file_iter_ != nullptr);
+  file_index_ = prefetched_file_index_;
+  CheckMayBeOutOfLowerBound();
+  if (range_tombstone_iter_) {
+    *range_tombstone_iter_ = std::move(prefetched_range_tombstone_iter_);
+  }
+  SetFileIterator(prefetched_file_iter_.release());
+  prefetched_range_tombstone_iter_.reset();
+}
+
 void LevelIterator::InitFileIterator(size_t new_file_index) {
   if (new_file_index >= flevel_->num_files) {
     file_index_ = new_file_index;
@@ -1638,6 +1733,56 @@ Status Version::GetPropertiesOfAllTables(const ReadOptions& read_options,
   return Status::OK();
 }
 
+void Version::OpenTableFiles(const ReadOptions& read_options, int max_threads,
+                             const std::atomic<bool>& stop) {
+  // <file metadata, level>
+  std::vector<std::pair<FileMetaData*, int>> files_meta;
+  for (int level = 0; level < storage_info_.num_levels_; level++) {
+    for (FileMetaData* file_meta : storage_info_.LevelFiles(level)) {
+      if (file_meta->table_reader_handle == nullptr) {
+        files_meta.emplace_back(file_meta, level);
+      }
+    }
+  }
+
+  std::atomic<size_t> next_file_meta_idx(0);
+  std::function<void()> open_files_func([&]() {
+    while (!stop.load(std::memory_order_acquire)) {
+      size_t file_idx = next_file_meta_idx.fetch_add(1);
+      if (file_idx >= files_meta.size()) {
+        break;
+      }
+
+      const FileMetaData* file_meta = files_meta[file_idx].first;
+      int level = files_meta[file_idx].second;
+      TableCache::TypedHandle* handle = nullptr;
+      Status s = table_cache_->FindTable(
+          read_options, file_options_, *storage_info_.InternalComparator(),
+          *file_meta, &handle,
+          mutable_cf_options_.block_protection_bytes_per_key,
+          mutable_cf_options_.prefix_extractor, false /* no_io */,
+          cfd_->internal_stats()->GetFileReadHist(level),
+          false /* skip_filters */, level,
+          false /* prefetch_index_and_filter_in_cache */,
+          max_file_size_for_l0_meta_pin_, file_meta->temperature);
+      if (handle != nullptr) {
+        table_cache_->get_cache().Release(handle);
+      }
+      s.PermitUncheckedError();
+    }
+  });
+
+  std::vector<port::Thread> threads;
+  for (int i = 1; i < max_threads && static_cast<size_t>(i) < files_meta.size();
+       i++) {
+    threads.emplace_back(open_files_func);
+  }
+  open_files_func();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
 Status Version::TablesRangeTombstoneSummary(int max_entries_to_print,
                                             std::string* out_str) {
   if (max_entries_to_print <= 0) {
@@ -1922,6 +2067,17 @@ void Version::GetCreationTimeOfOldestFile(uint64_t* creation_time) {
   *creation_time = oldest_time;
 }
 
+void Version::SetFilterBuildingStats(TableBuilderOptions* tboptions) const {
+  tboptions->level_data_bytes.clear();
+  for (int level = 0; level < storage_info_.num_levels(); level++) {
+    tboptions->level_data_bytes.push_back(storage_info_.NumLevelBytes(level));
+  }
+  if (cfd_ != nullptr && cfd_->internal_stats() != nullptr) {
+    cfd_->internal_stats()->GetPointLookupMisses(
+        &tboptions->level_point_lookup_misses);
+  }
+}
+
 InternalIterator* Version::TEST_GetLevelIterator(
     const ReadOptions& read_options, MergeIteratorBuilder* merge_iter_builder,
     int level, bool allow_unprepared_value) {
@@ -2471,6 +2627,10 @@ void Version::Get(const ReadOptions& read_options, const LookupKey& k,
     }
     switch (get_context.State()) {
       case GetContext::kNotFound:
+        if (get_context.sample()) {
+          cfd_->internal_stats()->AddPointLookupMisses(fp.GetHitFileLevel(),
+                                                       kFileReadSampleRate);
+        }
         // Keep searching in other files
         break;
       case GetContext::kMerge:
@@ -5242,6 +5402,7 @@ void VersionSet::Reset() {
   current_version_number_ = 0;
   manifest_writers_.clear();
   manifest_file_size_ = 0;
+  manifest_snapshot_size_ = 0;
   obsolete_files_.clear();
   obsolete_manifests_.clear();
   wals_.Reset();
@@ -5469,8 +5630,7 @@ Status VersionSet::ProcessManifestWrites(
 #endif  // NDEBUG
 
   assert(pending_manifest_file_number_ == 0);
-  if (!descriptor_log_ ||
-      manifest_file_size_ > db_options_->max_manifest_file_size) {
+  if (!descriptor_log_ || ManifestNeedsRollover()) {
     TEST_SYNC_POINT("VersionSet::ProcessManifestWrites:BeforeNewManifest");
     new_descriptor_log = true;
   } else {
@@ -5505,6 +5665,7 @@ Status VersionSet::ProcessManifestWrites(
   }
 
   uint64_t new_manifest_file_size = 0;
+  uint64_t new_manifest_snapshot_size = 0;
   Status s;
   IOStatus io_s;
   IOStatus manifest_io_status;
@@ -5565,6 +5726,7 @@ Status VersionSet::ProcessManifestWrites(
         s = WriteCurrentStateToManifest(write_options, curr_state,
                                         wal_additions, raw_desc_log_ptr, io_s);
         assert(s == io_s);
+        new_manifest_snapshot_size = raw_desc_log_ptr->file()->GetFileSize();
       }
       if (!io_s.ok()) {
         manifest_io_status = io_s;
@@ -5756,6 +5918,9 @@ Status VersionSet::ProcessManifestWrites(
     descriptor_last_sequence_ = max_last_sequence;
     manifest_file_number_ = pending_manifest_file_number_;
     manifest_file_size_ = new_manifest_file_size;
+    if (new_descriptor_log) {
+      manifest_snapshot_size_ = new_manifest_snapshot_size;
+    }
     prev_log_number_ = first_writer.edit_list.front()->GetPrevLogNumber();
   } else {
     std::string version_edits;
@@ -6580,6 +6745,21 @@ void VersionSet::MarkMinLogNumberToKeep(uint64_t number) {
   }
 }
 
+bool VersionSet::ManifestNeedsRollover() const {
+  if (manifest_file_size_ <= db_options_->max_manifest_file_size) {
+    return false;
+  }
+  const int space_amp_pct = db_options_->max_manifest_space_amp_pct;
+  if (space_amp_pct <= 0 || manifest_snapshot_size_ == 0) {
+    return true;
+  }
+  // Roll over once the edits appended after the snapshot exceed
+  // space_amp_pct percent of it
+  const uint64_t tail_size = manifest_file_size_ - manifest_snapshot_size_;
+  return tail_size / static_cast<uint64_t>(space_amp_pct) >
+         manifest_snapshot_size_ / 100;
+}
+
 Status VersionSet::WriteCurrentStateToManifest(
     const WriteOptions& write_options,
     const std::unordered_map<uint32_t, MutableCFState>& curr_state,
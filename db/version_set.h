@@ -85,6 +85,7 @@ class MergeIteratorBuilder;
 class SystemClock;
 class ManifestTailer;
 class FilePickerMultiGet;
+struct TableBuilderOptions;
 
 // VersionEdit is always supposed to be valid and it is used to point at
 // entries in Manifest. Ideally it should not be used as a container to
@@ -999,6 +1000,15 @@ class Version {
                                       const autovector<UserKeyRange>& ranges,
                                       TablePropertiesCollection* props) const;
 
+  // Opens the table files of this version that are not pinned to their
+  // metadata, level by level and with up to `max_threads` threads, so that
+  // reads find their table readers in the table cache. Returns early once
+  // `stop` is set. A file that fails to open is left for the reads that need
+  // it to report.
+  // REQUIRES: this version is referenced and the DB mutex is not held
+  void OpenTableFiles(const ReadOptions& read_options, int max_threads,
+                      const std::atomic<bool>& stop);
+
   // Print summary of range delete tombstones in SST files into out_str,
   // with maximum max_entries_to_print entries printed out.
   Status TablesRangeTombstoneSummary(int max_entries_to_print,
@@ -1040,6 +1050,10 @@ class Version {
   // Prerequisite for this API is max_open_files = -1
   void GetCreationTimeOfOldestFile(uint64_t* creation_time);
 
+  // Sets the per-level statistics of `tboptions` that filter policies can
+  // use to size the filters of new SST files per level.
+  void SetFilterBuildingStats(TableBuilderOptions* tboptions) const;
+
   const MutableCFOptions& GetMutableCFOptions() { return mutable_cf_options_; }
 
   InternalIterator* TEST_GetLevelIterator(
@@ -1614,6 +1628,10 @@ class VersionSet {
         : log_number(_log_number), full_history_ts_low(std::move(ts_low)) {}
   };
 
+  // Whether the next manifest write should start a new manifest file, see
+  // DBOptions::max_manifest_file_size and max_manifest_space_amp_pct.
+  bool ManifestNeedsRollover() const;
+
   // Save current contents to *log
   Status WriteCurrentStateToManifest(
       const WriteOptions& write_options,
@@ -1681,6 +1699,10 @@ class VersionSet {
   // Current size of manifest file
   uint64_t manifest_file_size_;
 
+  // Size of the full state snapshot the current manifest file starts with,
+  // or 0 if it was not written by this VersionSet
+  uint64_t manifest_snapshot_size_ = 0;
+
   // Obsolete files, or during DB shutdown any files not referenced by what's
   // left of the in-memory LSM state.
   std::vector<ObsoleteFileInfo> obsolete_files_;
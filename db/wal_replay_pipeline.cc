@@ -0,0 +1,181 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "db/wal_replay_pipeline.h"
+
+#include "db/write_batch_internal.h"
+#include "util/mutexlock.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+WalRecordReadAhead::WalRecordReadAhead(log::Reader* reader,
+                                       WALRecoveryMode recovery_mode,
+                                       const Status* read_status,
+                                       size_t max_pending_records)
+    : reader_(reader),
+      recovery_mode_(recovery_mode),
+      read_status_(read_status),
+      max_pending_records_(max_pending_records),
+      cv_(&mutex_) {
+  assert(max_pending_records_ > 0);
+  thread_ = port::Thread([this] { ReadLoop(); });
+}
+
+WalRecordReadAhead::~WalRecordReadAhead() {
+  {
+    MutexLock l(&mutex_);
+    stop_ = true;
+    cv_.SignalAll();
+  }
+  thread_.join();
+}
+
+void WalRecordReadAhead::ReadLoop() {
+  std::string scratch;
+  Slice record;
+  uint64_t checksum = 0;
+  using TimestampSizes = UnorderedMap<uint32_t, size_t>;
+  std::shared_ptr<const TimestampSizes> ts_sz =
+      std::make_shared<const TimestampSizes>();
+  while (reader_->ReadRecord(&record, &scratch, recovery_mode_, &checksum)) {
+    if (read_status_ != nullptr && !read_status_->ok()) {
+      // A direct replay stops here without applying this record
+      break;
+    }
+    const TimestampSizes& recorded_ts_sz = reader_->GetRecordedTimestampSize();
+    if (*ts_sz != recorded_ts_sz) {
+      ts_sz = std::make_shared<const TimestampSizes>(recorded_ts_sz);
+    }
+    Record pending;
+    pending.contents.assign(record.data(), record.size());
+    pending.checksum = checksum;
+    pending.ts_sz = ts_sz;
+
+    MutexLock l(&mutex_);
+    while (pending_.size() >= max_pending_records_ && !stop_) {
+      cv_.Wait();
+    }
+    if (stop_) {
+      return;
+    }
+    pending_.push_back(std::move(pending));
+    cv_.SignalAll();
+  }
+  MutexLock l(&mutex_);
+  done_ = true;
+  cv_.SignalAll();
+}
+
+bool WalRecordReadAhead::Next(Record* record) {
+  MutexLock l(&mutex_);
+  while (pending_.empty() && !done_) {
+    cv_.Wait();
+  }
+  if (pending_.empty()) {
+    reached_end_ = true;
+    return false;
+  }
+  *record = std::move(pending_.front());
+  pending_.pop_front();
+  cv_.SignalAll();
+  return true;
+}
+
+ConcurrentWalBatchInserter::ConcurrentWalBatchInserter(
+    int num_threads, ColumnFamilyMemTablesImpl* column_family_memtables,
+    FlushScheduler* flush_scheduler,
+    TrimHistoryScheduler* trim_history_scheduler, DB* db,
+    size_t max_pending_batches)
+    : column_family_memtables_(column_family_memtables),
+      flush_scheduler_(flush_scheduler),
+      trim_history_scheduler_(trim_history_scheduler),
+      db_(db),
+      max_pending_batches_(max_pending_batches),
+      work_cv_(&mutex_),
+      idle_cv_(&mutex_) {
+  assert(num_threads > 0);
+  assert(max_pending_batches_ > 0);
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back([this] { InsertLoop(); });
+  }
+}
+
+ConcurrentWalBatchInserter::~ConcurrentWalBatchInserter() {
+  {
+    MutexLock l(&mutex_);
+    stop_ = true;
+    queue_.clear();
+    work_cv_.SignalAll();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+  first_error_.PermitUncheckedError();
+}
+
+void ConcurrentWalBatchInserter::Schedule(std::unique_ptr<WriteBatch> batch,
+                                          uint64_t log_number) {
+  MutexLock l(&mutex_);
+  while (num_pending_ >= max_pending_batches_) {
+    idle_cv_.Wait();
+  }
+  queue_.push_back(Task{std::move(batch), log_number});
+  ++num_pending_;
+  work_cv_.Signal();
+}
+
+Status ConcurrentWalBatchInserter::WaitForPending() {
+  MutexLock l(&mutex_);
+  while (num_pending_ > 0) {
+    idle_cv_.Wait();
+  }
+  Status s = std::move(first_error_);
+  first_error_ = Status::OK();
+  return s;
+}
+
+size_t ConcurrentWalBatchInserter::NumPending() {
+  MutexLock l(&mutex_);
+  return num_pending_;
+}
+
+void ConcurrentWalBatchInserter::InsertLoop() {
+  // Seek() on ColumnFamilyMemTablesImpl is not thread-safe, so each thread
+  // uses its own
+  ColumnFamilyMemTablesImpl column_family_memtables(column_family_memtables_);
+  MutexLock l(&mutex_);
+  while (true) {
+    while (queue_.empty() && !stop_) {
+      work_cv_.Wait();
+    }
+    if (stop_) {
+      return;
+    }
+    Task task = std::move(queue_.front());
+    queue_.pop_front();
+
+    mutex_.Unlock();
+    // Column families missing or already flushed past this WAL are skipped,
+    // as in a serial replay
+    Status s = WriteBatchInternal::InsertInto(
+        task.batch.get(), &column_family_memtables, flush_scheduler_,
+        trim_history_scheduler_, true /* ignore_missing_column_families */,
+        task.log_number, db_, true /* concurrent_memtable_writes */);
+    task.batch.reset();
+    mutex_.Lock();
+
+    if (!s.ok() && first_error_.ok()) {
+      first_error_ = std::move(s);
+    }
+    s.PermitUncheckedError();
+    assert(num_pending_ > 0);
+    --num_pending_;
+    idle_cv_.SignalAll();
+  }
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,131 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "db/column_family.h"
+#include "db/flush_scheduler.h"
+#include "db/log_reader.h"
+#include "db/trim_history_scheduler.h"
+#include "port/port.h"
+#include "rocksdb/options.h"
+#include "rocksdb/status.h"
+#include "rocksdb/write_batch.h"
+#include "util/hash_containers.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class DB;
+
+// Helpers for the pipelined WAL replay of DBImpl::RecoverLogFiles(), see
+// DBOptions::wal_recovery_threads.
+
+// Reads the records of one WAL with a log::Reader on a background thread,
+// ahead of the thread replaying them. Stops after the first record whose
+// read reported a corruption into `read_status`, so that the records handed
+// out are exactly those a replay calling ReadRecord() directly would accept.
+class WalRecordReadAhead {
+ public:
+  struct Record {
+    std::string contents;
+    uint64_t checksum = 0;
+    // Timestamp sizes recorded in the WAL as of this record
+    std::shared_ptr<const UnorderedMap<uint32_t, size_t>> ts_sz;
+  };
+
+  // `reader` must outlive this object. `read_status` is where the reader's
+  // reporter records corruptions, or nullptr if they are ignored.
+  WalRecordReadAhead(log::Reader* reader, WALRecoveryMode recovery_mode,
+                     const Status* read_status, size_t max_pending_records);
+
+  // Stops reading and waits for the background thread
+  ~WalRecordReadAhead();
+
+  // Moves the next record into `*record`. Returns false once the reader
+  // returned its last record and all of them were handed out.
+  bool Next(Record* record);
+
+  // Whether Next() returned false, i.e. the WAL was read up to where the
+  // reader stopped. Only then do the reader's status and reporter reflect
+  // what a direct replay would have seen.
+  bool ReachedEnd() const { return reached_end_; }
+
+ private:
+  void ReadLoop();
+
+  log::Reader* const reader_;
+  const WALRecoveryMode recovery_mode_;
+  const Status* const read_status_;
+  const size_t max_pending_records_;
+
+  port::Mutex mutex_;
+  port::CondVar cv_;
+  // Protected by mutex_
+  std::deque<Record> pending_;
+  bool done_ = false;
+  bool stop_ = false;
+
+  bool reached_end_ = false;
+  port::Thread thread_;
+};
+
+// Inserts write batches recovered from the WAL into the memtables on a pool
+// of threads, using concurrent memtable writes. Batches may be inserted in
+// any order relative to each other; each carries its own sequence numbers.
+class ConcurrentWalBatchInserter {
+ public:
+  ConcurrentWalBatchInserter(int num_threads,
+                             ColumnFamilyMemTablesImpl* column_family_memtables,
+                             FlushScheduler* flush_scheduler,
+                             TrimHistoryScheduler* trim_history_scheduler,
+                             DB* db, size_t max_pending_batches);
+
+  // Drops batches not yet inserted and waits for the threads
+  ~ConcurrentWalBatchInserter();
+
+  // Queues `batch`, read from WAL `log_number`, for insertion. Blocks while
+  // max_pending_batches are queued or being inserted.
+  void Schedule(std::unique_ptr<WriteBatch> batch, uint64_t log_number);
+
+  // Waits until every scheduled batch has been inserted. Returns the first
+  // insertion error since the previous call.
+  Status WaitForPending();
+
+  // Number of batches queued or being inserted
+  size_t NumPending();
+
+ private:
+  struct Task {
+    std::unique_ptr<WriteBatch> batch;
+    uint64_t log_number;
+  };
+
+  void InsertLoop();
+
+  ColumnFamilyMemTablesImpl* const column_family_memtables_;
+  FlushScheduler* const flush_scheduler_;
+  TrimHistoryScheduler* const trim_history_scheduler_;
+  DB* const db_;
+  const size_t max_pending_batches_;
+
+  port::Mutex mutex_;
+  port::CondVar work_cv_;
+  port::CondVar idle_cv_;
+  // Protected by mutex_
+  std::deque<Task> queue_;
+  size_t num_pending_ = 0;
+  Status first_error_;
+  bool stop_ = false;
+
+  std::vector<port::Thread> threads_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
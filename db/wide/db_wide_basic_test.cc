@@ -216,6 +216,103 @@ TEST_F(DBWideBasicTest, PutEntity) {
   verify();
 }
 
+TEST_F(DBWideBasicTest, WideColumnProjection) {
+  Options options = GetDefaultOptions();
+
+  constexpr char first_key[] = "first";
+  WideColumns first_columns{{kDefaultWideColumnName, "hello"},
+                            {"attr_name1", "foo"},
+                            {"attr_name2", "bar"},
+                            {"attr_name3", "baz"}};
+
+  constexpr char second_key[] = "second";
+  constexpr char second_value[] = "quux";
+
+  const std::vector<Slice> projection{"attr_name1", "attr_name3"};
+  const std::vector<Slice> projection_with_default{kDefaultWideColumnName,
+                                                   "attr_name2"};
+
+  auto verify = [&]() {
+    ReadOptions read_options;
+    read_options.wide_column_projection = &projection;
+
+    {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(read_options, db_->DefaultColumnFamily(),
+                               first_key, &result));
+      const WideColumns expected_columns{{"attr_name1", "foo"},
+                                         {"attr_name3", "baz"}};
+      ASSERT_EQ(result.columns(), expected_columns);
+
+      // Moving keeps the projection
+      PinnableWideColumns moved(std::move(result));
+      ASSERT_EQ(moved.columns(), expected_columns);
+    }
+
+    {
+      PinnableWideColumns result;
+      ASSERT_OK(db_->GetEntity(read_options, db_->DefaultColumnFamily(),
+                               second_key, &result));
+      ASSERT_TRUE(result.columns().empty());
+    }
+
+    {
+      constexpr size_t num_keys = 2;
+      std::array<Slice, num_keys> keys{{first_key, second_key}};
+      std::array<PinnableWideColumns, num_keys> results;
+      std::array<Status, num_keys> statuses;
+
+      ReadOptions multi_get_options;
+      multi_get_options.wide_column_projection = &projection_with_default;
+      db_->MultiGetEntity(multi_get_options, db_->DefaultColumnFamily(),
+                          num_keys, keys.data(), results.data(),
+                          statuses.data());
+      ASSERT_OK(statuses[0]);
+      const WideColumns expected_first{{kDefaultWideColumnName, "hello"},
+                                       {"attr_name2", "bar"}};
+      ASSERT_EQ(results[0].columns(), expected_first);
+      ASSERT_OK(statuses[1]);
+      const WideColumns expected_second{{kDefaultWideColumnName, second_value}};
+      ASSERT_EQ(results[1].columns(), expected_second);
+    }
+
+    {
+      std::unique_ptr<Iterator> iter(db_->NewIterator(read_options));
+
+      iter->SeekToFirst();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->key(), first_key);
+      const WideColumns expected_columns{{"attr_name1", "foo"},
+                                         {"attr_name3", "baz"}};
+      ASSERT_EQ(iter->columns(), expected_columns);
+      // The default column is not part of the projection
+      ASSERT_TRUE(iter->value().empty());
+
+      iter->Next();
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(iter->key(), second_key);
+      ASSERT_EQ(iter->value(), second_value);
+      ASSERT_TRUE(iter->columns().empty());
+
+      iter->Next();
+      ASSERT_FALSE(iter->Valid());
+      ASSERT_OK(iter->status());
+    }
+  };
+
+  ASSERT_OK(db_->PutEntity(WriteOptions(), db_->DefaultColumnFamily(),
+                           first_key, first_columns));
+  ASSERT_OK(db_->Put(WriteOptions(), db_->DefaultColumnFamily(), second_key,
+                     second_value));
+
+  // Memtable
+  verify();
+
+  // SST file
+  ASSERT_OK(Flush());
+  verify();
+}
+
 TEST_F(DBWideBasicTest, PutEntityColumnFamily) {
   Options options = GetDefaultOptions();
   CreateAndReopenWithCF({"corinthian"}, options);
@@ -129,6 +129,93 @@ Status WideColumnSerialization::Deserialize(Slice& input,
   return Status::OK();
 }
 
+Status WideColumnSerialization::DeserializeColumns(
+    Slice& input, const std::vector<Slice>& column_names,
+    WideColumns& columns) {
+  assert(columns.empty());
+  assert(std::is_sorted(column_names.begin(), column_names.end(),
+                        [](const Slice& lhs, const Slice& rhs) {
+                          return lhs.compare(rhs) < 0;
+                        }));
+
+  uint32_t version = 0;
+  if (!GetVarint32(&input, &version)) {
+    return Status::Corruption("Error decoding wide column version");
+  }
+
+  if (version > kCurrentVersion) {
+    return Status::NotSupported("Unsupported wide column version");
+  }
+
+  uint32_t num_columns = 0;
+  if (!GetVarint32(&input, &num_columns)) {
+    return Status::Corruption("Error decoding number of wide columns");
+  }
+
+  if (!num_columns || column_names.empty()) {
+    return Status::OK();
+  }
+
+  columns.reserve(std::min(static_cast<size_t>(num_columns),
+                           column_names.size()));
+
+  // Offsets of the values of the selected columns
+  autovector<uint64_t, 16> column_value_offsets;
+  Slice prev_name;
+  size_t next_selected = 0;
+  uint64_t pos = 0;
+
+  for (uint32_t i = 0; i < num_columns; ++i) {
+    Slice name;
+    if (!GetLengthPrefixedSlice(&input, &name)) {
+      return Status::Corruption("Error decoding wide column name");
+    }
+
+    if (i > 0 && prev_name.compare(name) >= 0) {
+      return Status::Corruption("Wide columns out of order");
+    }
+    prev_name = name;
+
+    uint32_t value_size = 0;
+    if (!GetVarint32(&input, &value_size)) {
+      return Status::Corruption("Error decoding wide column value size");
+    }
+
+    while (next_selected < column_names.size() &&
+           column_names[next_selected].compare(name) < 0) {
+      ++next_selected;
+    }
+    if (next_selected < column_names.size() &&
+        column_names[next_selected] == name) {
+      columns.emplace_back(name, Slice(nullptr, value_size));
+      column_value_offsets.emplace_back(pos);
+      ++next_selected;
+    }
+
+    pos += value_size;
+  }
+
+  if (pos > input.size()) {
+    return Status::Corruption("Error decoding wide column value payload");
+  }
+
+  for (size_t i = 0; i < columns.size(); ++i) {
+    Slice& value = columns[i].value();
+    value = Slice(input.data() + column_value_offsets[i], value.size());
+  }
+
+  return Status::OK();
+}
+
+bool WideColumnSerialization::IsProjected(
+    const std::vector<Slice>& column_names, const Slice& column_name) {
+  return std::binary_search(column_names.begin(), column_names.end(),
+                            column_name,
+                            [](const Slice& lhs, const Slice& rhs) {
+                              return lhs.compare(rhs) < 0;
+                            });
+}
+
 WideColumns::const_iterator WideColumnSerialization::Find(
     const WideColumns& columns, const Slice& column_name) {
   const auto it =
@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "rocksdb/rocksdb_namespace.h"
 #include "rocksdb/status.h"
@@ -47,6 +48,17 @@ class WideColumnSerialization {
 
   static Status Deserialize(Slice& input, WideColumns& columns);
 
+  // Like Deserialize(), but only returns the columns named in `column_names`,
+  // which must be sorted in bytewise order. Only the index is parsed for the
+  // other columns.
+  static Status DeserializeColumns(Slice& input,
+                                   const std::vector<Slice>& column_names,
+                                   WideColumns& columns);
+
+  // Whether `column_name` is one of the sorted `column_names`
+  static bool IsProjected(const std::vector<Slice>& column_names,
+                          const Slice& column_name);
+
   static WideColumns::const_iterator Find(const WideColumns& columns,
                                           const Slice& column_name);
   static Status GetValueOfDefaultColumn(Slice& input, Slice& value);
@@ -124,6 +124,54 @@ TEST(WideColumnSerializationTest, SerializeDeserialize) {
   }
 }
 
+TEST(WideColumnSerializationTest, DeserializeProjection) {
+  WideColumns columns{{kDefaultWideColumnName, "baz"},
+                      {"foo", "bar"},
+                      {"hello", "world"},
+                      {"snafu", "fubar"}};
+  std::string output;
+
+  ASSERT_OK(WideColumnSerialization::Serialize(columns, output));
+
+  {
+    Slice input(output);
+    WideColumns deserialized_columns;
+    const std::vector<Slice> column_names{"fubar", "hello", "snafu", "zzz"};
+
+    ASSERT_OK(WideColumnSerialization::DeserializeColumns(
+        input, column_names, deserialized_columns));
+    const WideColumns expected_columns{{"hello", "world"}, {"snafu", "fubar"}};
+    ASSERT_EQ(deserialized_columns, expected_columns);
+    ASSERT_FALSE(WideColumnSerialization::IsProjected(column_names,
+                                                      kDefaultWideColumnName));
+    ASSERT_TRUE(WideColumnSerialization::IsProjected(column_names, "hello"));
+  }
+
+  {
+    Slice input(output);
+    WideColumns deserialized_columns;
+    const std::vector<Slice> column_names{kDefaultWideColumnName, "foo"};
+
+    ASSERT_OK(WideColumnSerialization::DeserializeColumns(
+        input, column_names, deserialized_columns));
+    const WideColumns expected_columns{{kDefaultWideColumnName, "baz"},
+                                       {"foo", "bar"}};
+    ASSERT_EQ(deserialized_columns, expected_columns);
+  }
+
+  {
+    // Truncated values are detected even if they are not selected
+    Slice input(output.data(), output.size() - 1);
+    WideColumns deserialized_columns;
+    const std::vector<Slice> column_names{"foo"};
+
+    const Status s = WideColumnSerialization::DeserializeColumns(
+        input, column_names, deserialized_columns);
+    ASSERT_TRUE(s.IsCorruption());
+    ASSERT_TRUE(std::strstr(s.getState(), "payload"));
+  }
+}
+
 TEST(WideColumnSerializationTest, SerializeDuplicateError) {
   WideColumns columns{{"foo", "bar"}, {"foo", "baz"}};
   std::string output;
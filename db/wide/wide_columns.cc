@@ -12,10 +12,24 @@ const Slice kDefaultWideColumnName;
 
 const WideColumns kNoWideColumns;
 
+void PinnableWideColumns::CreateIndexForPlainValue() {
+  if (projection_ != nullptr &&
+      !WideColumnSerialization::IsProjected(*projection_,
+                                            kDefaultWideColumnName)) {
+    columns_.clear();
+    return;
+  }
+  columns_ = WideColumns{{kDefaultWideColumnName, value_}};
+}
+
 Status PinnableWideColumns::CreateIndexForWideColumns() {
   columns_.clear();
 
   Slice value_copy = value_;
+  if (projection_ != nullptr) {
+    return WideColumnSerialization::DeserializeColumns(value_copy,
+                                                       *projection_, columns_);
+  }
   return WideColumnSerialization::Deserialize(value_copy, columns_);
 }
 
@@ -140,6 +140,10 @@ class WriteThread {
     std::atomic<uint8_t> state;  // write under StateMutex() or pre-link
     WriteGroup* write_group;
     SequenceNumber sequence;  // the sequence number to use for the first key
+    // crc32c checksum of the part of `batch` written to the WAL, excluding its
+    // header, if computed by the writer (see DBOptions::parallel_wal_checksum)
+    bool has_wal_payload_crc;
+    uint32_t wal_payload_crc;
     Status status;
     Status callback_status;  // status returned by callback->Callback()
 
@@ -167,6 +171,8 @@ class WriteThread {
           state(STATE_INIT),
           write_group(nullptr),
           sequence(kMaxSequenceNumber),
+          has_wal_payload_crc(false),
+          wal_payload_crc(0),
           link_older(nullptr),
           link_newer(nullptr) {}
 
@@ -195,6 +201,8 @@ class WriteThread {
           state(STATE_INIT),
           write_group(nullptr),
           sequence(kMaxSequenceNumber),
+          has_wal_payload_crc(false),
+          wal_payload_crc(0),
           link_older(nullptr),
           link_newer(nullptr) {}
 
@@ -939,6 +939,11 @@ static const bool FLAGS_log2_keys_per_lock_dummy __attribute__((__unused__)) =
 
 DEFINE_uint64(max_manifest_file_size, 16384, "Maximum size of a MANIFEST file");
 
+DEFINE_int32(max_manifest_space_amp_pct,
+             ROCKSDB_NAMESPACE::Options().max_manifest_space_amp_pct,
+             "Roll over the MANIFEST once it is this percentage larger than "
+             "its initial snapshot (0 = disabled)");
+
 DEFINE_bool(in_place_update, false, "On true, does inplace update in memtable");
 
 DEFINE_string(memtablerep, "skip_list", "");
@@ -2703,6 +2703,10 @@ void StressTest::TestGetProperty(ThreadState* thread) const {
     unknownPropertyNames.insert(blobCachePropertyNames.begin(),
                                 blobCachePropertyNames.end());
   }
+  if (db_->GetOptions().row_cache == nullptr ||
+      db_->GetOptions().row_cache_admission_threshold == 0) {
+    unknownPropertyNames.insert(DB::Properties::kRowCacheHotKeys);
+  }
 
   std::string prop;
   for (const auto& ppt_name_and_info : InternalStats::ppt_name_to_info) {
@@ -4132,6 +4136,7 @@ void InitializeOptionsFromFlags(
     options.compression_opts.checksum = true;
   }
   options.max_manifest_file_size = FLAGS_max_manifest_file_size;
+  options.max_manifest_space_amp_pct = FLAGS_max_manifest_space_amp_pct;
   options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
   options.allow_concurrent_memtable_write =
       FLAGS_allow_concurrent_memtable_write;
@@ -1732,8 +1732,86 @@ TEST_F(EnvPosixTest, MultiReadIOUringError2) {
   SyncPoint::GetInstance()->DisableProcessing();
   SyncPoint::GetInstance()->ClearAllCallBacks();
 }
+
+TEST_F(EnvPosixTest, AsyncWriteSubmitError) {
+  FileOptions file_opts;
+  file_opts.use_async_writes = true;
+  std::string fname = test::PerThreadDBPath(env_, "async_write_error");
+  const auto& fs = env_->GetFileSystem();
+  std::unique_ptr<FSWritableFile> file;
+  ASSERT_OK(fs->NewWritableFile(fname, file_opts, &file, nullptr));
+  ASSERT_OK(file->Append("foo", IOOptions(), nullptr));
+
+  bool submit_called = false;
+  SyncPoint::GetInstance()->SetCallBack(
+      "PosixWritableFile::SubmitAsyncWrite:submit", [&](void* arg) {
+        submit_called = true;
+        *static_cast<int*>(arg) = -EBUSY;
+      });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  IOStatus s = file->Append("bar", IOOptions(), nullptr);
+  if (submit_called) {
+    ASSERT_NOK(s);
+    // The failure sticks to the file.
+    ASSERT_NOK(file->Sync(IOOptions(), nullptr));
+    file->Close(IOOptions(), nullptr).PermitUncheckedError();
+  } else {
+    s.PermitUncheckedError();
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+}
 #endif  // ROCKSDB_IOURING_PRESENT
 
+TEST_F(EnvPosixTest, AsyncWrites) {
+  FileOptions file_opts;
+  file_opts.use_async_writes = true;
+  std::string fname = test::PerThreadDBPath(env_, "async_writes");
+  const auto& fs = env_->GetFileSystem();
+  Random rnd(301);
+  std::string expected;
+  {
+    std::unique_ptr<FSWritableFile> file;
+    ASSERT_OK(fs->NewWritableFile(fname, file_opts, &file, nullptr));
+    // Enough appends to fill the queue of in-flight writes several times,
+    // mixed with flushes and syncs.
+    for (int i = 0; i < 200; i++) {
+      std::string data = rnd.RandomString(static_cast<int>(rnd.Uniform(8192)));
+      ASSERT_OK(file->Append(data, IOOptions(), nullptr));
+      expected += data;
+      ASSERT_EQ(expected.size(), file->GetFileSize(IOOptions(), nullptr));
+      if (i % 7 == 0) {
+        ASSERT_OK(file->Flush(IOOptions(), nullptr));
+      }
+      if (i % 31 == 0) {
+        ASSERT_OK(file->Sync(IOOptions(), nullptr));
+      } else if (i % 47 == 0) {
+        ASSERT_OK(file->Fsync(IOOptions(), nullptr));
+      }
+    }
+    // Appends that are still in flight are completed by Close().
+    ASSERT_OK(file->Close(IOOptions(), nullptr));
+  }
+  std::string actual;
+  ASSERT_OK(ReadFileToString(env_, fname, &actual));
+  ASSERT_EQ(expected, actual);
+
+  // Reopening for append falls back to synchronous writes.
+  {
+    std::unique_ptr<FSWritableFile> file;
+    ASSERT_OK(fs->ReopenWritableFile(fname, file_opts, &file, nullptr));
+    ASSERT_OK(file->Append("tail", IOOptions(), nullptr));
+    expected += "tail";
+    ASSERT_OK(file->Sync(IOOptions(), nullptr));
+    ASSERT_OK(file->Close(IOOptions(), nullptr));
+  }
+  ASSERT_OK(ReadFileToString(env_, fname, &actual));
+  ASSERT_EQ(expected, actual);
+  ASSERT_OK(env_->DeleteFile(fname));
+}
+
 // Only works in linux platforms
 #ifdef OS_WIN
 TEST_P(EnvPosixTestWithParam, DISABLED_InvalidateCache) {
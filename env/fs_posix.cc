@@ -279,7 +279,18 @@ class PosixFileSystem : public FileSystem {
   virtual IOStatus OpenWritableFile(const std::string& fname,
                                     const FileOptions& options, bool reopen,
                                     std::unique_ptr<FSWritableFile>* result,
-                                    IODebugContext* /*dbg*/) {
+                                    IODebugContext* dbg) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+    // Asynchronous appends write at explicit offsets, which O_APPEND would
+    // override.
+    if (options.use_async_writes && (reopen || !IsIOUringEnabled())) {
+      FileOptions sync_options = options;
+      sync_options.use_async_writes = false;
+      return OpenWritableFile(fname, sync_options, reopen, result, dbg);
+    }
+#else
+    (void)dbg;
+#endif  // ROCKSDB_IOURING_PRESENT
     result->reset();
     IOStatus s;
     int fd = -1;
@@ -373,7 +384,16 @@ class PosixFileSystem : public FileSystem {
                              const std::string& old_fname,
                              const FileOptions& options,
                              std::unique_ptr<FSWritableFile>* result,
-                             IODebugContext* /*dbg*/) override {
+                             IODebugContext* dbg) override {
+#if defined(ROCKSDB_IOURING_PRESENT)
+    if (options.use_async_writes && !IsIOUringEnabled()) {
+      FileOptions sync_options = options;
+      sync_options.use_async_writes = false;
+      return ReuseWritableFile(fname, old_fname, sync_options, result, dbg);
+    }
+#else
+    (void)dbg;
+#endif  // ROCKSDB_IOURING_PRESENT
     result->reset();
     IOStatus s;
     int fd = -1;
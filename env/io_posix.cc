@@ -1286,6 +1286,14 @@ PosixWritableFile::PosixWritableFile(const std::string& fname, int fd,
 #ifdef ROCKSDB_RANGESYNC_PRESENT
   sync_file_range_supported_ = IsSyncFileRangeSupported(fd_);
 #endif  // ROCKSDB_RANGESYNC_PRESENT
+#if defined(ROCKSDB_IOURING_PRESENT)
+  pending_async_writes_ = 0;
+  // Direct writes would need aligned copies of the appended data, they stay
+  // synchronous. Also fall back to synchronous writes if the ring can't be
+  // set up.
+  write_iu_ = (options.use_async_writes && !use_direct_io_) ? CreateIOUring()
+                                                           : nullptr;
+#endif  // ROCKSDB_IOURING_PRESENT
   assert(!options.use_mmap_writes);
 }
 
@@ -1302,6 +1310,11 @@ IOStatus PosixWritableFile::Append(const Slice& data, const IOOptions& /*opts*/,
     assert(IsSectorAligned(data.size(), GetRequiredBufferAlignment()));
     assert(IsSectorAligned(data.data(), GetRequiredBufferAlignment()));
   }
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    return SubmitAsyncWrite(data);
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
   const char* src = data.data();
   size_t nbytes = data.size();
 
@@ -1322,6 +1335,14 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
     assert(IsSectorAligned(data.data(), GetRequiredBufferAlignment()));
   }
   assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    IOStatus s = ReapAsyncWrites(0);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
   const char* src = data.data();
   size_t nbytes = data.size();
   if (!PosixPositionedWrite(fd_, src, nbytes, static_cast<off_t>(offset))) {
@@ -1335,6 +1356,14 @@ IOStatus PosixWritableFile::PositionedAppend(const Slice& data, uint64_t offset,
 IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
                                      IODebugContext* /*dbg*/) {
   IOStatus s;
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    s = ReapAsyncWrites(0);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
   int r = ftruncate(fd_, size);
   if (r < 0) {
     s = IOError("While ftruncate file to size " + std::to_string(size),
@@ -1348,6 +1377,14 @@ IOStatus PosixWritableFile::Truncate(uint64_t size, const IOOptions& /*opts*/,
 IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
   IOStatus s;
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    s = ReapAsyncWrites(0);
+    io_uring_queue_exit(write_iu_);
+    delete write_iu_;
+    write_iu_ = nullptr;
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
 
   size_t block_size;
   size_t last_allocated_block;
@@ -1388,7 +1425,7 @@ IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
 #endif
   }
 
-  if (close(fd_) < 0) {
+  if (close(fd_) < 0 && s.ok()) {
     s = IOError("While closing file after writing", filename_, errno);
   }
   fd_ = -1;
@@ -1398,11 +1435,23 @@ IOStatus PosixWritableFile::Close(const IOOptions& /*opts*/,
 // write out the cached data to the OS cache
 IOStatus PosixWritableFile::Flush(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    // Only collect the writes that have already completed, waiting for the
+    // rest is left to Sync().
+    return ReapAsyncWrites(kMaxPendingAsyncWrites);
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
   return IOStatus::OK();
 }
 
 IOStatus PosixWritableFile::Sync(const IOOptions& /*opts*/,
                                  IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    return SubmitAsyncSync(true /* datasync */);
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
 #ifdef HAVE_FULLFSYNC
   if (::fcntl(fd_, F_FULLFSYNC) < 0) {
     return IOError("while fcntl(F_FULLFSYNC)", filename_, errno);
@@ -1417,6 +1466,11 @@ IOStatus PosixWritableFile::Sync(const IOOptions& /*opts*/,
 
 IOStatus PosixWritableFile::Fsync(const IOOptions& /*opts*/,
                                   IODebugContext* /*dbg*/) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    return SubmitAsyncSync(false /* datasync */);
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
 #ifdef HAVE_FULLFSYNC
   if (::fcntl(fd_, F_FULLFSYNC) < 0) {
     return IOError("while fcntl(F_FULLFSYNC)", filename_, errno);
@@ -1429,7 +1483,16 @@ IOStatus PosixWritableFile::Fsync(const IOOptions& /*opts*/,
   return IOStatus::OK();
 }
 
-bool PosixWritableFile::IsSyncThreadSafe() const { return true; }
+bool PosixWritableFile::IsSyncThreadSafe() const {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // The ring and the in-flight requests are not protected against a Sync()
+  // racing with Append().
+  if (write_iu_ != nullptr) {
+    return false;
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
+  return true;
+}
 
 uint64_t PosixWritableFile::GetFileSize(const IOOptions& /*opts*/,
                                         IODebugContext* /*dbg*/) {
@@ -1501,6 +1564,15 @@ IOStatus PosixWritableFile::Allocate(uint64_t offset, uint64_t len,
 IOStatus PosixWritableFile::RangeSync(uint64_t offset, uint64_t nbytes,
                                       const IOOptions& opts,
                                       IODebugContext* dbg) {
+#if defined(ROCKSDB_IOURING_PRESENT)
+  if (write_iu_ != nullptr) {
+    // The range may not have been written yet.
+    IOStatus s = ReapAsyncWrites(0);
+    if (!s.ok()) {
+      return s;
+    }
+  }
+#endif  // ROCKSDB_IOURING_PRESENT
 #ifdef ROCKSDB_RANGESYNC_PRESENT
   assert(offset <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
   assert(nbytes <= static_cast<uint64_t>(std::numeric_limits<off_t>::max()));
@@ -1533,6 +1605,121 @@ size_t PosixWritableFile::GetUniqueId(char* id, size_t max_size) const {
 }
 #endif
 
+#if defined(ROCKSDB_IOURING_PRESENT)
+namespace {
+// An asynchronous append. It owns a copy of the data because the caller may
+// reuse its buffer as soon as Append() returns.
+struct AsyncWriteRequest {
+  std::string data;
+  uint64_t offset;
+};
+}  // namespace
+
+IOStatus PosixWritableFile::SubmitAsyncWrite(const Slice& data) {
+  // Make room for the new request, and surface earlier failures.
+  IOStatus s = ReapAsyncWrites(kMaxPendingAsyncWrites - 1);
+  if (!s.ok()) {
+    return s;
+  }
+  assert(data.size() <= std::numeric_limits<unsigned int>::max());
+  auto req = new AsyncWriteRequest{data.ToString(), filesize_};
+  // Every SQE is submitted right away and at most kMaxPendingAsyncWrites are
+  // in flight, so there is always a free one.
+  struct io_uring_sqe* sqe = io_uring_get_sqe(write_iu_);
+  assert(sqe != nullptr);
+  io_uring_prep_write(sqe, fd_, req->data.data(),
+                      static_cast<unsigned int>(req->data.size()),
+                      req->offset);
+  io_uring_sqe_set_data(sqe, req);
+  int ret = io_uring_submit(write_iu_);
+  TEST_SYNC_POINT_CALLBACK("PosixWritableFile::SubmitAsyncWrite:submit", &ret);
+  if (ret != 1) {
+    delete req;
+    // The request may still be queued, make sure nothing gets submitted
+    // anymore by failing all later writes.
+    async_write_status_ = IOStatus::IOError(
+        "io_uring_submit() requested 1 but returned " + std::to_string(ret));
+    return async_write_status_;
+  }
+  pending_async_writes_++;
+  filesize_ += data.size();
+  return IOStatus::OK();
+}
+
+IOStatus PosixWritableFile::SubmitAsyncSync(bool datasync) {
+  IOStatus s = ReapAsyncWrites(kMaxPendingAsyncWrites - 1);
+  if (!s.ok()) {
+    return s;
+  }
+  // IOSQE_IO_DRAIN holds the sync back until all writes submitted before it
+  // have completed, so the caller waits for a single round trip instead of
+  // one for the writes and another one for the sync.
+  struct io_uring_sqe* sqe = io_uring_get_sqe(write_iu_);
+  assert(sqe != nullptr);
+  io_uring_prep_fsync(sqe, fd_, datasync ? IORING_FSYNC_DATASYNC : 0);
+  io_uring_sqe_set_flags(sqe, IOSQE_IO_DRAIN);
+  io_uring_sqe_set_data(sqe, nullptr);
+  int ret = io_uring_submit(write_iu_);
+  if (ret != 1) {
+    async_write_status_ = IOStatus::IOError(
+        "io_uring_submit() requested 1 but returned " + std::to_string(ret));
+    return async_write_status_;
+  }
+  pending_async_writes_++;
+  return ReapAsyncWrites(0);
+}
+
+IOStatus PosixWritableFile::ReapAsyncWrites(size_t max_pending) {
+  while (pending_async_writes_ > 0) {
+    struct io_uring_cqe* cqe = nullptr;
+    int ret;
+    if (pending_async_writes_ > max_pending) {
+      ret = io_uring_wait_cqe(write_iu_, &cqe);
+    } else {
+      ret = io_uring_peek_cqe(write_iu_, &cqe);
+      if (ret == -EAGAIN) {
+        break;
+      }
+    }
+    if (ret == -EINTR) {
+      continue;
+    }
+    if (ret < 0) {
+      // Requests whose completions can't be reaped keep referencing their
+      // buffers, leak them rather than risking a use after free.
+      async_write_status_ = IOStatus::IOError(
+          "io_uring_wait_cqe() returns " + std::to_string(ret));
+      pending_async_writes_ = 0;
+      break;
+    }
+    auto req = static_cast<AsyncWriteRequest*>(io_uring_cqe_get_data(cqe));
+    int res = cqe->res;
+    io_uring_cqe_seen(write_iu_, cqe);
+    pending_async_writes_--;
+    if (!async_write_status_.ok()) {
+      // Keep the first failure.
+    } else if (req == nullptr) {
+      if (res < 0) {
+        async_write_status_ = IOError("While syncing file", filename_, -res);
+      }
+    } else if (res < 0) {
+      async_write_status_ =
+          IOError("While appending to file", filename_, -res);
+    } else if (static_cast<size_t>(res) < req->data.size()) {
+      // Short write, finish it synchronously.
+      if (!PosixPositionedWrite(fd_, req->data.data() + res,
+                                req->data.size() - res,
+                                static_cast<off_t>(req->offset + res))) {
+        async_write_status_ =
+            IOError("While appending to file", filename_, errno);
+      }
+    }
+    delete req;
+  }
+  return async_write_status_;
+}
+#endif  // ROCKSDB_IOURING_PRESENT
+
 /*
  * PosixRandomRWFile
  */
@@ -341,6 +341,24 @@ class PosixWritableFile : public FSWritableFile {
   // support it, so we need to do a dynamic check too.
   bool sync_file_range_supported_;
 #endif  // ROCKSDB_RANGESYNC_PRESENT
+#if defined(ROCKSDB_IOURING_PRESENT)
+  // Maximum number of asynchronous requests in flight for one file. Bounds
+  // the memory held by copies of appended data.
+  static constexpr size_t kMaxPendingAsyncWrites = 16;
+  // Non-null if appends and syncs are submitted through io_uring (see
+  // EnvOptions::use_async_writes).
+  struct io_uring* write_iu_;
+  // Number of submitted requests whose completions haven't been reaped.
+  size_t pending_async_writes_;
+  // First failure of an asynchronous request. Once set, it is returned by all
+  // later writes and syncs.
+  IOStatus async_write_status_;
+
+  IOStatus SubmitAsyncWrite(const Slice& data);
+  IOStatus SubmitAsyncSync(bool datasync);
+  // Reaps completions until at most `max_pending` requests are in flight.
+  IOStatus ReapAsyncWrites(size_t max_pending);
+#endif  // ROCKSDB_IOURING_PRESENT
 
  public:
   explicit PosixWritableFile(const std::string& fname, int fd,
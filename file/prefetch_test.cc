@@ -1897,6 +1897,188 @@ TEST_P(PrefetchTest, DBIterAsyncIONoIOUring) {
   enable_io_uring = true;
 }
 
+// This test verifies that with async_io, a forward scan starts reading the
+// first data block of the next file in the level while it is still in the last
+// data block of the current file.
+TEST_P(PrefetchTest, DBIterPrefetchNextFileAsyncIO) {
+  if (mem_env_ || encrypted_env_) {
+    ROCKSDB_GTEST_SKIP("Test requires non-mem or non-encrypted environment");
+    return;
+  }
+
+  const int kNumKeys = 1000;
+  // Set options
+  bool use_direct_io = std::get<0>(GetParam());
+  bool is_adaptive_readahead = std::get<1>(GetParam());
+
+  Options options;
+  SetGenericOptions(Env::Default(), use_direct_io, options);
+  options.target_file_size_base = 1 << 20;
+  BlockBasedTableOptions table_options;
+  SetBlockBasedTableOptions(table_options);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  Status s = TryReopen(options);
+  if (use_direct_io && (s.IsNotSupported() || s.IsInvalidArgument())) {
+    // If direct IO is not supported, skip the test
+    return;
+  } else {
+    ASSERT_OK(s);
+  }
+
+  WriteBatch batch;
+  Random rnd(309);
+  int total_keys = 0;
+  for (int j = 0; j < 5; j++) {
+    for (int i = j * kNumKeys; i < (j + 1) * kNumKeys; i++) {
+      ASSERT_OK(batch.Put(BuildKey(i), rnd.RandomString(1000)));
+      total_keys++;
+    }
+    ASSERT_OK(db_->Write(WriteOptions(), &batch));
+    ASSERT_OK(Flush());
+  }
+  MoveFilesToLevel(2);
+  const int num_files = NumTableFilesAtLevel(2);
+  ASSERT_GT(num_files, 1);
+
+  // Iterators drop async_io when the file system does not support it
+  const bool async_io_supported = CheckFSFeatureSupport(
+      options.env->GetFileSystem().get(), FSSupportedOps::kAsyncIO);
+  int num_prefetched_files = 0;
+  SyncPoint::GetInstance()->SetCallBack(
+      "LevelIterator::MaybePrefetchNextFile",
+      [&](void*) { num_prefetched_files++; });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  for (bool async_io : {false, true}) {
+    ReadOptions ro;
+    ro.adaptive_readahead = is_adaptive_readahead;
+    ro.async_io = async_io;
+    num_prefetched_files = 0;
+
+    auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ro));
+    int num_keys = 0;
+    std::string prev_key;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ASSERT_OK(iter->status());
+      ASSERT_LT(prev_key, iter->key().ToString());
+      prev_key = iter->key().ToString();
+      num_keys++;
+    }
+    ASSERT_OK(iter->status());
+    ASSERT_EQ(num_keys, total_keys);
+    ASSERT_EQ(num_prefetched_files,
+              async_io && async_io_supported ? num_files - 1 : 0);
+
+    // Seeking back drops the iterator of the next file
+    iter->Seek(BuildKey(0));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), BuildKey(0));
+  }
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+  Close();
+}
+
+TEST_P(PrefetchTest, PrepareSeekAsyncIO) {
+  if (mem_env_ || encrypted_env_) {
+    ROCKSDB_GTEST_SKIP("Test requires non-mem or non-encrypted environment");
+    return;
+  }
+
+  const int kNumKeys = 1000;
+  bool use_direct_io = std::get<0>(GetParam());
+  bool is_adaptive_readahead = std::get<1>(GetParam());
+
+  Options options;
+  SetGenericOptions(Env::Default(), use_direct_io, options);
+  options.target_file_size_base = 1 << 20;
+  BlockBasedTableOptions table_options;
+  SetBlockBasedTableOptions(table_options);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  Status s = TryReopen(options);
+  if (use_direct_io && (s.IsNotSupported() || s.IsInvalidArgument())) {
+    // If direct IO is not supported, skip the test
+    return;
+  } else {
+    ASSERT_OK(s);
+  }
+
+  // One L0 file on top of several L2 files, so that seeks go through both
+  // table iterators and a LevelIterator
+  WriteBatch batch;
+  Random rnd(309);
+  for (int j = 0; j < 3; j++) {
+    for (int i = j * kNumKeys; i < (j + 1) * kNumKeys; i++) {
+      ASSERT_OK(batch.Put(BuildKey(i), rnd.RandomString(1000)));
+    }
+    ASSERT_OK(db_->Write(WriteOptions(), &batch));
+    ASSERT_OK(Flush());
+  }
+  MoveFilesToLevel(2);
+  for (int i = 0; i < kNumKeys; i += 2) {
+    ASSERT_OK(Put(BuildKey(i, "_l0"), rnd.RandomString(100)));
+  }
+  ASSERT_OK(Flush());
+
+  for (bool async_io : {false, true}) {
+    ReadOptions ro;
+    ro.adaptive_readahead = is_adaptive_readahead;
+    ro.async_io = async_io;
+
+    // Prepare many scans before completing any of them
+    const int kNumScans = 16;
+    std::vector<std::unique_ptr<Iterator>> iters;
+    std::vector<std::string> targets;
+    for (int i = 0; i < kNumScans; i++) {
+      iters.emplace_back(db_->NewIterator(ro));
+      targets.push_back(BuildKey((i * 397) % (3 * kNumKeys)));
+      iters.back()->PrepareSeek(targets.back());
+      ASSERT_FALSE(iters.back()->Valid());
+    }
+    for (int i = 0; i < kNumScans; i++) {
+      iters[i]->Seek(targets[i]);
+      ASSERT_TRUE(iters[i]->Valid());
+      ASSERT_EQ(iters[i]->key(), targets[i]);
+      std::string prev_key = iters[i]->key().ToString();
+      for (int j = 0; j < 10 && iters[i]->Valid(); j++) {
+        iters[i]->Next();
+        if (iters[i]->Valid()) {
+          ASSERT_LT(prev_key, iters[i]->key().ToString());
+          prev_key = iters[i]->key().ToString();
+        }
+      }
+      ASSERT_OK(iters[i]->status());
+    }
+
+    // Repositioning elsewhere after PrepareSeek() is still correct
+    auto iter = std::unique_ptr<Iterator>(db_->NewIterator(ro));
+    iter->PrepareSeek(BuildKey(100));
+    iter->Seek(BuildKey(2000));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), BuildKey(2000));
+
+    iter->PrepareSeek(BuildKey(100));
+    iter->SeekToFirst();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), BuildKey(0));
+
+    iter->PrepareSeek(BuildKey(100));
+    iter->SeekForPrev(BuildKey(1500));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), BuildKey(1500));
+
+    iter->PrepareSeek(BuildKey(100));
+    iter->SeekToLast();
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key(), BuildKey(999));
+    ASSERT_OK(iter->status());
+  }
+  Close();
+}
+
 class PrefetchTest1 : public DBTestBase,
                       public ::testing::WithParamInterface<bool> {
  public:
@@ -3014,6 +3014,22 @@ extern ROCKSDB_LIBRARY_API void rocksdb_pinnableslice_destroy(
 extern ROCKSDB_LIBRARY_API const char* rocksdb_pinnableslice_value(
     const rocksdb_pinnableslice_t* t, size_t* vlen);
 
+/* Allocation-free variants of rocksdb_get_pinned: the value is read into a
+   caller-owned rocksdb_pinnableslice_t, releasing whatever it pinned before,
+   so one slice can be reused across many reads. Returns 1 if the key was
+   found, 0 otherwise (in which case the slice is left empty). */
+extern ROCKSDB_LIBRARY_API rocksdb_pinnableslice_t*
+rocksdb_pinnableslice_create(void);
+extern ROCKSDB_LIBRARY_API void rocksdb_pinnableslice_reset(
+    rocksdb_pinnableslice_t* v);
+extern ROCKSDB_LIBRARY_API unsigned char rocksdb_get_pinned_into(
+    rocksdb_t* db, const rocksdb_readoptions_t* options, const char* key,
+    size_t keylen, rocksdb_pinnableslice_t* value, char** errptr);
+extern ROCKSDB_LIBRARY_API unsigned char rocksdb_get_pinned_into_cf(
+    rocksdb_t* db, const rocksdb_readoptions_t* options,
+    rocksdb_column_family_handle_t* column_family, const char* key,
+    size_t keylen, rocksdb_pinnableslice_t* value, char** errptr);
+
 extern ROCKSDB_LIBRARY_API rocksdb_memory_consumers_t*
 rocksdb_memory_consumers_create(void);
 extern ROCKSDB_LIBRARY_API void rocksdb_memory_consumers_add_db(
@@ -1330,6 +1330,13 @@ class DB {
     // "rocksdb.blob-cache-pinned-usage" - returns the memory size for the
     //      entries being pinned in blob cache.
     static const std::string kBlobCachePinnedUsage;
+
+    // "rocksdb.row-cache-hot-keys" - returns a multi-line string or map with
+    //      the hottest keys looked up in the row cache for the column family
+    //      and their estimated recent lookup counts. Only available when
+    //      `row_cache` and `row_cache_admission_threshold` are set. In the
+    //      string form, keys are hex encoded.
+    static const std::string kRowCacheHotKeys;
   };
 
   // DB implementations export properties about their state via this method.
@@ -95,6 +95,10 @@ struct EnvOptions {
   // If false, fallocate() calls are bypassed
   bool allow_fallocate = true;
 
+  // If true, submit appends and syncs of buffered writes asynchronously where
+  // supported. See DBOptions::use_async_io_for_writes
+  bool use_async_writes = false;
+
   // If true, set the FD_CLOEXEC on open fd.
   bool set_fd_cloexec = true;
 
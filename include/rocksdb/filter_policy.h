@@ -22,6 +22,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <climits>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -78,6 +79,16 @@ struct FilterBuildingContext {
 
   // Reason for creating the file with the filter
   TableFileCreationReason reason = TableFileCreationReason::kMisc;
+
+  // Statistics of the column family at table creation time, indexed by LSM
+  // level, or empty if unknown (as for SstFileWriter). Used by
+  // NewLevelAdaptiveFilterPolicy.
+  // Total size of the SST files in each level
+  std::vector<uint64_t> level_data_bytes;
+  // Estimated number of point lookups that reached each level without
+  // finding their key there (so that a filter false positive would have
+  // cost an extra read), based on sampling
+  std::vector<uint64_t> level_point_lookup_misses;
 };
 
 // Determines what kind of filter (if any) to generate in SST files, and under
@@ -208,4 +219,27 @@ const FilterPolicy* NewBloomFilterPolicy(
 FilterPolicy* NewRibbonFilterPolicy(double bloom_equivalent_bits_per_key,
                                     int bloom_before_level = 0);
 
+// A filter policy that spreads the filter memory of
+// bloom_equivalent_bits_per_key on average unevenly across LSM levels, to
+// minimize the number of reads wasted on filter false positives (as in
+// "Monkey: Optimal Navigable Key-Value Store", SIGMOD 2017). The false
+// positive rate of each level is made proportional to its share of the data
+// divided by its share of the point lookups that miss in it, as observed by
+// sampling. Before lookups have been sampled, small levels get more bits
+// per key and large levels fewer, which yields fewer false positives than
+// spreading the same memory uniformly. The bits per key of a level are
+// capped at twice the average, and levels getting below 0.5 bits per key get
+// no filter.
+//
+// Bits per key are recomputed each time an SST file is written, so
+// compactions rebuild filters according to the latest statistics. The
+// choice between Bloom and Ribbon filters is made as in
+// NewRibbonFilterPolicy with bloom_before_level, which defaults to always
+// using Bloom filters here.
+//
+// Without per-level statistics, as in SstFileWriter or FIFO compaction,
+// this is equivalent to NewRibbonFilterPolicy.
+FilterPolicy* NewLevelAdaptiveFilterPolicy(double bloom_equivalent_bits_per_key,
+                                           int bloom_before_level = INT_MAX);
+
 }  // namespace ROCKSDB_NAMESPACE
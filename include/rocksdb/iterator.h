@@ -19,6 +19,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "rocksdb/iterator_base.h"
 #include "rocksdb/wide_columns.h"
@@ -89,6 +90,37 @@ class Iterator : public IteratorBase {
   //   no matter whether the seqno to time recording feature is enabled or not.
   virtual Status GetProperty(std::string prop_name, std::string* prop);
 
+  // Appends the key and value of the current entry, and of the entries
+  // following it, to `keys` and `values` until `max_entries` entries have been
+  // appended or the iterator becomes invalid. Returns the number of entries
+  // appended, and leaves the iterator positioned on the entry after the last
+  // one appended, so that a forward scan can be written as
+  //
+  //   for (it->SeekToFirst(); it->Valid();) {
+  //     it->NextBatch(max_entries, &keys, &values);
+  //     ...
+  //   }
+  //
+  // Keys and values that are pinned (see "rocksdb.iterator.is-key-pinned" and
+  // "rocksdb.iterator.is-value-pinned") are referenced rather than copied, so
+  // the returned slices must not be used after the iterator is deleted. As
+  // with Next(), status() should be checked once the iterator is invalid.
+  virtual size_t NextBatch(size_t max_entries, std::vector<PinnableSlice>* keys,
+                           std::vector<PinnableSlice>* values);
+
+  // Starts the block reads that a following Seek(target) needs without
+  // waiting for them, when the iterator was created with
+  // ReadOptions::async_io and the file system supports asynchronous reads.
+  // This lets a single thread overlap the I/O of many scans:
+  //
+  //   for (auto& it : iters) it->PrepareSeek(target_of(it));
+  //   for (auto& it : iters) it->Seek(target_of(it));  // waits only as needed
+  //
+  // After PrepareSeek() the iterator is not Valid() until it is repositioned.
+  // Repositioning it to anything else than `target` is allowed but wastes
+  // the reads. Default implementation is no-op.
+  virtual void PrepareSeek(const Slice& /*target*/) {}
+
   virtual Slice timestamp() const {
     assert(false);
     return Slice();
@@ -334,4 +334,93 @@ class AssociativeMergeOperator : public MergeOperator {
                     Logger* logger) const override;
 };
 
+// EXPERIMENTAL
+//
+// An associative merge operator whose values decode into an accumulator of
+// type T, such as a counter. Full and partial merges, including those that
+// flushes and compactions do through MergeHelper::MergeUntil(), decode every
+// operand and fold it into a single T on the stack, then encode the result
+// once. AssociativeMergeOperator instead calls Merge() per operand, encoding
+// an intermediate value each time.
+template <typename T>
+class TypedAssociativeMergeOperator : public AssociativeMergeOperator {
+ public:
+  ~TypedAssociativeMergeOperator() override {}
+
+  // Decodes an existing value or an operand into `*decoded`. Returning false
+  // fails the merge, as Merge() returning false does.
+  virtual bool Decode(const Slice& value, T* decoded, Logger* logger) const = 0;
+
+  // Folds `value`, which was merged after the values already folded into
+  // `*acc`, into `*acc`.
+  virtual void Fold(const T& value, T* acc) const = 0;
+
+  // Encodes `acc` into `*encoded`, which is empty.
+  virtual void Encode(const T& acc, std::string* encoded) const = 0;
+
+  bool Merge(const Slice& /*key*/, const Slice* existing_value,
+             const Slice& value, std::string* new_value,
+             Logger* logger) const override {
+    T acc{};
+    if (existing_value != nullptr) {
+      T decoded{};
+      if (!Decode(*existing_value, &acc, logger) ||
+          !Decode(value, &decoded, logger)) {
+        return false;
+      }
+      Fold(decoded, &acc);
+    } else if (!Decode(value, &acc, logger)) {
+      return false;
+    }
+    Encode(acc, new_value);
+    return true;
+  }
+
+ private:
+  bool FullMergeV2(const MergeOperationInput& merge_in,
+                   MergeOperationOutput* merge_out) const override {
+    merge_out->new_value.clear();
+    return FoldAll(merge_in.existing_value, merge_in.operand_list,
+                   &merge_out->new_value, merge_in.logger);
+  }
+
+  bool PartialMergeMulti(const Slice& /*key*/,
+                         const std::deque<Slice>& operand_list,
+                         std::string* new_value,
+                         Logger* logger) const override {
+    return FoldAll(nullptr, operand_list, new_value, logger);
+  }
+
+  template <typename Operands>
+  bool FoldAll(const Slice* existing_value, const Operands& operands,
+               std::string* result, Logger* logger) const {
+    T acc{};
+    bool empty = true;
+    if (existing_value != nullptr) {
+      if (!Decode(*existing_value, &acc, logger)) {
+        return false;
+      }
+      empty = false;
+    }
+    for (const Slice& operand : operands) {
+      if (empty) {
+        if (!Decode(operand, &acc, logger)) {
+          return false;
+        }
+        empty = false;
+        continue;
+      }
+      T decoded{};
+      if (!Decode(operand, &decoded, logger)) {
+        return false;
+      }
+      Fold(decoded, &acc);
+    }
+    if (!empty) {
+      Encode(acc, result);
+    }
+    return true;
+  }
+};
+
 }  // namespace ROCKSDB_NAMESPACE
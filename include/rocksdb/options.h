@@ -714,6 +714,18 @@ struct DBOptions {
   // Default: 16
   int max_file_opening_threads = 16;
 
+  // If true and max_open_files is -1, DB::Open() only opens the files of
+  // levels 0 and 1, which most reads consult first, and returns. The files of
+  // the other levels are then opened in the background, in the LOW priority
+  // thread pool and with up to max_file_opening_threads threads, or by the
+  // first read that needs one. This keeps DB::Open() from taking time
+  // proportional to the number of files in the DB. Errors opening those
+  // files, such as a mismatched unique ID, are then reported by the reads
+  // that need them rather than by DB::Open(). Read-only and secondary
+  // instances open those files on first use only.
+  // Default: false
+  bool open_files_in_background = false;
+
   // Once write-ahead logs exceed this size, we will start forcing the flush of
   // column families whose memtables are backed by the oldest live WAL file
   // (i.e. the ones that are causing all the space amplification). If set to 0
@@ -856,6 +868,24 @@ struct DBOptions {
   // Default: -1
   int max_background_flushes = -1;
 
+  // The maximum number of L0 files that a single flush job writes in
+  // parallel. A flush of at least 16MB of memtable data per file is split
+  // into disjoint key ranges, picked by sampling the memtables, and each
+  // range is built into its own SST file by a dedicated thread, in the same
+  // way as compactions use subcompactions.
+  //
+  // Each partitioned flush adds several files to L0, so L0 file count based
+  // triggers such as level0_file_num_compaction_trigger and
+  // level0_slowdown_writes_trigger are reached sooner and may need to be
+  // raised accordingly.
+  //
+  // Flushes are not partitioned when the memtables contain range deletions,
+  // blob files are enabled, user-defined timestamps are used, or the
+  // memtable representation does not support sampling (only the skip list
+  // and B-tree memtables do).
+  // Default: 1 (i.e. no partitioning)
+  uint32_t max_flush_partitions = 1;
+
   // Specify the maximal size of the info log file. If the log file
   // is larger than `max_log_file_size`, a new info log file will
   // be created.
@@ -889,6 +919,19 @@ struct DBOptions {
   // reach the limit of storage capacity.
   uint64_t max_manifest_file_size = 1024 * 1024 * 1024;
 
+  // A new manifest file starts with a snapshot of the full DB state, so
+  // recovery only replays the edits appended after it. If non-zero, the
+  // manifest file is instead rolled over once it is more than this percentage
+  // larger than the snapshot it started with, with max_manifest_file_size
+  // acting as a lower bound. This bounds the number of edits replayed on
+  // DB::Open() relative to the size of the DB state, without rewriting a large
+  // snapshot on every edit when max_manifest_file_size is small. For example,
+  // with max_manifest_file_size = 1MB and max_manifest_space_amp_pct = 100,
+  // a manifest is rolled over once its edits are as large as its snapshot.
+  //
+  // Default: 0 (only roll over on reaching max_manifest_file_size)
+  int max_manifest_space_amp_pct = 0;
+
   // Number of shards used for table cache.
   int table_cache_numshardbits = 6;
 
@@ -952,6 +995,20 @@ struct DBOptions {
   // Default: false
   bool use_direct_io_for_flush_and_compaction = false;
 
+  // If true, appends and syncs of buffered (non-direct) writable files such
+  // as WAL, SST and MANIFEST files are submitted asynchronously through
+  // io_uring, so that the writer can prepare its next buffer while the
+  // previous one is being written out, and a sync is queued behind the
+  // writes instead of waiting for each of them. Data that has been appended
+  // is only guaranteed to have reached the OS once the file is synced or
+  // closed, so unsynced writes (e.g. WriteOptions::sync == false) can be lost
+  // on a process crash and not only on a machine crash.
+  // This is only effective when RocksDB is built with io_uring support and
+  // io_uring is enabled for the process (see RocksDbIOUringEnable()), and is
+  // silently ignored otherwise.
+  // Default: false
+  bool use_async_io_for_writes = false;
+
   // If false, fallocate() calls are bypassed, which disables file
   // preallocation. The file space preallocation is used to increase the file
   // write/append performance. By default, RocksDB preallocates space for WAL,
@@ -1171,6 +1228,21 @@ struct DBOptions {
   // Default: false
   bool enable_pipelined_write = false;
 
+  // If true, each writer computes the checksum of its own WriteBatch for the
+  // WAL before it joins a write group, so that checksums are computed by all
+  // the writing threads in parallel. The leader of the group then writes the
+  // batches of the group to the WAL as one record (as before) without first
+  // copying them into a merged batch, and combines their checksums instead of
+  // reading them again. This moves most of the per-byte work of the WAL write
+  // off the leader, which helps with many concurrent writers. With
+  // two_write_queues or unordered_write, where several write groups can be
+  // writing at once, the record is also gathered before taking the lock
+  // shared by those groups to write the WAL. The WAL format is unchanged. Not
+  // used with WAL compression.
+  //
+  // Default: false
+  bool parallel_wal_checksum = false;
+
   // Setting unordered_write to true trades higher write throughput with
   // relaxing the immutability guarantee of snapshots. This violates the
   // repeatability one expects from ::Get from a snapshot, as well as
@@ -1263,6 +1335,22 @@ struct DBOptions {
   // Default: kPointInTimeRecovery
   WALRecoveryMode wal_recovery_mode = WALRecoveryMode::kPointInTimeRecovery;
 
+  // Number of threads used to replay the WAL during DB::Open(). With more
+  // than one, a dedicated thread reads and checksums WAL records ahead of
+  // replay. If allow_concurrent_memtable_write is also set, the remaining
+  // threads insert write batches into the memtables concurrently, and full
+  // memtables are flushed while insertion continues into new ones. Batches
+  // are inserted one at a time when allow_2pc is set, with WritePrepared or
+  // WriteUnprepared transactions, and for batches containing merges.
+  //
+  // With concurrent insertion, a write batch that fails to be inserted fails
+  // DB::Open() (unless the error would be ignored anyway) instead of
+  // truncating recovery at that batch, since later batches may already be in
+  // the memtables.
+  //
+  // Default: 1 (replay on the thread calling DB::Open())
+  int wal_recovery_threads = 1;
+
   // if set to false then recovery will fail when a prepared
   // transaction is encountered in the WAL
   bool allow_2pc = false;
@@ -1273,6 +1361,16 @@ struct DBOptions {
   // Default: nullptr (disabled)
   std::shared_ptr<RowCache> row_cache = nullptr;
 
+  // If non-zero, a row read from a table file is only inserted into
+  // row_cache once its key has been looked up in the row cache about this
+  // many times recently, so that rarely read keys do not evict hot ones.
+  // Lookups are counted per column family with a count-min sketch whose
+  // counts decay over time. The hottest tracked keys are reported by the
+  // "rocksdb.row-cache-hot-keys" property. Ignored without row_cache.
+  //
+  // Default: 0 (admit every row)
+  uint32_t row_cache_admission_threshold = 0;
+
   // A filter object supplied to be invoked while processing write-ahead-logs
   // (WALs) during recovery. The filter provides a way to inspect log
   // records, ignoring a particular record or skipping replay.
@@ -1699,6 +1797,24 @@ struct ReadOptions {
   // to point lookups and is disabled by default.
   std::optional<size_t> merge_operand_count_threshold;
 
+  // EXPERIMENTAL
+  //
+  // If set, wide-column reads (GetEntity, MultiGetEntity and
+  // Iterator::columns()) only return the columns with these names. The index
+  // of each entity is still parsed, but no result is built for the other
+  // columns, which saves work for wide entities of which a few columns are
+  // read. The default column of plain key-values is returned only if
+  // kDefaultWideColumnName is included, and likewise Iterator::value() is
+  // empty for entities unless it is included.
+  //
+  // The names must be sorted in bytewise order, without duplicates, and must
+  // outlive the read (or the iterator).
+  //
+  // Only applies to reads served by the DB itself (DB::GetEntity,
+  // DB::MultiGetEntity and DB::NewIterator). Reads that go through a
+  // WriteBatchWithIndex, such as those of transactions, return all columns.
+  const std::vector<Slice>* wide_column_projection = nullptr;
+
   // If true, all data read from underlying storage will be
   // verified against corresponding checksums.
   bool verify_checksums = true;
@@ -1731,6 +1847,19 @@ struct ReadOptions {
   // comes at the expense of slightly higher CPU overhead.
   bool optimize_multiget_for_io = true;
 
+  // Experimental
+  //
+  // If greater than 1, MultiGet splits the sorted keys of each column family
+  // into up to this many contiguous ranges of at least 32 keys each, and
+  // looks them up concurrently, in the calling thread and in a thread pool
+  // owned by the DB. Each range does its own filter, index and data block
+  // lookups. This can reduce the latency of large batches on CPU bound
+  // (e.g. fully cached) workloads. `value_size_soft_limit` applies to each
+  // range separately, and the perf context of the calling thread only covers
+  // the range looked up by that thread. Not used by MultiGet of write
+  // prepared and write unprepared transactions.
+  size_t multiget_parallelism = 1;
+
   // *** END options relevant to point lookups (as well as scans) ***
   // *** BEGIN options only relevant to iterators or scans ***
 
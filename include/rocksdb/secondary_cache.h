@@ -217,4 +217,35 @@ class SecondaryCacheWrapper : public SecondaryCache {
 // secondary cache, such as compressed blocks
 extern const Cache::CacheItemHelper kSliceCacheItemHelper;
 
+// EXPERIMENTAL
+// Options for a SecondaryCache that stores blocks in a file on local flash,
+// typically used as TieredCacheOptions::nvm_sec_cache below the compressed
+// secondary cache. The file is written as a log of fixed-size segments, and
+// when it is full the oldest segment is discarded as a whole, so only a small
+// hash index is kept in memory. Lookups that do not wait read asynchronously
+// where the FileSystem supports it (io_uring with the default FileSystem on
+// Linux); such handles must be waited on by the thread that started the
+// lookup. The contents do not outlive the SecondaryCache object: the file is
+// created, or truncated, with the cache and deleted with it.
+struct LogStructuredSecondaryCacheOptions {
+  // Path of the cache file, which must not be used by anything else
+  std::string file_path;
+
+  // Maximum size of the cache file. It is rounded down to a multiple of
+  // segment_size, and must hold at least two segments.
+  size_t capacity = 0;
+
+  // The unit of writes and of eviction. Entries larger than a segment are not
+  // cached. Must be less than 4GB.
+  size_t segment_size = 16 << 20;
+
+  // FileSystem holding the cache file. nullptr means FileSystem::Default().
+  std::shared_ptr<FileSystem> fs;
+};
+
+// Creates the cache file and a SecondaryCache using it
+Status NewLogStructuredSecondaryCache(
+    const LogStructuredSecondaryCacheOptions& opts,
+    std::shared_ptr<SecondaryCache>* result);
+
 }  // namespace ROCKSDB_NAMESPACE
@@ -232,6 +232,20 @@ struct BlockBasedTableOptions {
     // Makes the index significantly bigger (2x or more), especially when keys
     // are long.
     kBinarySearchWithFirstKey = 0x03,
+
+    // Like kBinarySearch, but each file also stores a piecewise linear model
+    // of where the keys of the index block are, which lets a seek binary
+    // search only a few index entries around the predicted position. Works
+    // best for keys whose first 8 bytes are fairly evenly spread and mostly
+    // distinct, such as fixed-width big-endian integers. The model is kept in
+    // memory with the table reader (a few dozen bytes per linear segment)
+    // independently of cache_index_and_filter_blocks.
+    //
+    // Falls back to kBinarySearch for files where a model would not help,
+    // e.g. with a comparator other than BytewiseComparator or when many index
+    // keys share their first 8 bytes. Not readable by older versions of
+    // RocksDB.
+    kLearnedIndexSearch = 0x04,
   };
 
   IndexType index_type = kBinarySearch;
@@ -248,6 +262,25 @@ struct BlockBasedTableOptions {
   // kDataBlockBinaryAndHash.
   double data_block_hash_table_util_ratio = 0.75;
 
+  // If true, when a data block or an index block is loaded, an array holding
+  // the first 8 bytes of the user key at each restart point is built next to
+  // the restart array. Seek() then narrows the binary search over restart
+  // points by comparing these fixed-width prefixes, using SIMD instructions
+  // when available, and only decodes and compares the full restart keys that
+  // share the target's prefix. This mostly benefits point lookups and seeks
+  // on cached blocks with short restart intervals and keys whose first bytes
+  // are well distributed.
+  //
+  // The prefixes are derived in memory and do not change the SST format, so
+  // the option can be toggled at any time. The block cache charge of each
+  // data/index block grows by 8 bytes per restart point.
+  //
+  // Only takes effect with BytewiseComparator or ReverseBytewiseComparator,
+  // and without user-defined timestamps.
+  //
+  // Default: false
+  bool restart_key_prefix_seek = false;
+
   // Option hash_index_allow_collision is now deleted.
   // It will behave as if hash_index_allow_collision=true.
 
@@ -448,6 +481,24 @@ struct BlockBasedTableOptions {
   // This must generally be true for gets to be efficient.
   bool whole_key_filtering = true;
 
+  // If > 0, each new SST file gets a range filter using about this many bits
+  // per key. Iterators with iterate_upper_bound set consult it on Seek() and
+  // SeekToFirst() (the latter with iterate_lower_bound), and skip the file
+  // without reading its index when it has no key in the range being scanned.
+  // This is independent of filter_policy and prefix_extractor, and mostly
+  // helps short scans over arbitrary ranges.
+  //
+  // The filter is a hierarchy of Bloom filter entries over prefixes of the
+  // first 8 bytes of user keys (as a big-endian integer), so it only rules
+  // out ranges whose bounds differ within those bytes by less than 2^20.
+  // The filter is kept in memory for as long as the table reader is open.
+  //
+  // Only takes effect with BytewiseComparator and without user-defined
+  // timestamps. Files with range deletions are not skipped.
+  //
+  // Default: 0 (no range filter)
+  double range_filter_bits_per_key = 0;
+
   // If true, detect corruption during Bloom Filter (format_version >= 5)
   // and Ribbon Filter construction.
   //
@@ -86,6 +86,8 @@ struct CacheDumpOptions {
 // By using CacheDumper before we shut down the DB at host A and using
 // CacheDumpedLoader at host B before we reopen the DB, we can warmup the cache
 // ahead. This function can be used in other use cases also.
+// Index and filter blocks are dumped before data blocks, so that they are
+// loaded first and kept when the dump is limited by the deadline or size.
 class CacheDumper {
  public:
   virtual ~CacheDumper() = default;
@@ -103,9 +105,8 @@ class CacheDumper {
 };
 
 // NOTE that: this class is EXPERIMENTAL! May be changed in the future!
-// This is the class to load the dumped blocks to the destination cache. For now
-// we only load the blocks to the SecondaryCache. In the future, we may plan to
-// support loading to the block cache.
+// This is the class to load the dumped blocks to the destination cache, either
+// the SecondaryCache or the block cache.
 class CacheDumpedLoader {
  public:
   virtual ~CacheDumpedLoader() = default;
@@ -113,6 +114,20 @@ class CacheDumpedLoader {
     return IOStatus::NotSupported(
         "RestoreCacheEntriesToSecondaryCache is not supported");
   }
+
+  // Loads the dumped data and filter blocks into the block cache of the
+  // BlockBasedTableOptions given to the loader, which should be the table
+  // options of the DB. Index blocks are not loaded. Loading stops once the
+  // block cache is full, as the blocks dumped first are the most valuable.
+  // This can be used for a warm restart: dump the cache of the DB (with
+  // SetDumpFilter, so that only entries keyed by their stable file identity
+  // are dumped) before closing it, and load it into the new block cache
+  // from a separate thread while, or after, the DB is reopened. The DB can
+  // serve reads while the blocks are loaded.
+  virtual IOStatus RestoreCacheEntriesToBlockCache() {
+    return IOStatus::NotSupported(
+        "RestoreCacheEntriesToBlockCache is not supported");
+  }
 };
 
 // Get the writer which stores all the metadata and data sequentially to a file
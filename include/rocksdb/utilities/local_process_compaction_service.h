@@ -0,0 +1,92 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "rocksdb/env.h"
+#include "rocksdb/options.h"
+#include "rocksdb/status.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// EXPERIMENTAL: A CompactionService that runs compactions in separate worker
+// processes on the same host, so that their CPU and memory use is isolated
+// from the serving process (and can be limited, e.g. with cgroups).
+//
+// Jobs are exchanged through files in a shared directory:
+//   <id>.job            written by Schedule(): the DB path and the compaction
+//                       input from the DB
+//   <id>.running.<pid>  the job renamed by the worker process that claimed it
+//   <id>/               the output directory of the compaction
+//   <id>.result         written by the worker when the compaction is done
+// Renames are atomic, so any number of workers can share the directory.
+// The directory must be on the same file system as the DB, as the output files
+// are renamed into the DB.
+//
+// A job that no worker claims within `schedule_timeout_us`, or whose worker
+// process exits before writing the result, is run locally instead.
+struct LocalProcessCompactionServiceOptions {
+  // Directory shared with the workers. Created if missing.
+  std::string job_dir;
+
+  // If not empty, the path of a compaction worker binary (see
+  // tools/compaction_worker.cc), of which `num_workers` processes are started
+  // with `--job_dir=<job_dir> --parent_pid=<pid>`. They are restarted if they
+  // exit and stopped when the service is destroyed. If empty, workers are
+  // expected to be started separately. Starting workers is not supported on
+  // Windows.
+  std::string worker_command;
+  int num_workers = 1;
+
+  // How often Wait() checks for the result of a job.
+  uint64_t poll_interval_us = 1000;
+
+  // Time after which a job that no worker has claimed is run locally, or 0
+  // to wait indefinitely.
+  uint64_t schedule_timeout_us = 10 * 1000 * 1000;
+
+  Env* env = Env::Default();
+};
+
+Status NewLocalProcessCompactionService(
+    const LocalProcessCompactionServiceOptions& options,
+    std::shared_ptr<CompactionService>* service);
+
+// EXPERIMENTAL: Options of RunCompactionWorker().
+struct CompactionWorkerOptions {
+  // Same as LocalProcessCompactionServiceOptions::job_dir
+  std::string job_dir;
+
+  // How often to look for new jobs when idle.
+  uint64_t poll_interval_us = 1000;
+
+  // Options that are not passed to the worker with the job, see
+  // CompactionServiceOptionsOverride. table_factory must be set unless
+  // load_options_from_db is.
+  CompactionServiceOptionsOverride options_override;
+
+  // If true, the comparator, merge operator, compaction filter factory,
+  // prefix extractor, table factory, SST partitioner factory and table
+  // properties collector factories of `options_override` are replaced by the
+  // ones in the latest OPTIONS file of the DB of each job, for the column
+  // family being compacted. Only objects that can be created from their
+  // names (see ObjectRegistry) are loaded this way.
+  bool load_options_from_db = false;
+
+  // RunCompactionWorker() returns once this is set, canceling the running
+  // compaction. Not owned, may be nullptr.
+  std::atomic<bool>* stop = nullptr;
+};
+
+// Runs compaction jobs scheduled through a LocalProcessCompactionService with
+// the same `job_dir` until `options.stop` is set. Any number of workers,
+// threads or processes, can share a directory.
+Status RunCompactionWorker(const CompactionWorkerOptions& options);
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -140,40 +140,51 @@ class PinnableWideColumns {
   void CreateIndexForPlainValue();
   Status CreateIndexForWideColumns();
 
+  // Set from ReadOptions::wide_column_projection by the DB after Reset(),
+  // which clears it
+  friend class DBImpl;
+  void SetProjection(const std::vector<Slice>* projection) {
+    projection_ = projection;
+  }
+
   PinnableSlice value_;
   WideColumns columns_;
+  const std::vector<Slice>* projection_ = nullptr;
 };
 
 inline void PinnableWideColumns::Reset() {
   value_.Reset();
   columns_.clear();
+  projection_ = nullptr;
 }
 
 inline void PinnableWideColumns::Move(PinnableWideColumns&& other) {
   assert(columns_.empty());
+  assert(projection_ == nullptr);
 
   if (other.columns_.empty()) {
+    other.projection_ = nullptr;
     return;
   }
 
   const char* const data = other.value_.data();
-  const bool is_plain_value =
-      other.columns_.size() == 1 &&
-      other.columns_.front().name() == kDefaultWideColumnName &&
-      other.columns_.front().value() == other.value_;
+  const size_t size = other.value_.size();
 
   MoveValue(std::move(other.value_));
 
-  if (value_.data() == data) {
-    columns_ = std::move(other.columns_);
-  } else {
-    if (is_plain_value) {
-      CreateIndexForPlainValue();
-    } else {
-      const Status s = CreateIndexForWideColumns();
-      assert(s.ok());
-
-      s.PermitUncheckedError();
+  columns_ = std::move(other.columns_);
+
+  if (value_.data() != data) {
+    // The value was copied. Point the columns, which are possibly a projection
+    // of it, into the copy.
+    auto rebase = [&](Slice& slice) {
+      if (slice.data() >= data && slice.data() <= data + size) {
+        slice = Slice(value_.data() + (slice.data() - data), slice.size());
+      }
+    };
+    for (auto& column : columns_) {
+      rebase(column.name());
+      rebase(column.value());
     }
   }
 
@@ -206,9 +217,6 @@ inline void PinnableWideColumns::MoveValue(std::string&& value) {
   value_.PinSelf();
 }
 
-inline void PinnableWideColumns::CreateIndexForPlainValue() {
-  columns_ = WideColumns{{kDefaultWideColumnName, value_}};
-}
 
 inline void PinnableWideColumns::SetPlainValue(const Slice& value) {
   CopyValue(value);
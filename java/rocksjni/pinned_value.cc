@@ -0,0 +1,77 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// This file implements the "bridge" between Java and C++ for
+// ROCKSDB_NAMESPACE::PinnableSlice, exposed as org.rocksdb.PinnedValue.
+
+#include <jni.h>
+
+#include "include/org_rocksdb_PinnedValue.h"
+#include "rocksdb/slice.h"
+#include "rocksjni/cplusplus_to_java_convert.h"
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    newPinnedValue
+ * Signature: ()J
+ */
+jlong Java_org_rocksdb_PinnedValue_newPinnedValue(JNIEnv* /*env*/,
+                                                  jclass /*jcls*/) {
+  auto* pinnable = new ROCKSDB_NAMESPACE::PinnableSlice();
+  return GET_CPLUSPLUS_POINTER(pinnable);
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    disposeInternalJni
+ * Signature: (J)V
+ */
+void Java_org_rocksdb_PinnedValue_disposeInternalJni(JNIEnv* /*env*/,
+                                                     jclass /*jcls*/,
+                                                     jlong jhandle) {
+  auto* pinnable = reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle);
+  assert(pinnable != nullptr);
+  delete pinnable;
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    data
+ * Signature: (J)Ljava/nio/ByteBuffer;
+ */
+jobject Java_org_rocksdb_PinnedValue_data(JNIEnv* env, jclass /*jcls*/,
+                                          jlong jhandle) {
+  auto* pinnable = reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle);
+  if (pinnable->empty()) {
+    return nullptr;
+  }
+  // Points at the pinned memory, which stays valid until the PinnableSlice is
+  // reset, reused or deleted
+  return env->NewDirectByteBuffer(const_cast<char*>(pinnable->data()),
+                                  static_cast<jlong>(pinnable->size()));
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    size
+ * Signature: (J)I
+ */
+jint Java_org_rocksdb_PinnedValue_size(JNIEnv* /*env*/, jclass /*jcls*/,
+                                       jlong jhandle) {
+  auto* pinnable = reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle);
+  return static_cast<jint>(pinnable->size());
+}
+
+/*
+ * Class:     org_rocksdb_PinnedValue
+ * Method:    reset
+ * Signature: (J)V
+ */
+void Java_org_rocksdb_PinnedValue_reset(JNIEnv* /*env*/, jclass /*jcls*/,
+                                        jlong jhandle) {
+  auto* pinnable = reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jhandle);
+  pinnable->Reset();
+}
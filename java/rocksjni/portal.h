@@ -6855,6 +6855,9 @@ class IndexTypeJni {
       case ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
           kBinarySearchWithFirstKey:
         return 0x3;
+      case ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
+          kLearnedIndexSearch:
+        return 0x4;
       default:
         return 0x7F;  // undefined
     }
@@ -6877,6 +6880,9 @@ class IndexTypeJni {
       case 0x3:
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
             kBinarySearchWithFirstKey;
+      case 0x4:
+        return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
+            kLearnedIndexSearch;
       default:
         // undefined/default
         return ROCKSDB_NAMESPACE::BlockBasedTableOptions::IndexType::
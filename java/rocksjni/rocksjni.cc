@@ -1217,6 +1217,40 @@ jint Java_org_rocksdb_RocksDB_getDirect(JNIEnv* env, jclass /*jdb*/,
   }
 }
 
+/*
+ * Class:     org_rocksdb_RocksDB
+ * Method:    getPinned
+ * Signature: (JJLjava/nio/ByteBuffer;IIJJ)Z
+ */
+jboolean Java_org_rocksdb_RocksDB_getPinned(JNIEnv* env, jclass /*jdb*/,
+                                            jlong jdb_handle,
+                                            jlong jropt_handle, jobject jkey,
+                                            jint jkey_off, jint jkey_len,
+                                            jlong jvalue_handle,
+                                            jlong jcf_handle) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* ro_opt =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ReadOptions*>(jropt_handle);
+  auto* cf_handle =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+  auto* value =
+      reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(jvalue_handle);
+
+  try {
+    ROCKSDB_NAMESPACE::JDirectBufferSlice key(env, jkey, jkey_off, jkey_len);
+    // Releases whatever the previous read pinned
+    value->Reset();
+    ROCKSDB_NAMESPACE::Status s = db->Get(
+        ro_opt == nullptr ? ROCKSDB_NAMESPACE::ReadOptions() : *ro_opt,
+        cf_handle == nullptr ? db->DefaultColumnFamily() : cf_handle,
+        key.slice(), value);
+    ROCKSDB_NAMESPACE::KVException::ThrowOnError(env, s);
+    return JNI_TRUE;
+  } catch (ROCKSDB_NAMESPACE::KVException&) {
+    return JNI_FALSE;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // ROCKSDB_NAMESPACE::DB::Merge
 
@@ -1817,6 +1851,67 @@ void Java_org_rocksdb_RocksDB_multiGet__JJ_3J_3Ljava_nio_ByteBuffer_2_3I_3I_3Lja
       env, values, statuses, jvalues, jvalues_sizes, jstatus_objects);
 }
 
+/*
+ * Class:     org_rocksdb_RocksDB
+ * Method:    multiGetPinned
+ * Signature: (JJJ[Ljava/nio/ByteBuffer;[I[I[J)[Z
+ */
+jbooleanArray Java_org_rocksdb_RocksDB_multiGetPinned(
+    JNIEnv* env, jclass /*jdb*/, jlong jdb_handle, jlong jropt_handle,
+    jlong jcf_handle, jobjectArray jkeys, jintArray jkey_offsets,
+    jintArray jkey_lengths, jlongArray jvalue_handles) {
+  auto* db = reinterpret_cast<ROCKSDB_NAMESPACE::DB*>(jdb_handle);
+  auto* ro_opt =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ReadOptions*>(jropt_handle);
+  auto* cf_handle =
+      reinterpret_cast<ROCKSDB_NAMESPACE::ColumnFamilyHandle*>(jcf_handle);
+
+  ROCKSDB_NAMESPACE::MultiGetJNIKeys keys;
+  if (!keys.fromByteBuffers(env, jkeys, jkey_offsets, jkey_lengths)) {
+    return nullptr;
+  }
+  const jsize num_keys = static_cast<jsize>(keys.size());
+  std::unique_ptr<jlong[]> value_handles = std::make_unique<jlong[]>(num_keys);
+  env->GetLongArrayRegion(jvalue_handles, 0, num_keys, value_handles.get());
+  if (env->ExceptionCheck()) {
+    return nullptr;  // exception thrown: ArrayIndexOutOfBoundsException
+  }
+
+  std::vector<ROCKSDB_NAMESPACE::PinnableSlice> values(num_keys);
+  std::vector<ROCKSDB_NAMESPACE::Status> statuses(num_keys);
+  db->MultiGet(ro_opt == nullptr ? ROCKSDB_NAMESPACE::ReadOptions() : *ro_opt,
+               cf_handle == nullptr ? db->DefaultColumnFamily() : cf_handle,
+               keys.size(), keys.data(), values.data(), statuses.data());
+
+  std::unique_ptr<jboolean[]> found = std::make_unique<jboolean[]>(num_keys);
+  for (jsize i = 0; i < num_keys; i++) {
+    auto* value =
+        reinterpret_cast<ROCKSDB_NAMESPACE::PinnableSlice*>(value_handles[i]);
+    // Moving hands over the pin without copying the value
+    value->Reset();
+    if (statuses[i].ok()) {
+      *value = std::move(values[i]);
+      found[i] = JNI_TRUE;
+    } else if (statuses[i].IsNotFound()) {
+      found[i] = JNI_FALSE;
+    } else {
+      ROCKSDB_NAMESPACE::RocksDBExceptionJni::ThrowNew(env, statuses[i]);
+      return nullptr;
+    }
+  }
+
+  jbooleanArray jfound = env->NewBooleanArray(num_keys);
+  if (jfound == nullptr) {
+    return nullptr;  // exception thrown: OutOfMemoryError
+  }
+  env->SetBooleanArrayRegion(jfound, 0, num_keys, found.get());
+  if (env->ExceptionCheck()) {
+    env->DeleteLocalRef(jfound);
+    return nullptr;
+  }
+  return jfound;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // ROCKSDB_NAMESPACE::DB::KeyMayExist
 bool key_may_exist_helper(JNIEnv* env, jlong jdb_handle, jlong jcf_handle,
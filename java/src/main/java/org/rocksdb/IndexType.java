@@ -36,7 +36,14 @@ public enum IndexType {
    * Makes the index significantly bigger (2x or more), especially when keys
    * are long.
    */
-  kBinarySearchWithFirstKey((byte) 3);
+  kBinarySearchWithFirstKey((byte) 3),
+  /**
+   * Like {@link #kBinarySearch}, but each file also stores a piecewise linear
+   * model of where the keys of the index block are, so that a seek only binary
+   * searches a few index entries around the predicted position. Works best for
+   * keys whose first 8 bytes are evenly spread and mostly distinct.
+   */
+  kLearnedIndexSearch((byte) 4);
 
   /**
    * Returns the byte value of the enumerations value
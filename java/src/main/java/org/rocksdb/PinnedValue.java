@@ -0,0 +1,80 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+package org.rocksdb;
+
+import java.nio.ByteBuffer;
+
+/**
+ * A value read by {@link RocksDB#getPinned(ReadOptions, ByteBuffer, PinnedValue)}
+ * or {@link RocksDB#multiGetPinned(ReadOptions, ColumnFamilyHandle, java.util.List,
+ * java.util.List)} without being copied.
+ * <p>
+ * The value stays in the memory RocksDB read it into, typically a block in the
+ * block cache, and that memory is pinned until the value is {@link #reset()},
+ * read into again, or closed. {@link #data()} exposes it as a read-only direct
+ * {@link ByteBuffer} which must not be used after that.
+ * <p>
+ * A PinnedValue can be reused for many reads; holding many of them pins the
+ * corresponding blocks in the cache.
+ */
+public class PinnedValue extends RocksObject {
+  /**
+   * Constructs an empty PinnedValue.
+   */
+  public PinnedValue() {
+    super(newPinnedValueInstance());
+  }
+
+  /**
+   * Returns the pinned value as a read-only direct ByteBuffer, without
+   * copying it.
+   * <p>
+   * The buffer is only valid until this PinnedValue is reset, read into
+   * again, or closed.
+   *
+   * @return the value, or an empty buffer if no value is held
+   */
+  public ByteBuffer data() {
+    assert (isOwningHandle());
+    final ByteBuffer data = data(nativeHandle_);
+    return data == null ? ByteBuffer.allocateDirect(0) : data.asReadOnlyBuffer();
+  }
+
+  /**
+   * Returns the size of the pinned value in bytes.
+   *
+   * @return the size of the value, or 0 if no value is held
+   */
+  public int size() {
+    assert (isOwningHandle());
+    return size(nativeHandle_);
+  }
+
+  /**
+   * Releases the memory pinned for the current value.
+   */
+  public void reset() {
+    assert (isOwningHandle());
+    reset(nativeHandle_);
+  }
+
+  private static long newPinnedValueInstance() {
+    RocksDB.loadLibrary();
+    return newPinnedValue();
+  }
+
+  @Override
+  protected final void disposeInternal(final long handle) {
+    disposeInternalJni(handle);
+  }
+
+  private static native long newPinnedValue();
+  private static native void disposeInternalJni(final long handle);
+  private static native ByteBuffer data(final long handle);
+  private static native int size(final long handle);
+  private static native void reset(final long handle);
+}
@@ -1364,6 +1364,58 @@ public class RocksDB extends RocksObject {
     return result;
   }
 
+  /**
+   * Get the value associated with the specified key without copying it.
+   * <p>
+   * The value is left pinned in the memory it was read into, typically the
+   * block cache, and is exposed through {@link PinnedValue#data()} until
+   * {@code value} is reset, reused or closed.
+   *
+   * @param opt {@link org.rocksdb.ReadOptions} instance.
+   * @param key the key to retrieve the value. It is using position and limit.
+   *     Supports direct buffer only.
+   * @param value the {@link PinnedValue} to receive the retrieved value.
+   * @return true if the key was found, false otherwise.
+   *
+   * @throws RocksDBException thrown if error happens in underlying
+   *    native library.
+   */
+  public boolean getPinned(final ReadOptions opt, final ByteBuffer key, final PinnedValue value)
+      throws RocksDBException {
+    return getPinned(null, opt, key, value);
+  }
+
+  /**
+   * Get the value associated with the specified key within column family
+   * without copying it.
+   * <p>
+   * The value is left pinned in the memory it was read into, typically the
+   * block cache, and is exposed through {@link PinnedValue#data()} until
+   * {@code value} is reset, reused or closed.
+   *
+   * @param columnFamilyHandle {@link org.rocksdb.ColumnFamilyHandle}
+   *     instance, or null for the default column family.
+   * @param opt {@link org.rocksdb.ReadOptions} instance.
+   * @param key the key to retrieve the value. It is using position and limit.
+   *     Supports direct buffer only.
+   * @param value the {@link PinnedValue} to receive the retrieved value.
+   * @return true if the key was found, false otherwise.
+   *
+   * @throws RocksDBException thrown if error happens in underlying
+   *    native library.
+   */
+  public boolean getPinned(final ColumnFamilyHandle columnFamilyHandle, final ReadOptions opt,
+      final ByteBuffer key, final PinnedValue value) throws RocksDBException {
+    if (!key.isDirect()) {
+      throw new IllegalArgumentException("The key buffer must be a direct byte buffer");
+    }
+    final boolean found = getPinned(nativeHandle_, opt.nativeHandle_, key, key.position(),
+        key.remaining(), value.nativeHandle_,
+        columnFamilyHandle == null ? 0 : columnFamilyHandle.nativeHandle_);
+    key.position(key.limit());
+    return found;
+  }
+
   /**
    * Remove the database entry for {@code key}. Requires that the key exists
    * and was not overwritten. It is not an error if the key did not exist
@@ -2570,6 +2622,52 @@ public class RocksDB extends RocksObject {
     return results;
   }
 
+  /**
+   * Fetches a list of values for the given list of keys within a column
+   * family without copying them, reusing the passed {@link PinnedValue}s.
+   * <p>
+   * Each value is left pinned in the memory it was read into, typically the
+   * block cache, until its {@link PinnedValue} is reset, reused or closed.
+   *
+   * @param readOptions Read options
+   * @param columnFamilyHandle {@link org.rocksdb.ColumnFamilyHandle}
+   *     instance, or null for the default column family.
+   * @param keys list of keys for which values need to be retrieved.
+   *     Supports direct buffers only.
+   * @param values list of {@link PinnedValue}s to receive the retrieved values.
+   * @return for each key, true if it was found, false otherwise.
+   *
+   * @throws RocksDBException if error happens in underlying native library.
+   * @throws IllegalArgumentException thrown if the number of passed keys and
+   *     passed values do not match.
+   */
+  public boolean[] multiGetPinned(final ReadOptions readOptions,
+      final ColumnFamilyHandle columnFamilyHandle, final List<ByteBuffer> keys,
+      final List<PinnedValue> values) throws RocksDBException {
+    if (values.size() != keys.size()) {
+      throw new IllegalArgumentException("For each key there must be a corresponding value. "
+          + keys.size() + " keys were supplied, but " + values.size() + " values were supplied.");
+    }
+
+    final int numValues = keys.size();
+    final ByteBuffer[] keysArray = keys.toArray(new ByteBuffer[0]);
+    final int[] keyOffsets = new int[numValues];
+    final int[] keyLengths = new int[numValues];
+    final long[] valueHandles = new long[numValues];
+    for (int i = 0; i < numValues; i++) {
+      if (!keysArray[i].isDirect()) {
+        throw new IllegalArgumentException("All key buffers must be direct byte buffers");
+      }
+      keyOffsets[i] = keysArray[i].position();
+      keyLengths[i] = keysArray[i].remaining();
+      valueHandles[i] = values.get(i).nativeHandle_;
+    }
+
+    return multiGetPinned(nativeHandle_, readOptions.nativeHandle_,
+        columnFamilyHandle == null ? 0 : columnFamilyHandle.nativeHandle_, keysArray, keyOffsets,
+        keyLengths, valueHandles);
+  }
+
   /**
    *  Check if a key exists in the database.
    *  This method is not as lightweight as {@code keyMayExist} but it gives a 100% guarantee
@@ -4968,6 +5066,10 @@ public class RocksDB extends RocksObject {
       final int[] keyLengths, final ByteBuffer[] valuesArray, final int[] valuesSizeArray,
       final Status[] statusArray);
 
+  private static native boolean[] multiGetPinned(final long dbHandle, final long rOptHandle,
+      final long cfHandle, final ByteBuffer[] keysArray, final int[] keyOffsets,
+      final int[] keyLengths, final long[] valueHandles) throws RocksDBException;
+
   private static native boolean keyExists(final long handle, final long cfHandle,
       final long readOptHandle, final byte[] key, final int keyOffset, final int keyLength);
 
@@ -4995,6 +5097,8 @@ public class RocksDB extends RocksObject {
   private static native int getDirect(long handle, long readOptHandle, ByteBuffer key,
       int keyOffset, int keyLength, ByteBuffer value, int valueOffset, int valueLength,
       long cfHandle) throws RocksDBException;
+  private static native boolean getPinned(long handle, long readOptHandle, ByteBuffer key,
+      int keyOffset, int keyLength, long valueHandle, long cfHandle) throws RocksDBException;
   private static native boolean keyMayExistDirect(final long handle, final long cfHhandle,
       final long readOptHandle, final ByteBuffer key, final int keyOffset, final int keyLength);
   private static native int[] keyMayExistDirectFoundValue(final long handle, final long cfHhandle,
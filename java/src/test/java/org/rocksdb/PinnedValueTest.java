@@ -0,0 +1,93 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+package org.rocksdb;
+
+import static java.nio.charset.StandardCharsets.UTF_8;
+import static org.assertj.core.api.Assertions.assertThat;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import org.junit.ClassRule;
+import org.junit.Rule;
+import org.junit.Test;
+import org.junit.rules.TemporaryFolder;
+
+public class PinnedValueTest {
+  @ClassRule
+  public static final RocksNativeLibraryResource ROCKS_NATIVE_LIBRARY_RESOURCE =
+      new RocksNativeLibraryResource();
+
+  @Rule public TemporaryFolder dbFolder = new TemporaryFolder();
+
+  private static ByteBuffer directKey(final String key) {
+    final byte[] bytes = key.getBytes(UTF_8);
+    final ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+    buffer.put(bytes).flip();
+    return buffer;
+  }
+
+  private static String valueOf(final PinnedValue value) {
+    final ByteBuffer data = value.data();
+    final byte[] bytes = new byte[data.remaining()];
+    data.get(bytes);
+    return new String(bytes, UTF_8);
+  }
+
+  @Test
+  public void getPinned() throws RocksDBException {
+    try (final Options options = new Options().setCreateIfMissing(true);
+         final RocksDB db = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath());
+         final ReadOptions readOptions = new ReadOptions();
+         final PinnedValue value = new PinnedValue()) {
+      db.put("key1".getBytes(UTF_8), "value1".getBytes(UTF_8));
+      db.put("key2".getBytes(UTF_8), "value22".getBytes(UTF_8));
+      db.compactRange();
+
+      assertThat(db.getPinned(readOptions, directKey("key1"), value)).isTrue();
+      assertThat(value.size()).isEqualTo(6);
+      assertThat(valueOf(value)).isEqualTo("value1");
+
+      // the same PinnedValue is reused for the next read
+      assertThat(db.getPinned(readOptions, directKey("key2"), value)).isTrue();
+      assertThat(valueOf(value)).isEqualTo("value22");
+
+      assertThat(db.getPinned(readOptions, directKey("missing"), value)).isFalse();
+      assertThat(value.size()).isEqualTo(0);
+      assertThat(value.data().remaining()).isEqualTo(0);
+    }
+  }
+
+  @Test
+  public void multiGetPinned() throws RocksDBException {
+    try (final Options options = new Options().setCreateIfMissing(true);
+         final RocksDB db = RocksDB.open(options, dbFolder.getRoot().getAbsolutePath());
+         final ReadOptions readOptions = new ReadOptions()) {
+      db.put("key1".getBytes(UTF_8), "value1".getBytes(UTF_8));
+      db.put("key3".getBytes(UTF_8), "value3".getBytes(UTF_8));
+
+      final List<ByteBuffer> keys =
+          Arrays.asList(directKey("key1"), directKey("key2"), directKey("key3"));
+      final List<PinnedValue> values = new ArrayList<>();
+      for (int i = 0; i < keys.size(); i++) {
+        values.add(new PinnedValue());
+      }
+      try {
+        final boolean[] found = db.multiGetPinned(readOptions, null, keys, values);
+        assertThat(found).containsExactly(true, false, true);
+        assertThat(valueOf(values.get(0))).isEqualTo("value1");
+        assertThat(values.get(1).size()).isEqualTo(0);
+        assertThat(valueOf(values.get(2))).isEqualTo("value3");
+      } finally {
+        for (final PinnedValue value : values) {
+          value.close();
+        }
+      }
+    }
+  }
+}
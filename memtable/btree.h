@@ -0,0 +1,627 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// BTree is an insert-only B+-tree of pointers to keys. It is meant to be used
+// as a memtable: its nodes hold sorted arrays of key pointers spanning a few
+// cache lines, so a lookup visits O(log_F(N)) nodes for a fan-out F of about
+// 30, where a skip list visits O(log(N)) nodes that are each a cache miss.
+//
+// Thread safety
+// -------------
+//
+// Insert() may be called concurrently from any number of threads and runs
+// concurrently with readers. Synchronization uses optimistic lock coupling:
+// every node has a version word whose lowest bit is set while a writer holds
+// the node's lock. Writers lock only the nodes they modify (a leaf, plus its
+// parent when the leaf is split). Readers never write to shared memory; they
+// read a node optimistically and validate afterwards that its version did
+// not change, restarting from the root otherwise. Full nodes are split on
+// the way down, so an insert never needs to lock more than two nodes.
+//
+// Invariants:
+//
+// (1) Nodes and keys are never freed or removed until the BTree is
+// destroyed. Since the tree lives in the Allocator, a stale pointer read by
+// an optimistic reader always points to a valid node.
+//
+// (2) Every key in a leaf is smaller than every key in the leaves that
+// follow it in the leaf chain, at any point in time. Splits only move the
+// upper half of a leaf to a new leaf that is linked in right after it.
+//
+// (3) The slots [0, count) of a node always hold valid pointers, even while
+// a writer shifts them, because new slots are written before the count is
+// incremented and the count is decremented only after a split.
+//
+// Iterators copy the keys of one leaf at a time under validation, so a
+// concurrent split never makes them skip or repeat keys. An iterator may or
+// may not return keys inserted after it was positioned.
+
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+
+#include "memory/allocator.h"
+#include "port/likely.h"
+#include "port/port.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+template <class Comparator>
+class BTree {
+ public:
+  // Number of keys in a leaf. A leaf is 256 bytes.
+  static constexpr uint32_t kLeafCapacity = 29;
+  // Number of separator keys in an inner node, which has one more child. An
+  // inner node is 504 bytes.
+  static constexpr uint32_t kInnerCapacity = 30;
+
+ private:
+  struct Node;
+  struct Leaf;
+  struct Inner;
+
+  // A validated copy of a leaf.
+  struct LeafCopy {
+    const char* keys[kLeafCapacity];
+    uint32_t count = 0;
+    Leaf* next = nullptr;
+  };
+
+ public:
+  // Create a new BTree object that will use "cmp" for comparing keys, and
+  // will allocate memory using "*allocator". Objects allocated in the
+  // allocator must remain allocated for the lifetime of the tree.
+  explicit BTree(Comparator cmp, Allocator* allocator);
+  // No copying allowed
+  BTree(const BTree&) = delete;
+  BTree& operator=(const BTree&) = delete;
+
+  // Inserts key into the tree. Thread-safe. Returns false without inserting
+  // if a key comparing equal to key is already in the tree.
+  bool Insert(const char* key);
+
+  // Returns true iff an entry that compares equal to key is in the tree.
+  bool Contains(const char* key) const;
+
+  // Returns an estimate of the number of entries smaller than `key`. It
+  // assumes that the nodes next to the search path are about as full as the
+  // ones on it.
+  uint64_t EstimateCount(const char* key) const;
+
+  // Iteration over the contents of the tree.
+  class Iterator {
+   public:
+    // Initialize an iterator over the specified tree.
+    // The returned iterator is not valid.
+    explicit Iterator(const BTree* tree);
+
+    // Returns true iff the iterator is positioned at a valid entry.
+    bool Valid() const { return pos_ < leaf_.count; }
+
+    // Returns the key at the current position.
+    // REQUIRES: Valid()
+    const char* key() const {
+      assert(Valid());
+      return leaf_.keys[pos_];
+    }
+
+    // Advances to the next position.
+    // REQUIRES: Valid()
+    void Next();
+
+    // Advances to the previous position.
+    // REQUIRES: Valid()
+    void Prev();
+
+    // Advance to the first entry with a key >= target
+    void Seek(const char* target);
+
+    // Retreat to the last entry with a key <= target
+    void SeekForPrev(const char* target);
+
+    // Position at the first entry in the tree.
+    // Final state of iterator is Valid() iff the tree is not empty.
+    void SeekToFirst();
+
+    // Position at the last entry in the tree.
+    // Final state of iterator is Valid() iff the tree is not empty.
+    void SeekToLast();
+
+   private:
+    // Moves forward through the leaf chain until positioned at a key, if
+    // the current leaf has no keys left.
+    void SkipEmptyLeaves();
+
+    const BTree* tree_;
+    LeafCopy leaf_;
+    uint32_t pos_;
+  };
+
+ private:
+  // How FindLeaf() chooses the child to descend into.
+  enum class Descend {
+    // The leaf that contains the smallest key >= target, or whose successor
+    // in the leaf chain does.
+    kGreaterOrEqual,
+    // The leaf that contains the largest key < target, if any.
+    kLessThan,
+    kFirst,
+    kLast,
+  };
+
+  struct Node {
+    explicit Node(uint32_t l) : version(0), count(0), level(l) {}
+
+    // Waits until the node is not locked and returns its version.
+    uint64_t ReadLock() const {
+      uint64_t v = version.load(std::memory_order_acquire);
+      while (UNLIKELY((v & 1) != 0)) {
+        port::AsmVolatilePause();
+        v = version.load(std::memory_order_acquire);
+      }
+      return v;
+    }
+
+    // Returns true iff the node has not been modified since ReadLock()
+    // returned v, i.e. everything read in between is consistent.
+    bool Validate(uint64_t v) const {
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return version.load(std::memory_order_relaxed) == v;
+    }
+
+    // Locks the node if it has not been modified since ReadLock() returned
+    // v. Returns false otherwise.
+    bool TryUpgrade(uint64_t v) {
+      return version.compare_exchange_strong(v, v + 1);
+    }
+
+    void Unlock() { version.fetch_add(1, std::memory_order_release); }
+
+    uint32_t Count(uint32_t capacity) const {
+      // Clamping guards optimistic readers against a torn view of a node
+      // that is being split.
+      return std::min(count.load(std::memory_order_acquire), capacity);
+    }
+
+    std::atomic<uint64_t> version;
+    std::atomic<uint32_t> count;
+    // 0 for leaves. Immutable.
+    const uint32_t level;
+  };
+
+  struct Leaf : public Node {
+    Leaf() : Node(0), next(nullptr) {}
+
+    std::atomic<Leaf*> next;
+    std::atomic<const char*> keys[kLeafCapacity];
+  };
+
+  struct Inner : public Node {
+    explicit Inner(uint32_t l) : Node(l) {}
+
+    // children[i] holds the keys in [keys[i - 1], keys[i]).
+    std::atomic<const char*> keys[kInnerCapacity];
+    std::atomic<Node*> children[kInnerCapacity + 1];
+  };
+
+  // Returns the index of the first of keys[0, n) that is greater than key.
+  template <class KeyArray>
+  uint32_t UpperBound(const KeyArray& keys, uint32_t n,
+                      const char* key) const {
+    uint32_t left = 0;
+    while (left < n) {
+      uint32_t mid = (left + n) / 2;
+      if (compare_(Load(keys[mid]), key) <= 0) {
+        left = mid + 1;
+      } else {
+        n = mid;
+      }
+    }
+    return left;
+  }
+
+  // Returns the index of the first of keys[0, n) that is not less than key.
+  template <class KeyArray>
+  uint32_t LowerBound(const KeyArray& keys, uint32_t n,
+                      const char* key) const {
+    uint32_t left = 0;
+    while (left < n) {
+      uint32_t mid = (left + n) / 2;
+      if (compare_(Load(keys[mid]), key) < 0) {
+        left = mid + 1;
+      } else {
+        n = mid;
+      }
+    }
+    return left;
+  }
+
+  static const char* Load(const std::atomic<const char*>& key) {
+    return key.load(std::memory_order_acquire);
+  }
+  static const char* Load(const char* key) { return key; }
+
+  // One attempt of Insert(). Returns false if it has to be restarted, and
+  // otherwise sets *inserted.
+  bool TryInsert(const char* key, bool* inserted);
+
+  // Splits the full `node` (a leaf or an inner node) and adds the new right
+  // half to `parent`, or to a new root if parent is null.
+  // REQUIRES: both `node` and `parent` are locked.
+  void Split(Node* node, Inner* parent);
+
+  // Copies the leaf selected by `descend` into *out, validating the copy
+  // against concurrent writers.
+  void FindLeaf(const char* target, Descend descend, LeafCopy* out) const;
+  bool TryFindLeaf(const char* target, Descend descend, LeafCopy* out) const;
+
+  // Copies `leaf` into *out, retrying while writers modify it.
+  static void CopyLeaf(const Leaf* leaf, LeafCopy* out);
+  // Returns the version of `leaf` the copy is consistent with.
+  static uint64_t TryCopyLeaf(const Leaf* leaf, LeafCopy* out);
+
+  Comparator const compare_;
+  Allocator* const allocator_;
+  std::atomic<Node*> root_;
+};
+
+template <class Comparator>
+BTree<Comparator>::BTree(const Comparator cmp, Allocator* allocator)
+    : compare_(cmp), allocator_(allocator) {
+  char* mem = allocator_->AllocateAligned(sizeof(Leaf));
+  root_.store(new (mem) Leaf(), std::memory_order_relaxed);
+}
+
+template <class Comparator>
+bool BTree<Comparator>::Insert(const char* key) {
+  bool inserted = false;
+  while (!TryInsert(key, &inserted)) {
+  }
+  return inserted;
+}
+
+template <class Comparator>
+bool BTree<Comparator>::TryInsert(const char* key, bool* inserted) {
+  Node* node = root_.load(std::memory_order_acquire);
+  uint64_t version = node->ReadLock();
+  if (node != root_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  Inner* parent = nullptr;
+  uint64_t parent_version = 0;
+
+  while (true) {
+    const bool is_leaf = node->level == 0;
+    const uint32_t capacity = is_leaf ? kLeafCapacity : kInnerCapacity;
+    if (node->count.load(std::memory_order_acquire) >= capacity) {
+      // Split full nodes eagerly, so that the parent of a node always has
+      // room for a new child.
+      if (parent != nullptr && !parent->TryUpgrade(parent_version)) {
+        return false;
+      }
+      if (!node->TryUpgrade(version)) {
+        if (parent != nullptr) {
+          parent->Unlock();
+        }
+        return false;
+      }
+      if (parent == nullptr &&
+          node != root_.load(std::memory_order_acquire)) {
+        // Somebody added a new root above node.
+        node->Unlock();
+        return false;
+      }
+      Split(node, parent);
+      node->Unlock();
+      if (parent != nullptr) {
+        parent->Unlock();
+      }
+      return false;
+    }
+
+    if (is_leaf) {
+      break;
+    }
+
+    if (parent != nullptr && !parent->Validate(parent_version)) {
+      return false;
+    }
+    Inner* inner = static_cast<Inner*>(node);
+    Node* child = inner->children[UpperBound(inner->keys,
+                                             inner->Count(kInnerCapacity), key)]
+                      .load(std::memory_order_acquire);
+    if (!inner->Validate(version)) {
+      return false;
+    }
+    parent = inner;
+    parent_version = version;
+    node = child;
+    version = node->ReadLock();
+  }
+
+  Leaf* leaf = static_cast<Leaf*>(node);
+  if (!leaf->TryUpgrade(version)) {
+    return false;
+  }
+  // The leaf might have been split after we picked it, which changes the
+  // parent.
+  if (parent != nullptr && !parent->Validate(parent_version)) {
+    leaf->Unlock();
+    return false;
+  }
+  uint32_t count = leaf->count.load(std::memory_order_relaxed);
+  uint32_t pos = LowerBound(leaf->keys, count, key);
+  if (pos < count && compare_(Load(leaf->keys[pos]), key) == 0) {
+    *inserted = false;
+  } else {
+    for (uint32_t i = count; i > pos; --i) {
+      leaf->keys[i].store(Load(leaf->keys[i - 1]), std::memory_order_release);
+    }
+    leaf->keys[pos].store(key, std::memory_order_release);
+    leaf->count.store(count + 1, std::memory_order_release);
+    *inserted = true;
+  }
+  leaf->Unlock();
+  return true;
+}
+
+template <class Comparator>
+void BTree<Comparator>::Split(Node* node, Inner* parent) {
+  const char* separator;
+  Node* right;
+  uint32_t count = node->count.load(std::memory_order_relaxed);
+  uint32_t mid = count / 2;
+  if (node->level == 0) {
+    Leaf* left = static_cast<Leaf*>(node);
+    Leaf* new_leaf = new (allocator_->AllocateAligned(sizeof(Leaf))) Leaf();
+    for (uint32_t i = mid; i < count; ++i) {
+      new_leaf->keys[i - mid].store(Load(left->keys[i]),
+                                    std::memory_order_relaxed);
+    }
+    new_leaf->count.store(count - mid, std::memory_order_relaxed);
+    new_leaf->next.store(left->next.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+    separator = Load(left->keys[mid]);
+    // Publishes new_leaf to readers of the leaf chain.
+    left->next.store(new_leaf, std::memory_order_release);
+    left->count.store(mid, std::memory_order_release);
+    right = new_leaf;
+  } else {
+    // The middle key moves up to the parent.
+    Inner* left = static_cast<Inner*>(node);
+    Inner* new_inner = new (allocator_->AllocateAligned(sizeof(Inner)))
+        Inner(node->level);
+    for (uint32_t i = mid + 1; i < count; ++i) {
+      new_inner->keys[i - mid - 1].store(Load(left->keys[i]),
+                                         std::memory_order_relaxed);
+    }
+    for (uint32_t i = mid + 1; i <= count; ++i) {
+      new_inner->children[i - mid - 1].store(
+          left->children[i].load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+    }
+    new_inner->count.store(count - mid - 1, std::memory_order_relaxed);
+    separator = Load(left->keys[mid]);
+    left->count.store(mid, std::memory_order_release);
+    right = new_inner;
+  }
+
+  if (parent == nullptr) {
+    Inner* new_root = new (allocator_->AllocateAligned(sizeof(Inner)))
+        Inner(node->level + 1);
+    new_root->keys[0].store(separator, std::memory_order_relaxed);
+    new_root->children[0].store(node, std::memory_order_relaxed);
+    new_root->children[1].store(right, std::memory_order_relaxed);
+    new_root->count.store(1, std::memory_order_relaxed);
+    root_.store(new_root, std::memory_order_release);
+  } else {
+    uint32_t parent_count = parent->count.load(std::memory_order_relaxed);
+    assert(parent_count < kInnerCapacity);
+    uint32_t pos = UpperBound(parent->keys, parent_count, separator);
+    parent->children[parent_count + 1].store(
+        parent->children[parent_count].load(std::memory_order_relaxed),
+        std::memory_order_release);
+    for (uint32_t i = parent_count; i > pos; --i) {
+      parent->keys[i].store(Load(parent->keys[i - 1]),
+                            std::memory_order_release);
+      parent->children[i].store(
+          parent->children[i - 1].load(std::memory_order_relaxed),
+          std::memory_order_release);
+    }
+    parent->keys[pos].store(separator, std::memory_order_release);
+    parent->children[pos + 1].store(right, std::memory_order_release);
+    parent->count.store(parent_count + 1, std::memory_order_release);
+  }
+}
+
+template <class Comparator>
+uint64_t BTree<Comparator>::TryCopyLeaf(const Leaf* leaf, LeafCopy* out) {
+  uint64_t version = leaf->ReadLock();
+  out->count = leaf->Count(kLeafCapacity);
+  for (uint32_t i = 0; i < out->count; ++i) {
+    out->keys[i] = Load(leaf->keys[i]);
+  }
+  out->next = leaf->next.load(std::memory_order_acquire);
+  return version;
+}
+
+template <class Comparator>
+void BTree<Comparator>::CopyLeaf(const Leaf* leaf, LeafCopy* out) {
+  while (!leaf->Validate(TryCopyLeaf(leaf, out))) {
+  }
+}
+
+template <class Comparator>
+bool BTree<Comparator>::TryFindLeaf(const char* target, Descend descend,
+                                    LeafCopy* out) const {
+  Node* node = root_.load(std::memory_order_acquire);
+  uint64_t version = node->ReadLock();
+  const Inner* parent = nullptr;
+  uint64_t parent_version = 0;
+  while (node->level > 0) {
+    const Inner* inner = static_cast<const Inner*>(node);
+    uint32_t count = inner->Count(kInnerCapacity);
+    uint32_t child_index = 0;
+    switch (descend) {
+      case Descend::kGreaterOrEqual:
+        child_index = UpperBound(inner->keys, count, target);
+        break;
+      case Descend::kLessThan:
+        child_index = LowerBound(inner->keys, count, target);
+        break;
+      case Descend::kFirst:
+        child_index = 0;
+        break;
+      case Descend::kLast:
+        child_index = count;
+        break;
+    }
+    Node* child = inner->children[child_index].load(std::memory_order_acquire);
+    if (!inner->Validate(version)) {
+      return false;
+    }
+    parent = inner;
+    parent_version = version;
+    node = child;
+    version = node->ReadLock();
+  }
+  version = TryCopyLeaf(static_cast<const Leaf*>(node), out);
+  // Revalidating the parent makes sure that the leaf was not split since we
+  // chose it, which would have moved some of the keys we are looking for to
+  // its new sibling.
+  return node->Validate(version) &&
+         (parent == nullptr || parent->Validate(parent_version));
+}
+
+template <class Comparator>
+void BTree<Comparator>::FindLeaf(const char* target, Descend descend,
+                                 LeafCopy* out) const {
+  while (!TryFindLeaf(target, descend, out)) {
+  }
+}
+
+template <class Comparator>
+bool BTree<Comparator>::Contains(const char* key) const {
+  Iterator iter(this);
+  iter.Seek(key);
+  return iter.Valid() && compare_(iter.key(), key) == 0;
+}
+
+template <class Comparator>
+uint64_t BTree<Comparator>::EstimateCount(const char* key) const {
+  // Racy reads are fine for an estimate; they can't crash because of
+  // invariants (1) and (3).
+  uint64_t count = 0;
+  const Node* node = root_.load(std::memory_order_acquire);
+  while (node->level > 0) {
+    const Inner* inner = static_cast<const Inner*>(node);
+    uint32_t n = inner->Count(kInnerCapacity);
+    uint32_t index = UpperBound(inner->keys, n, key);
+    count = count * (n + 1) + index;
+    node = inner->children[index].load(std::memory_order_acquire);
+  }
+  const Leaf* leaf = static_cast<const Leaf*>(node);
+  uint32_t n = leaf->Count(kLeafCapacity);
+  return count * n + LowerBound(leaf->keys, n, key);
+}
+
+template <class Comparator>
+BTree<Comparator>::Iterator::Iterator(const BTree* tree)
+    : tree_(tree), pos_(0) {}
+
+template <class Comparator>
+void BTree<Comparator>::Iterator::SkipEmptyLeaves() {
+  while (pos_ >= leaf_.count && leaf_.next != nullptr) {
+    CopyLeaf(leaf_.next, &leaf_);
+    pos_ = 0;
+  }
+}
+
+template <class Comparator>
+void BTree<Comparator>::Iterator::Next() {
+  assert(Valid());
+  ++pos_;
+  SkipEmptyLeaves();
+}
+
+template <class Comparator>
+void BTree<Comparator>::Iterator::Prev() {
+  assert(Valid());
+  if (pos_ > 0) {
+    --pos_;
+    return;
+  }
+  // There are no back links between leaves, look up the leaf that holds the
+  // predecessor instead.
+  const char* current = key();
+  tree_->FindLeaf(current, Descend::kLessThan, &leaf_);
+  pos_ = tree_->LowerBound(leaf_.keys, leaf_.count, current);
+  if (pos_ == 0) {
+    // No smaller key in the tree.
+    leaf_.count = 0;
+  } else {
+    --pos_;
+  }
+}
+
+template <class Comparator>
+void BTree<Comparator>::Iterator::Seek(const char* target) {
+  tree_->FindLeaf(target, Descend::kGreaterOrEqual, &leaf_);
+  pos_ = tree_->LowerBound(leaf_.keys, leaf_.count, target);
+  SkipEmptyLeaves();
+}
+
+template <class Comparator>
+void BTree<Comparator>::Iterator::SeekForPrev(const char* target) {
+  tree_->FindLeaf(target, Descend::kLessThan, &leaf_);
+  pos_ = tree_->UpperBound(leaf_.keys, leaf_.count, target);
+  // The leaf holds the keys in a range that ends at a key >= target, so
+  // target itself, if present, can only be in this leaf or at the start of
+  // the next one.
+  if (pos_ == leaf_.count && leaf_.next != nullptr) {
+    LeafCopy next;
+    CopyLeaf(leaf_.next, &next);
+    if (next.count > 0 && tree_->compare_(next.keys[0], target) == 0) {
+      leaf_ = next;
+      pos_ = 1;
+    }
+  }
+  if (pos_ == 0) {
+    leaf_.count = 0;
+  } else {
+    --pos_;
+  }
+}
+
+template <class Comparator>
+void BTree<Comparator>::Iterator::SeekToFirst() {
+  tree_->FindLeaf(nullptr, Descend::kFirst, &leaf_);
+  pos_ = 0;
+  SkipEmptyLeaves();
+}
+
+template <class Comparator>
+void BTree<Comparator>::Iterator::SeekToLast() {
+  tree_->FindLeaf(nullptr, Descend::kLast, &leaf_);
+  // Keys inserted after the last leaf was split are in its new siblings.
+  while (leaf_.next != nullptr) {
+    LeafCopy next;
+    CopyLeaf(leaf_.next, &next);
+    if (next.count == 0) {
+      break;
+    }
+    leaf_ = next;
+  }
+  if (leaf_.count == 0) {
+    return;
+  }
+  pos_ = leaf_.count - 1;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
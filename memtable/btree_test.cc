@@ -0,0 +1,264 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "memtable/btree.h"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "memory/arena.h"
+#include "memory/concurrent_arena.h"
+#include "port/port.h"
+#include "test_util/testharness.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+using Key = uint64_t;
+
+// Keys are stored as 8 big-endian bytes, so memcmp order is numeric order.
+struct TestComparator {
+  int operator()(const char* a, const char* b) const {
+    return memcmp(a, b, sizeof(Key));
+  }
+};
+
+using TestBTree = BTree<TestComparator>;
+
+static const char* Encode(Allocator* allocator, Key key) {
+  char* buf = allocator->Allocate(sizeof(Key));
+  for (size_t i = 0; i < sizeof(Key); i++) {
+    buf[i] = static_cast<char>(key >> (56 - 8 * i));
+  }
+  return buf;
+}
+
+static Key Decode(const char* buf) {
+  Key key = 0;
+  for (size_t i = 0; i < sizeof(Key); i++) {
+    key = (key << 8) | static_cast<unsigned char>(buf[i]);
+  }
+  return key;
+}
+
+class BTreeTest : public testing::Test {};
+
+TEST_F(BTreeTest, Empty) {
+  Arena arena;
+  TestComparator cmp;
+  TestBTree tree(cmp, &arena);
+  const char* key = Encode(&arena, 10);
+  ASSERT_TRUE(!tree.Contains(key));
+  ASSERT_EQ(0, tree.EstimateCount(key));
+
+  TestBTree::Iterator iter(&tree);
+  ASSERT_TRUE(!iter.Valid());
+  iter.SeekToFirst();
+  ASSERT_TRUE(!iter.Valid());
+  iter.Seek(key);
+  ASSERT_TRUE(!iter.Valid());
+  iter.SeekForPrev(key);
+  ASSERT_TRUE(!iter.Valid());
+  iter.SeekToLast();
+  ASSERT_TRUE(!iter.Valid());
+}
+
+TEST_F(BTreeTest, InsertAndLookup) {
+  const int N = 2000;
+  const int R = 5000;
+  Random rnd(1000);
+  std::set<Key> keys;
+  Arena arena;
+  TestComparator cmp;
+  TestBTree tree(cmp, &arena);
+  for (int i = 0; i < N; i++) {
+    Key key = rnd.Next() % R;
+    bool inserted = keys.insert(key).second;
+    ASSERT_EQ(inserted, tree.Insert(Encode(&arena, key)));
+  }
+
+  for (Key i = 0; i < R; i++) {
+    if (tree.Contains(Encode(&arena, i))) {
+      ASSERT_EQ(keys.count(i), 1U);
+    } else {
+      ASSERT_EQ(keys.count(i), 0U);
+    }
+  }
+
+  // Simple iterator tests
+  {
+    TestBTree::Iterator iter(&tree);
+    ASSERT_TRUE(!iter.Valid());
+
+    iter.Seek(Encode(&arena, 0));
+    ASSERT_TRUE(iter.Valid());
+    ASSERT_EQ(*(keys.begin()), Decode(iter.key()));
+
+    iter.SeekForPrev(Encode(&arena, R - 1));
+    ASSERT_TRUE(iter.Valid());
+    ASSERT_EQ(*(keys.rbegin()), Decode(iter.key()));
+
+    iter.SeekToFirst();
+    ASSERT_TRUE(iter.Valid());
+    ASSERT_EQ(*(keys.begin()), Decode(iter.key()));
+
+    iter.SeekToLast();
+    ASSERT_TRUE(iter.Valid());
+    ASSERT_EQ(*(keys.rbegin()), Decode(iter.key()));
+  }
+
+  // Forward iteration test
+  for (Key i = 0; i < R; i++) {
+    TestBTree::Iterator iter(&tree);
+    iter.Seek(Encode(&arena, i));
+
+    // Compare against model iterator
+    std::set<Key>::iterator model_iter = keys.lower_bound(i);
+    for (int j = 0; j < 3; j++) {
+      if (model_iter == keys.end()) {
+        ASSERT_TRUE(!iter.Valid());
+        break;
+      } else {
+        ASSERT_TRUE(iter.Valid());
+        ASSERT_EQ(*model_iter, Decode(iter.key()));
+        ++model_iter;
+        iter.Next();
+      }
+    }
+  }
+
+  // Backward iteration test
+  for (Key i = 0; i < R; i++) {
+    TestBTree::Iterator iter(&tree);
+    iter.SeekForPrev(Encode(&arena, i));
+
+    // Compare against model iterator
+    std::set<Key>::iterator model_iter = keys.upper_bound(i);
+    for (int j = 0; j < 3; j++) {
+      if (model_iter == keys.begin()) {
+        ASSERT_TRUE(!iter.Valid());
+        break;
+      } else {
+        ASSERT_TRUE(iter.Valid());
+        ASSERT_EQ(*--model_iter, Decode(iter.key()));
+        iter.Prev();
+      }
+    }
+  }
+
+  // Full scans in both directions
+  {
+    TestBTree::Iterator iter(&tree);
+    iter.SeekToFirst();
+    for (Key key : keys) {
+      ASSERT_TRUE(iter.Valid());
+      ASSERT_EQ(key, Decode(iter.key()));
+      iter.Next();
+    }
+    ASSERT_TRUE(!iter.Valid());
+
+    iter.SeekToLast();
+    for (auto it = keys.rbegin(); it != keys.rend(); ++it) {
+      ASSERT_TRUE(iter.Valid());
+      ASSERT_EQ(*it, Decode(iter.key()));
+      iter.Prev();
+    }
+    ASSERT_TRUE(!iter.Valid());
+  }
+}
+
+TEST_F(BTreeTest, EstimateCount) {
+  const Key N = 100000;
+  Arena arena;
+  TestComparator cmp;
+  TestBTree tree(cmp, &arena);
+  // Sequential inserts leave half-full leaves behind, which is the worst case
+  // for the estimate.
+  for (Key i = 0; i < N; i++) {
+    ASSERT_TRUE(tree.Insert(Encode(&arena, i * 2)));
+  }
+  ASSERT_EQ(0, tree.EstimateCount(Encode(&arena, 0)));
+  uint64_t half = tree.EstimateCount(Encode(&arena, N));
+  uint64_t all = tree.EstimateCount(Encode(&arena, N * 2));
+  ASSERT_GT(half, 0);
+  ASSERT_LT(half, all);
+}
+
+TEST_F(BTreeTest, ConcurrentInsert) {
+  const int kNumThreads = 4;
+  const int kKeysPerThread = 20000;
+  ConcurrentArena arena;
+  TestComparator cmp;
+  TestBTree tree(cmp, &arena);
+
+  // Interleave the key ranges of the writers so that they keep splitting the
+  // same nodes. Every key is inserted twice to exercise duplicate detection.
+  std::atomic<int> num_inserted{0};
+  std::atomic<bool> done{false};
+  std::vector<port::Thread> writers;
+  for (int t = 0; t < kNumThreads; t++) {
+    writers.emplace_back([&, t]() {
+      for (int i = 0; i < kKeysPerThread; i++) {
+        Key key = static_cast<Key>(i) * kNumThreads * 2 + (t % 2) * 2;
+        if (tree.Insert(Encode(&arena, key))) {
+          num_inserted.fetch_add(1);
+        }
+      }
+    });
+  }
+
+  // Readers must always observe a sorted sequence while writers are active.
+  port::Thread reader([&]() {
+    while (!done.load()) {
+      TestBTree::Iterator iter(&tree);
+      Key prev = 0;
+      bool first = true;
+      for (iter.SeekToFirst(); iter.Valid(); iter.Next()) {
+        Key key = Decode(iter.key());
+        ASSERT_TRUE(first || key > prev);
+        prev = key;
+        first = false;
+      }
+      first = true;
+      for (iter.SeekToLast(); iter.Valid(); iter.Prev()) {
+        Key key = Decode(iter.key());
+        ASSERT_TRUE(first || key < prev);
+        prev = key;
+        first = false;
+      }
+    }
+  });
+
+  for (auto& writer : writers) {
+    writer.join();
+  }
+  done.store(true);
+  reader.join();
+
+  // Threads t and t + 2 inserted the same keys.
+  const int kNumKeys = kNumThreads / 2 * kKeysPerThread;
+  ASSERT_EQ(kNumKeys, num_inserted.load());
+  TestBTree::Iterator iter(&tree);
+  iter.SeekToFirst();
+  for (int i = 0; i < kNumKeys; i++) {
+    Key expected =
+        static_cast<Key>(i / 2) * kNumThreads * 2 + static_cast<Key>(i % 2) * 2;
+    ASSERT_TRUE(iter.Valid());
+    ASSERT_EQ(expected, Decode(iter.key()));
+    ASSERT_TRUE(tree.Contains(iter.key()));
+    iter.Next();
+  }
+  ASSERT_TRUE(!iter.Valid());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,163 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+#include "db/memtable.h"
+#include "memory/arena.h"
+#include "memtable/btree.h"
+#include "rocksdb/memtablerep.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+class BTreeRep : public MemTableRep {
+  BTree<const MemTableRep::KeyComparator&> tree_;
+
+ public:
+  explicit BTreeRep(const MemTableRep::KeyComparator& compare,
+                    Allocator* allocator)
+      : MemTableRep(allocator), tree_(compare, allocator) {}
+
+  // Insert key into the tree.
+  // REQUIRES: nothing that compares equal to key is currently in the tree.
+  void Insert(KeyHandle handle) override {
+    tree_.Insert(static_cast<char*>(handle));
+  }
+
+  bool InsertKey(KeyHandle handle) override {
+    return tree_.Insert(static_cast<char*>(handle));
+  }
+
+  // BTree::Insert() is thread-safe.
+  void InsertConcurrently(KeyHandle handle) override {
+    tree_.Insert(static_cast<char*>(handle));
+  }
+
+  bool InsertKeyConcurrently(KeyHandle handle) override {
+    return tree_.Insert(static_cast<char*>(handle));
+  }
+
+  // Returns true iff an entry that compares equal to key is in the tree.
+  bool Contains(const char* key) const override { return tree_.Contains(key); }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here
+    return 0;
+  }
+
+  void Get(const LookupKey& k, void* callback_args,
+           bool (*callback_func)(void* arg, const char* entry)) override {
+    BTree<const MemTableRep::KeyComparator&>::Iterator iter(&tree_);
+    for (iter.Seek(k.memtable_key().data());
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey,
+                                 const Slice& end_ikey) override {
+    std::string tmp;
+    uint64_t start_count = tree_.EstimateCount(EncodeKey(&tmp, start_ikey));
+    uint64_t end_count = tree_.EstimateCount(EncodeKey(&tmp, end_ikey));
+    return (end_count >= start_count) ? (end_count - start_count) : 0;
+  }
+
+  void UniqueRandomSample(const uint64_t num_entries,
+                          const uint64_t target_sample_size,
+                          std::unordered_set<const char*>* entries) override {
+    entries->clear();
+    // Avoid divide-by-0.
+    assert(target_sample_size > 0);
+    assert(num_entries > 0);
+    // Iterate linearly through the memtable entries, adding entry i to the
+    // sample set with a probability
+    // (target_sample_size - entries.size()) / (num_entries - i).
+    Random* rnd = Random::GetTLSInstance();
+    BTree<const MemTableRep::KeyComparator&>::Iterator iter(&tree_);
+    iter.SeekToFirst();
+    uint64_t counter = 0, num_samples_left = target_sample_size;
+    for (; iter.Valid() && (num_samples_left > 0) && counter < num_entries;
+         iter.Next(), counter++) {
+      if (rnd->Next() % (num_entries - counter) < num_samples_left) {
+        entries->insert(iter.key());
+        num_samples_left--;
+      }
+    }
+  }
+
+  ~BTreeRep() override = default;
+
+  // Iteration over the contents of the tree
+  class Iterator : public MemTableRep::Iterator {
+    BTree<const MemTableRep::KeyComparator&>::Iterator iter_;
+
+   public:
+    // Initialize an iterator over the specified tree.
+    // The returned iterator is not valid.
+    explicit Iterator(const BTree<const MemTableRep::KeyComparator&>* tree)
+        : iter_(tree) {}
+
+    ~Iterator() override = default;
+
+    // Returns true iff the iterator is positioned at a valid node.
+    bool Valid() const override { return iter_.Valid(); }
+
+    // Returns the key at the current position.
+    // REQUIRES: Valid()
+    const char* key() const override { return iter_.key(); }
+
+    // Advances to the next position.
+    // REQUIRES: Valid()
+    void Next() override { iter_.Next(); }
+
+    // Advances to the previous position.
+    // REQUIRES: Valid()
+    void Prev() override { iter_.Prev(); }
+
+    // Advance to the first entry with a key >= target
+    void Seek(const Slice& user_key, const char* memtable_key) override {
+      if (memtable_key != nullptr) {
+        iter_.Seek(memtable_key);
+      } else {
+        iter_.Seek(EncodeKey(&tmp_, user_key));
+      }
+    }
+
+    // Retreat to the last entry with a key <= target
+    void SeekForPrev(const Slice& user_key, const char* memtable_key) override {
+      if (memtable_key != nullptr) {
+        iter_.SeekForPrev(memtable_key);
+      } else {
+        iter_.SeekForPrev(EncodeKey(&tmp_, user_key));
+      }
+    }
+
+    // Position at the first entry in the tree.
+    // Final state of iterator is Valid() iff the tree is not empty.
+    void SeekToFirst() override { iter_.SeekToFirst(); }
+
+    // Position at the last entry in the tree.
+    // Final state of iterator is Valid() iff the tree is not empty.
+    void SeekToLast() override { iter_.SeekToLast(); }
+
+   protected:
+    std::string tmp_;  // For passing to EncodeKey
+  };
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void* mem = arena ? arena->AllocateAligned(sizeof(BTreeRep::Iterator))
+                      :
+                      operator new(sizeof(BTreeRep::Iterator));
+    return new (mem) BTreeRep::Iterator(&tree_);
+  }
+};
+}  // namespace
+
+MemTableRep* BTreeRepFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, Allocator* allocator,
+    const SliceTransform* /*transform*/, Logger* /*logger*/) {
+  return new BTreeRep(compare, allocator);
+}
+
+}  // namespace ROCKSDB_NAMESPACE
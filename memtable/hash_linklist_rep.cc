@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <thread>
 
 #include "db/memtable.h"
 #include "memory/arena.h"
@@ -30,9 +31,12 @@ using Pointer = std::atomic<void*>;
 struct BucketHeader {
   Pointer next;
   std::atomic<uint32_t> num_entries;
+  // Number of entries linked into the list, which trails num_entries while
+  // InsertConcurrently() calls are linking their nodes
+  std::atomic<uint32_t> num_linked;
 
   explicit BucketHeader(void* n, uint32_t count)
-      : next(n), num_entries(count) {}
+      : next(n), num_entries(count), num_linked(count) {}
 
   bool IsSkipListBucket() {
     return next.load(std::memory_order_relaxed) == this;
@@ -47,6 +51,21 @@ struct BucketHeader {
     // Only one thread can do write at one time. No need to do atomic
     // incremental. Update it with relaxed load and store.
     num_entries.store(GetNumEntries() + 1, std::memory_order_relaxed);
+    num_linked.store(num_linked.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_relaxed);
+  }
+
+  // Used by InsertConcurrently(). Returns the number of entries before the
+  // increment.
+  uint32_t FetchAddNumEntries() {
+    return num_entries.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Used by InsertConcurrently() after linking a node
+  void IncNumLinked() { num_linked.fetch_add(1, std::memory_order_release); }
+
+  uint32_t GetNumLinked() const {
+    return num_linked.load(std::memory_order_acquire);
   }
 };
 
@@ -62,6 +81,21 @@ struct SkipListBucketHeader {
         skip_list(cmp, allocator) {}
 };
 
+// Waits in InsertConcurrently() until `done()` returns true. Spins for a short
+// while, as the wait is usually for another writer to link a single node,
+// then yields like WriteThread::AwaitState().
+template <typename F>
+void SpinWait(F&& done) {
+  constexpr uint32_t kMaxSpins = 200;
+  for (uint32_t spins = 0; !done(); ++spins) {
+    if (spins < kMaxSpins) {
+      port::AsmVolatilePause();
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
 struct Node {
   // Accessors/mutators for links.  Wrapped in methods so we can
   // add the appropriate barriers as necessary.
@@ -80,6 +114,10 @@ struct Node {
 
   void NoBarrier_SetNext(Node* x) { next_.store(x, std::memory_order_relaxed); }
 
+  bool CASNext(Node* expected, Node* x) {
+    return next_.compare_exchange_strong(expected, x);
+  }
+
   // Needed for placement new below which is fine
   Node() = default;
 
@@ -153,6 +191,21 @@ struct Node {
 //     to itself, so no matter a reader sees any stale or newer value, it will
 //     be able to correctly distinguish case 3 and 4.
 //
+// InsertConcurrently() keeps these properties with compare-and-swap:
+// (1) Case 1->2 and 2->3 CAS the bucket pointer, retrying from the new bucket
+//     content if another writer got there first.
+// (2) New nodes are linked into the sorted list by CAS on the predecessor's
+//     next pointer, so readers always see a properly terminated sorted list.
+// (3) Every writer takes a ticket by incrementing the header's count. The
+//     writer whose ticket equals the threshold waits until all writers with a
+//     smaller ticket have linked their nodes, then converts the bucket to a
+//     skip list (case 3->4). Writers with larger tickets wait for the new
+//     bucket to be published and insert into the skip list. As a result the
+//     count of a case 3 header can transiently exceed the threshold.
+//     Converting a bucket is therefore not lock-free: if a writer with a
+//     smaller ticket is descheduled before linking its node, the writers of
+//     that bucket spin and then yield until it is done.
+//
 // The reason that we use case 2 is we want to make the format to be efficient
 // when the utilization of buckets is relatively low. If we use case 3 for
 // single entry bucket, we will need to waste 12 bytes for every entry,
@@ -170,6 +223,8 @@ class HashLinkListRep : public MemTableRep {
 
   void Insert(KeyHandle handle) override;
 
+  void InsertConcurrently(KeyHandle handle) override;
+
   bool Contains(const char* key) const override;
 
   size_t ApproximateMemoryUsage() override;
@@ -571,7 +626,8 @@ Node* HashLinkListRep::GetLinkListFirstNode(Pointer& bucket_pointer) const {
   // Counting header
   BucketHeader* header = reinterpret_cast<BucketHeader*>(first_next_pointer);
   if (!header->IsSkipListBucket()) {
-    assert(header->GetNumEntries() <= threshold_use_skiplist_);
+    // The count can be larger than threshold_use_skiplist_ while concurrent
+    // inserts wait for the bucket to be converted to a skip list.
     return reinterpret_cast<Node*>(
         header->next.load(std::memory_order_acquire));
   }
@@ -702,6 +758,121 @@ void HashLinkListRep::Insert(KeyHandle handle) {
   }
 }
 
+void HashLinkListRep::InsertConcurrently(KeyHandle handle) {
+  Node* x = static_cast<Node*>(handle);
+  Slice internal_key = GetLengthPrefixedSlice(x->key);
+  auto transformed = GetPrefix(internal_key);
+  auto& bucket = buckets_[GetHash(transformed)];
+
+  void* bucket_head = bucket.load(std::memory_order_acquire);
+  BucketHeader* header = nullptr;
+  while (header == nullptr) {
+    if (bucket_head == nullptr) {
+      // Case 1. empty bucket
+      x->NoBarrier_SetNext(nullptr);
+      if (bucket.compare_exchange_strong(bucket_head, x,
+                                         std::memory_order_release,
+                                         std::memory_order_acquire)) {
+        return;
+      }
+      continue;
+    }
+    Pointer* first_next_pointer = static_cast<Pointer*>(bucket_head);
+    if (first_next_pointer->load(std::memory_order_acquire) != nullptr) {
+      // Either a header, or a single node that has been wrapped into a header
+      // by another writer since we loaded the bucket. In the latter case the
+      // header was published before the node's next pointer changed, so
+      // reloading the bucket gives the header.
+      header =
+          static_cast<BucketHeader*>(bucket.load(std::memory_order_acquire));
+      break;
+    }
+    // Case 2. only one entry in the bucket. Wrap it into a counting header
+    // before linking anything to it, like Insert().
+    Node* first = static_cast<Node*>(bucket_head);
+    auto* mem = allocator_->AllocateAligned(sizeof(BucketHeader));
+    auto* new_header = new (mem) BucketHeader(first, 1);
+    if (bucket.compare_exchange_strong(bucket_head, new_header,
+                                       std::memory_order_release,
+                                       std::memory_order_acquire)) {
+      header = new_header;
+    }
+    // Otherwise retry with the current bucket content; our header stays
+    // unused in the allocator.
+  }
+
+  if (!header->IsSkipListBucket()) {
+    uint32_t ticket = header->FetchAddNumEntries();
+    if (ticket < threshold_use_skiplist_) {
+      // Case 5. Link into the sorted linked list.
+      Node* prev = nullptr;
+      Node* cur =
+          static_cast<Node*>(header->next.load(std::memory_order_acquire));
+      while (true) {
+        while (KeyIsAfterNode(internal_key, cur)) {
+          prev = cur;
+          cur = cur->Next();
+        }
+        // Our data structure does not allow duplicate insertion
+        assert(cur == nullptr || !Equal(x->key, cur->key));
+        x->NoBarrier_SetNext(cur);
+        if (prev != nullptr) {
+          if (prev->CASNext(cur, x)) {
+            header->IncNumLinked();
+            return;
+          }
+          cur = prev->Next();
+        } else {
+          void* expected = cur;
+          if (header->next.compare_exchange_strong(expected, x,
+                                                   std::memory_order_release,
+                                                   std::memory_order_acquire)) {
+            header->IncNumLinked();
+            return;
+          }
+          cur = static_cast<Node*>(expected);
+        }
+        // Somebody linked a node right after prev, continue from there.
+      }
+    }
+
+    if (ticket == threshold_use_skiplist_) {
+      // Case 3. We are responsible for converting the bucket to a skip list
+      // once the writers with smaller tickets have linked their nodes.
+      SpinWait([&]() {
+        return header->GetNumLinked() == threshold_use_skiplist_;
+      });
+      Node* first =
+          static_cast<Node*>(header->next.load(std::memory_order_acquire));
+      auto mem = allocator_->AllocateAligned(sizeof(SkipListBucketHeader));
+      SkipListBucketHeader* new_skip_list_header =
+          new (mem) SkipListBucketHeader(compare_, allocator_,
+                                         threshold_use_skiplist_ + 1);
+      auto& skip_list = new_skip_list_header->skip_list;
+      // The skip list is not visible to anyone else yet.
+      for (Node* n = first; n != nullptr; n = n->Next()) {
+        skip_list.Insert(n->key);
+      }
+      skip_list.Insert(x->key);
+      bucket.store(new_skip_list_header, std::memory_order_release);
+      return;
+    }
+
+    // Wait for the bucket to be converted to a skip list.
+    SpinWait([&]() {
+      header =
+          static_cast<BucketHeader*>(bucket.load(std::memory_order_acquire));
+      return header->IsSkipListBucket();
+    });
+  }
+
+  // Case 4. Bucket is already a skip list
+  auto* skip_list_bucket_header =
+      reinterpret_cast<SkipListBucketHeader*>(header);
+  skip_list_bucket_header->Counting_header.FetchAddNumEntries();
+  skip_list_bucket_header->skip_list.InsertConcurrently(x->key);
+}
+
 bool HashLinkListRep::Contains(const char* key) const {
   Slice internal_key = GetLengthPrefixedSlice(key);
 
@@ -897,6 +1068,8 @@ class HashLinkListRepFactory : public MemTableRepFactory {
   const char* Name() const override { return kClassName(); }
   const char* NickName() const override { return kNickName(); }
 
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
  private:
   HashLinkListRepOptions options_;
 };
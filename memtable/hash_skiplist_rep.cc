@@ -28,6 +28,8 @@ class HashSkipListRep : public MemTableRep {
 
   void Insert(KeyHandle handle) override;
 
+  void InsertConcurrently(KeyHandle handle) override;
+
   bool Contains(const char* key) const override;
 
   size_t ApproximateMemoryUsage() override;
@@ -73,7 +75,7 @@ class HashSkipListRep : public MemTableRep {
     return GetBucket(GetHash(slice));
   }
   // Get a bucket from buckets_. If the bucket hasn't been initialized yet,
-  // initialize it before returning.
+  // initialize it before returning. Safe to call from concurrent inserts.
   Bucket* GetInitializedBucket(const Slice& transformed);
 
   class Iterator : public MemTableRep::Iterator {
@@ -256,9 +258,15 @@ HashSkipListRep::Bucket* HashSkipListRep::GetInitializedBucket(
   auto bucket = GetBucket(hash);
   if (bucket == nullptr) {
     auto addr = allocator_->AllocateAligned(sizeof(Bucket));
-    bucket = new (addr) Bucket(compare_, allocator_, skiplist_height_,
-                               skiplist_branching_factor_);
-    buckets_[hash].store(bucket, std::memory_order_release);
+    auto new_bucket = new (addr) Bucket(compare_, allocator_, skiplist_height_,
+                                        skiplist_branching_factor_);
+    // A concurrent insert may have initialized the bucket in the meantime.
+    // In that case use its bucket; the memory of ours stays in the arena.
+    if (buckets_[hash].compare_exchange_strong(bucket, new_bucket,
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+      bucket = new_bucket;
+    }
   }
   return bucket;
 }
@@ -271,6 +279,13 @@ void HashSkipListRep::Insert(KeyHandle handle) {
   bucket->Insert(key);
 }
 
+void HashSkipListRep::InsertConcurrently(KeyHandle handle) {
+  auto* key = static_cast<char*>(handle);
+  auto transformed = transform_->Transform(UserKey(key));
+  auto bucket = GetInitializedBucket(transformed);
+  bucket->InsertConcurrently(key);
+}
+
 bool HashSkipListRep::Contains(const char* key) const {
   auto transformed = transform_->Transform(UserKey(key));
   auto bucket = GetBucket(transformed);
@@ -368,6 +383,8 @@ class HashSkipListRepFactory : public MemTableRepFactory {
   const char* Name() const override { return kClassName(); }
   const char* NickName() const override { return kNickName(); }
 
+  bool IsInsertConcurrentlySupported() const override { return true; }
+
  private:
   HashSkipListRepOptions options_;
 };
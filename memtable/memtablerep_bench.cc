@@ -25,6 +25,7 @@ int main() {
 #include "db/dbformat.h"
 #include "db/memtable.h"
 #include "memory/arena.h"
+#include "memory/concurrent_arena.h"
 #include "port/port.h"
 #include "port/stack_trace.h"
 #include "rocksdb/comparator.h"
@@ -47,6 +48,9 @@ DEFINE_string(benchmarks, "fillrandom",
               "Comma-separated list of benchmarks to run. Options:\n"
               "\tfillrandom             -- write N random values\n"
               "\tfillseq                -- write N values in sequential order\n"
+              "\tfillconcurrent         -- N threads write random values\n"
+              "\t                          concurrently, needs a memtablerep\n"
+              "\t                          that supports concurrent inserts\n"
               "\treadrandom             -- read N values in random order\n"
               "\treadseq                -- scan the DB\n"
               "\treadwrite              -- 1 thread writes while N - 1 threads "
@@ -63,6 +67,7 @@ DEFINE_string(memtablerep, "skiplist",
               "\tvector              -- backed by an std::vector\n"
               "\thashskiplist        -- backed by a hash skip list\n"
               "\thashlinklist        -- backed by a hash linked list\n"
+              "\tbtree               -- backed by a B+-tree\n"
               "\tcuckoo              -- backed by a cuckoo hash table");
 
 DEFINE_int64(bucket_count, 1000000,
@@ -99,7 +104,7 @@ DEFINE_int64(write_buffer_size, 256,
 DEFINE_int32(
     num_threads, 1,
     "Number of concurrent threads to run. If the benchmark includes writes,\n"
-    "then at most one thread will be a writer");
+    "then at most one thread will be a writer, except for fillconcurrent");
 
 DEFINE_int32(num_operations, 1000000,
              "Number of operations to do for write and random read benchmarks");
@@ -234,7 +239,9 @@ class FillBenchmarkThread : public BenchmarkThread {
       : BenchmarkThread(table, key_gen, bytes_written, bytes_read, sequence,
                         num_ops, read_hits) {}
 
-  void FillOne() {
+  void FillOne() { FillOne(++(*sequence_), false /* concurrently */); }
+
+  void FillOne(uint64_t sequence, bool concurrently) {
     char* buf = nullptr;
     auto internal_key_size = 16;
     auto encoded_len =
@@ -245,13 +252,17 @@ class FillBenchmarkThread : public BenchmarkThread {
     auto key = key_gen_->Next();
     EncodeFixed64(p, key);
     p += 8;
-    EncodeFixed64(p, ++(*sequence_));
+    EncodeFixed64(p, sequence);
     p += 8;
     Slice bytes = generator_.Generate(FLAGS_item_size);
     memcpy(p, bytes.data(), FLAGS_item_size);
     p += FLAGS_item_size;
     assert(p == buf + encoded_len);
-    table_->Insert(handle);
+    if (concurrently) {
+      table_->InsertConcurrently(handle);
+    } else {
+      table_->Insert(handle);
+    }
     *bytes_written_ += encoded_len;
   }
 
@@ -286,6 +297,27 @@ class ConcurrentFillBenchmarkThread : public FillBenchmarkThread {
   std::atomic_int* threads_done_;
 };
 
+class ConcurrentInsertBenchmarkThread : public FillBenchmarkThread {
+ public:
+  ConcurrentInsertBenchmarkThread(MemTableRep* table, KeyGenerator* key_gen,
+                                  uint64_t* bytes_written, uint64_t* bytes_read,
+                                  std::atomic<uint64_t>* sequence,
+                                  uint64_t num_ops, uint64_t* read_hits)
+      : FillBenchmarkThread(table, key_gen, bytes_written, bytes_read,
+                            nullptr /* sequence */, num_ops, read_hits),
+        atomic_sequence_(sequence) {}
+
+  void operator()() override {
+    for (unsigned int i = 0; i < num_ops_; ++i) {
+      FillOne(atomic_sequence_->fetch_add(1, std::memory_order_relaxed) + 1,
+              true /* concurrently */);
+    }
+  }
+
+ private:
+  std::atomic<uint64_t>* atomic_sequence_;
+};
+
 class ReadBenchmarkThread : public BenchmarkThread {
  public:
   ReadBenchmarkThread(MemTableRep* table, KeyGenerator* key_gen,
@@ -475,6 +507,42 @@ class FillBenchmark : public Benchmark {
   }
 };
 
+class ConcurrentFillBenchmark : public Benchmark {
+ public:
+  explicit ConcurrentFillBenchmark(MemTableRep* table, uint64_t* sequence)
+      : Benchmark(table, nullptr, sequence, FLAGS_num_threads) {
+    num_write_ops_per_thread_ = FLAGS_num_operations / FLAGS_num_threads;
+  }
+
+  void RunThreads(std::vector<port::Thread>* threads, uint64_t* bytes_written,
+                  uint64_t* bytes_read, bool /*write*/,
+                  uint64_t* read_hits) override {
+    // Key generators and byte counters are not thread-safe, so every thread
+    // gets its own.
+    std::vector<std::unique_ptr<Random64>> rands;
+    std::vector<std::unique_ptr<KeyGenerator>> key_gens;
+    std::vector<uint64_t> thread_bytes_written(FLAGS_num_threads, 0);
+    std::atomic<uint64_t> sequence(*sequence_);
+    for (int i = 0; i < FLAGS_num_threads; ++i) {
+      rands.emplace_back(new Random64(FLAGS_seed + i));
+      key_gens.emplace_back(new KeyGenerator(rands.back().get(), RANDOM,
+                                             FLAGS_num_operations));
+    }
+    for (int i = 0; i < FLAGS_num_threads; ++i) {
+      threads->emplace_back(ConcurrentInsertBenchmarkThread(
+          table_, key_gens[i].get(), &thread_bytes_written[i], bytes_read,
+          &sequence, num_write_ops_per_thread_, read_hits));
+    }
+    for (auto& thread : *threads) {
+      thread.join();
+    }
+    for (auto thread_bytes : thread_bytes_written) {
+      *bytes_written += thread_bytes;
+    }
+    *sequence_ = sequence.load();
+  }
+};
+
 class ReadBenchmark : public Benchmark {
  public:
   explicit ReadBenchmark(MemTableRep* table, KeyGenerator* key_gen,
@@ -612,7 +680,7 @@ int main(int argc, char** argv) {
   ROCKSDB_NAMESPACE::InternalKeyComparator internal_key_comp(
       ROCKSDB_NAMESPACE::BytewiseComparator());
   ROCKSDB_NAMESPACE::MemTable::KeyComparator key_comp(internal_key_comp);
-  ROCKSDB_NAMESPACE::Arena arena;
+  ROCKSDB_NAMESPACE::ConcurrentArena arena;
   ROCKSDB_NAMESPACE::WriteBufferManager wb(FLAGS_write_buffer_size);
   uint64_t sequence;
   auto createMemtableRep = [&] {
@@ -648,6 +716,15 @@ int main(int argc, char** argv) {
           &rng, ROCKSDB_NAMESPACE::UNIQUE_RANDOM, FLAGS_num_operations));
       benchmark.reset(new ROCKSDB_NAMESPACE::FillBenchmark(
           memtablerep.get(), key_gen.get(), &sequence));
+    } else if (name == ROCKSDB_NAMESPACE::Slice("fillconcurrent")) {
+      if (!factory->IsInsertConcurrentlySupported()) {
+        std::cout << "WARNING: skipping fillconcurrent, " << factory->Name()
+                  << " doesn't support concurrent inserts" << std::endl;
+        continue;
+      }
+      memtablerep.reset(createMemtableRep());
+      benchmark.reset(new ROCKSDB_NAMESPACE::ConcurrentFillBenchmark(
+          memtablerep.get(), &sequence));
     } else if (name == ROCKSDB_NAMESPACE::Slice("readrandom")) {
       key_gen.reset(new ROCKSDB_NAMESPACE::KeyGenerator(
           &rng, ROCKSDB_NAMESPACE::RANDOM, FLAGS_num_operations));
@@ -10,7 +10,8 @@
 // Thread safety
 // -------------
 //
-// Writes require external synchronization, most likely a mutex.
+// Writes require external synchronization, most likely a mutex, except
+// that InsertConcurrently() may be called concurrently with itself.
 // Reads require a guarantee that the SkipList will not be destroyed
 // while the read is in progress.  Apart from that, reads progress
 // without any internal locking or synchronization.
@@ -61,6 +62,12 @@ class SkipList {
   // REQUIRES: nothing that compares equal to key is currently in the list.
   void Insert(const Key& key);
 
+  // Like Insert(), but external synchronization is not required between
+  // concurrent calls of InsertConcurrently(). Insert() must not run at the
+  // same time as InsertConcurrently(), but the two can be mixed otherwise.
+  // REQUIRES: nothing that compares equal to key is currently in the list.
+  void InsertConcurrently(const Key& key);
+
   // Returns true iff an entry that compares equal to key is in the list.
   bool Contains(const Key& key) const;
 
@@ -115,6 +122,8 @@ class SkipList {
   };
 
  private:
+  static const uint16_t kMaxPossibleHeight = 32;
+
   const uint16_t kMaxHeight_;
   const uint16_t kBranching_;
   const uint32_t kScaledInverseBranching_;
@@ -135,6 +144,10 @@ class SkipList {
   // insertion, in which case max_height_ and prev_height_ are 1.
   Node** prev_;
   int32_t prev_height_;
+  // False if InsertConcurrently() has modified the list since prev_ was
+  // last computed, in which case prev_[1..] may no longer be adjacent to
+  // prev_[0] and Insert() can't take its sequential fast path.
+  std::atomic<bool> prev_valid_;
 
   inline int GetMaxHeight() const {
     return max_height_.load(std::memory_order_relaxed);
@@ -160,6 +173,12 @@ class SkipList {
   // level in [0..max_height_-1], if prev is non-null.
   Node* FindLessThan(const Key& key, Node** prev = nullptr) const;
 
+  // Starting from `before` (which must be before key), traverses level
+  // `level` and returns the neighbors bracketing key in *out_prev and
+  // *out_next.
+  void FindSpliceForLevel(const Key& key, Node* before, int level,
+                          Node** out_prev, Node** out_next) const;
+
   // Return the last node in the list.
   // Return head_ if list is empty.
   Node* FindLast() const;
@@ -197,6 +216,11 @@ struct SkipList<Key, Comparator>::Node {
     next_[n].store(x, std::memory_order_relaxed);
   }
 
+  bool CASNext(int n, Node* expected, Node* x) {
+    assert(n >= 0);
+    return next_[n].compare_exchange_strong(expected, x);
+  }
+
  private:
   // Array of length equal to the node height.  next_[0] is lowest level link.
   std::atomic<Node*> next_[1];
@@ -362,6 +386,25 @@ SkipList<Key, Comparator>::FindLessThan(const Key& key, Node** prev) const {
   }
 }
 
+template <typename Key, class Comparator>
+void SkipList<Key, Comparator>::FindSpliceForLevel(const Key& key,
+                                                   Node* before, int level,
+                                                   Node** out_prev,
+                                                   Node** out_next) const {
+  while (true) {
+    Node* next = before->Next(level);
+    assert(before == head_ || next == nullptr ||
+           KeyIsAfterNode(next->key, before));
+    assert(before == head_ || KeyIsAfterNode(key, before));
+    if (!KeyIsAfterNode(key, next)) {
+      *out_prev = before;
+      *out_next = next;
+      return;
+    }
+    before = next;
+  }
+}
+
 template <typename Key, class Comparator>
 typename SkipList<Key, Comparator>::Node* SkipList<Key, Comparator>::FindLast()
     const {
@@ -417,8 +460,10 @@ SkipList<Key, Comparator>::SkipList(const Comparator cmp, Allocator* allocator,
       allocator_(allocator),
       head_(NewNode(0 /* any key will do */, max_height)),
       max_height_(1),
-      prev_height_(1) {
+      prev_height_(1),
+      prev_valid_(true) {
   assert(max_height > 0 && kMaxHeight_ == static_cast<uint32_t>(max_height));
+  assert(max_height <= kMaxPossibleHeight);
   assert(branching_factor > 0 &&
          kBranching_ == static_cast<uint32_t>(branching_factor));
   assert(kScaledInverseBranching_ > 0);
@@ -436,7 +481,8 @@ SkipList<Key, Comparator>::SkipList(const Comparator cmp, Allocator* allocator,
 template <typename Key, class Comparator>
 void SkipList<Key, Comparator>::Insert(const Key& key) {
   // fast path for sequential insertion
-  if (!KeyIsAfterNode(key, prev_[0]->NoBarrier_Next(0)) &&
+  if (prev_valid_.load(std::memory_order_relaxed) &&
+      !KeyIsAfterNode(key, prev_[0]->NoBarrier_Next(0)) &&
       (prev_[0] == head_ || KeyIsAfterNode(key, prev_[0]))) {
     assert(prev_[0] != head_ || (prev_height_ == 1 && GetMaxHeight() == 1));
 
@@ -483,6 +529,52 @@ void SkipList<Key, Comparator>::Insert(const Key& key) {
   }
   prev_[0] = x;
   prev_height_ = height;
+  prev_valid_.store(true, std::memory_order_relaxed);
+}
+
+template <typename Key, class Comparator>
+void SkipList<Key, Comparator>::InsertConcurrently(const Key& key) {
+  if (prev_valid_.load(std::memory_order_relaxed)) {
+    prev_valid_.store(false, std::memory_order_relaxed);
+  }
+
+  int height = RandomHeight();
+  int max_height = GetMaxHeight();
+  while (height > max_height) {
+    if (max_height_.compare_exchange_weak(max_height, height)) {
+      // successfully updated it
+      max_height = height;
+      break;
+    }
+    // else retry, possibly exiting the loop because somebody else
+    // increased it
+  }
+
+  // Nodes are only ever added, so a splice computed top-down stays ordered
+  // even if it becomes stale; a failed CAS below just narrows it again.
+  Node* prev[kMaxPossibleHeight];
+  Node* next[kMaxPossibleHeight];
+  Node* before = head_;
+  for (int i = max_height - 1; i >= 0; --i) {
+    FindSpliceForLevel(key, before, i, &prev[i], &next[i]);
+    before = prev[i];
+  }
+
+  // Our data structure does not allow duplicate insertion
+  assert(next[0] == nullptr || !Equal(key, next[0]->key));
+
+  Node* x = NewNode(key, height);
+  for (int i = 0; i < height; ++i) {
+    while (true) {
+      x->NoBarrier_SetNext(i, next[i]);
+      if (prev[i]->CASNext(i, next[i], x)) {
+        break;
+      }
+      // CAS failed because somebody inserted after prev[i], redo the search
+      // of this level from there.
+      FindSpliceForLevel(key, prev[i], i, &prev[i], &next[i]);
+    }
+  }
 }
 
 template <typename Key, class Comparator>
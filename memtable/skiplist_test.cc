@@ -12,6 +12,8 @@
 #include <set>
 
 #include "memory/arena.h"
+#include "memory/concurrent_arena.h"
+#include "port/port.h"
 #include "rocksdb/env.h"
 #include "test_util/testharness.h"
 #include "util/hash.h"
@@ -138,6 +140,55 @@ TEST_F(SkipTest, InsertAndLookup) {
   }
 }
 
+TEST_F(SkipTest, InsertConcurrently) {
+  const int kNumThreads = 4;
+  const int kNumKeysPerThread = 5000;
+  const Key kKeysPerRound = kNumThreads * kNumKeysPerThread;
+  Random rnd(301);
+  std::set<Key> keys;
+  ConcurrentArena arena;
+  TestComparator cmp;
+  SkipList<Key, TestComparator> list(cmp, &arena);
+
+  // Alternate concurrent and single-threaded phases, like the memtable does
+  // depending on the size of the write group. Concurrent inserts use even
+  // keys and single-threaded ones odd keys in between them.
+  for (int round = 0; round < 3; round++) {
+    const Key base = round * kKeysPerRound;
+    std::vector<port::Thread> threads;
+    for (int t = 0; t < kNumThreads; t++) {
+      threads.emplace_back([&, t]() {
+        for (int i = 0; i < kNumKeysPerThread; i++) {
+          list.InsertConcurrently((base + i * kNumThreads + t) * 2);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    for (Key k = base; k < base + kKeysPerRound; k++) {
+      keys.insert(k * 2);
+    }
+
+    for (int i = 0; i < 100; i++) {
+      Key key = rnd.Uniform(static_cast<int>(base + kKeysPerRound)) * 2 + 1;
+      if (keys.insert(key).second) {
+        list.Insert(key);
+      }
+    }
+  }
+
+  SkipList<Key, TestComparator>::Iterator iter(&list);
+  iter.SeekToFirst();
+  for (Key key : keys) {
+    ASSERT_TRUE(iter.Valid());
+    ASSERT_EQ(key, iter.key());
+    ASSERT_TRUE(list.Contains(key));
+    iter.Next();
+  }
+  ASSERT_FALSE(iter.Valid());
+}
+
 // We want to make sure that with a single writer and multiple
 // concurrent readers (with no synchronization other than when a
 // reader's iterator is created), the reader always observes all the
@@ -0,0 +1,296 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmarks for seeking in cached data blocks, comparing the plain
+// restart point binary search with the one narrowed by restart key prefixes
+// (BlockBasedTableOptions::restart_key_prefix_seek), and for point lookups
+// with different index types, including the learned index
+// (BlockBasedTableOptions::kLearnedIndexSearch).
+
+#ifndef OS_WIN
+#include <unistd.h>
+#endif  // ! OS_WIN
+
+#include "benchmark/benchmark.h"
+#include "db/dbformat.h"
+#include "file/filename.h"
+#include "rocksdb/cache.h"
+#include "rocksdb/db.h"
+#include "rocksdb/options.h"
+#include "rocksdb/table.h"
+#include "table/block_based/block.h"
+#include "table/block_based/block_builder.h"
+#include "util/coding.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Returns a 16 byte user key for `k`. With `shared_prefix_len` > 0, that many
+// leading bytes are the same for all keys, which defeats the prefix filtering
+// and measures its overhead.
+static std::string BenchKey(uint64_t k, int shared_prefix_len) {
+  std::string key(static_cast<size_t>(shared_prefix_len), 'k');
+  char buf[sizeof(uint64_t)];
+  // Big-endian so that bytewise order matches numeric order.
+  for (int i = 0; i < 8; ++i) {
+    buf[i] = static_cast<char>((k >> (56 - 8 * i)) & 0xff);
+  }
+  key.append(buf, sizeof(buf));
+  key.resize(16, 'p');
+  return key;
+}
+
+// benchmark arguments:
+// 0. number of entries in the block
+// 1. restart interval
+// 2. length of the prefix shared by all keys
+// 3. whether restart key prefixes are used
+static void BlockSeekArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t num_entries : {64, 256, 1024}) {
+    for (int64_t restart_interval : {1, 4, 16}) {
+      for (int64_t shared_prefix_len : {0, 8}) {
+        for (bool use_prefixes : {false, true}) {
+          b->Args({num_entries, restart_interval, shared_prefix_len,
+                   use_prefixes});
+        }
+      }
+    }
+  }
+  b->ArgNames({"num_entries", "restart_interval", "shared_prefix_len",
+               "use_prefixes"});
+}
+
+static void BlockSeek(benchmark::State& state) {
+  const int num_entries = static_cast<int>(state.range(0));
+  const int restart_interval = static_cast<int>(state.range(1));
+  const int shared_prefix_len = static_cast<int>(state.range(2));
+  const bool use_prefixes = state.range(3);
+
+  Random rnd(301);
+  BlockBuilder builder(restart_interval);
+  std::vector<std::string> keys;
+  for (int i = 0; i < num_entries; i++) {
+    // Spread keys over the whole key space so that their first bytes differ.
+    std::string key = BenchKey(
+        (static_cast<uint64_t>(i) << 48) + rnd.Next(), shared_prefix_len);
+    AppendInternalKeyFooter(&key, 0 /* seqno */, kTypeValue);
+    builder.Add(key, rnd.RandomString(100));
+    keys.emplace_back(std::move(key));
+  }
+  Slice rawblock = builder.Finish();
+  Block reader{BlockContents(rawblock)};
+  if (use_prefixes) {
+    reader.InitializeRestartKeyPrefixes(BytewiseComparator(),
+                                        true /* key_includes_seq */,
+                                        true /* value_is_full */);
+    if (reader.TEST_GetRestartKeyPrefixes() == nullptr) {
+      state.SkipWithError("failed to build restart key prefixes");
+      return;
+    }
+  }
+
+  DataBlockIter iter;
+  reader.NewDataIterator(BytewiseComparator(), kDisableGlobalSequenceNumber,
+                         &iter);
+  size_t not_found = 0;
+  for (auto _ : state) {
+    const std::string& target = keys[rnd.Uniform(num_entries)];
+    iter.Seek(target);
+    if (!iter.Valid() || iter.key() != Slice(target)) {
+      not_found++;
+    }
+  }
+  if (not_found > 0) {
+    state.SkipWithError("key not found");
+  }
+}
+
+BENCHMARK(BlockSeek)->Apply(BlockSeekArguments);
+
+// benchmark arguments:
+// 0. restart interval
+// 1. whether restart_key_prefix_seek is enabled
+static void DBGetCachedArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t restart_interval : {4, 16}) {
+    for (bool restart_key_prefix_seek : {false, true}) {
+      b->Args({restart_interval, restart_key_prefix_seek});
+    }
+  }
+  b->ArgNames({"restart_interval", "restart_key_prefix_seek"});
+}
+
+static void DBGetCached(benchmark::State& state) {
+  const uint64_t kNumKeys = 200000;
+  static std::unique_ptr<DB> db;
+  Options options;
+  options.create_if_missing = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_restart_interval = static_cast<int>(state.range(0));
+  table_options.restart_key_prefix_seek = state.range(1);
+  table_options.block_cache = NewLRUCache(256 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  Random rnd(301 + state.thread_index());
+  if (state.thread_index() == 0) {
+    std::string db_path;
+    Status s = Env::Default()->GetTestDirectory(&db_path);
+    std::string db_name = db_path + kFilePathSeparator + "DBGetCached" +
+                          std::to_string(getpid());
+    DestroyDB(db_name, options);
+    DB* db_ptr = nullptr;
+    if (s.ok()) {
+      s = DB::Open(options, db_name, &db_ptr);
+    }
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      return;
+    }
+    db.reset(db_ptr);
+
+    WriteOptions wo;
+    wo.disableWAL = true;
+    for (uint64_t i = 0; i < kNumKeys && s.ok(); i++) {
+      s = db->Put(wo, BenchKey(i << 40, 0), rnd.RandomString(100));
+    }
+    if (s.ok()) {
+      s = db->CompactRange(CompactRangeOptions(), nullptr, nullptr);
+    }
+    // Warm the block cache so the measured lookups only touch cached blocks.
+    std::string value;
+    for (uint64_t i = 0; i < kNumKeys && s.ok(); i++) {
+      s = db->Get(ReadOptions(), BenchKey(i << 40, 0), &value);
+    }
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+  }
+
+  ReadOptions ro;
+  size_t not_found = 0;
+  std::string value;
+  for (auto _ : state) {
+    uint64_t k = rnd.Uniform(static_cast<int>(kNumKeys));
+    Status s = db->Get(ro, BenchKey(k << 40, 0), &value);
+    if (s.IsNotFound()) {
+      not_found++;
+    }
+  }
+  state.counters["neg_qu_pct"] = benchmark::Counter(
+      static_cast<double>(not_found * 100), benchmark::Counter::kAvgIterations);
+
+  if (state.thread_index() == 0) {
+    std::string db_name = db->GetName();
+    Status s = db->Close();
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+    db.reset();
+    DestroyDB(db_name, options);
+  }
+}
+
+BENCHMARK(DBGetCached)
+    ->Threads(1)
+    ->Iterations(1000000)
+    ->Apply(DBGetCachedArguments);
+
+// benchmark arguments:
+// 0. BlockBasedTableOptions::IndexType
+static void DBGetIndexTypeArguments(benchmark::internal::Benchmark* b) {
+  for (auto index_type : {BlockBasedTableOptions::kBinarySearch,
+                          BlockBasedTableOptions::kTwoLevelIndexSearch,
+                          BlockBasedTableOptions::kLearnedIndexSearch}) {
+    b->Args({static_cast<int64_t>(index_type)});
+  }
+  b->ArgNames({"index_type"});
+}
+
+static void DBGetIndexType(benchmark::State& state) {
+  const uint64_t kNumKeys = 200000;
+  static std::unique_ptr<DB> db;
+  Options options;
+  options.create_if_missing = true;
+  BlockBasedTableOptions table_options;
+  table_options.index_type =
+      static_cast<BlockBasedTableOptions::IndexType>(state.range(0));
+  // Small blocks for large index blocks
+  table_options.block_size = 256;
+  table_options.block_cache = NewLRUCache(256 << 20);
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  Random rnd(301 + state.thread_index());
+  if (state.thread_index() == 0) {
+    std::string db_path;
+    Status s = Env::Default()->GetTestDirectory(&db_path);
+    std::string db_name = db_path + kFilePathSeparator + "DBGetIndexType" +
+                          std::to_string(getpid());
+    DestroyDB(db_name, options);
+    DB* db_ptr = nullptr;
+    if (s.ok()) {
+      s = DB::Open(options, db_name, &db_ptr);
+    }
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      return;
+    }
+    db.reset(db_ptr);
+
+    WriteOptions wo;
+    wo.disableWAL = true;
+    for (uint64_t i = 0; i < kNumKeys && s.ok(); i++) {
+      s = db->Put(wo, BenchKey(i << 40, 0), rnd.RandomString(100));
+    }
+    if (s.ok()) {
+      s = db->CompactRange(CompactRangeOptions(), nullptr, nullptr);
+    }
+    // Warm the block cache so the measured lookups only touch cached blocks.
+    std::string value;
+    for (uint64_t i = 0; i < kNumKeys && s.ok(); i++) {
+      s = db->Get(ReadOptions(), BenchKey(i << 40, 0), &value);
+    }
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+  }
+
+  ReadOptions ro;
+  size_t not_found = 0;
+  std::string value;
+  for (auto _ : state) {
+    uint64_t k = rnd.Uniform(static_cast<int>(kNumKeys));
+    Status s = db->Get(ro, BenchKey(k << 40, 0), &value);
+    if (s.IsNotFound()) {
+      not_found++;
+    }
+  }
+  state.counters["neg_qu_pct"] = benchmark::Counter(
+      static_cast<double>(not_found * 100), benchmark::Counter::kAvgIterations);
+
+  if (state.thread_index() == 0) {
+    // Indexes and models not in the block cache are held by table readers
+    uint64_t table_readers_mem = 0;
+    db->GetIntProperty(DB::Properties::kEstimateTableReadersMem,
+                       &table_readers_mem);
+    state.counters["table_readers_mem"] =
+        static_cast<double>(table_readers_mem);
+
+    std::string db_name = db->GetName();
+    Status s = db->Close();
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+    db.reset();
+    DestroyDB(db_name, options);
+  }
+}
+
+BENCHMARK(DBGetIndexType)
+    ->Threads(1)
+    ->Iterations(1000000)
+    ->Apply(DBGetIndexTypeArguments);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+// Micro-benchmarks for pessimistic transactions contending on point locks,
+// where transactions waiting for different keys of the same lock stripe used
+// to wake each other up.
+
+#ifndef OS_WIN
+#include <unistd.h>
+#endif  // ! OS_WIN
+
+#include "benchmark/benchmark.h"
+#include "file/filename.h"
+#include "rocksdb/db.h"
+#include "rocksdb/options.h"
+#include "rocksdb/utilities/transaction_db.h"
+#include "util/random.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// benchmark arguments:
+// 0. number of keys all transactions pick from
+// 1. number of lock stripes
+static void LockContentionArguments(benchmark::internal::Benchmark* b) {
+  for (int64_t num_keys : {1, 16, 1024}) {
+    for (int64_t num_stripes : {1, 16}) {
+      b->Args({num_keys, num_stripes});
+    }
+  }
+  b->ArgNames({"num_keys", "num_stripes"});
+}
+
+static void LockContention(benchmark::State& state) {
+  static std::unique_ptr<TransactionDB> db;
+  const int num_keys = static_cast<int>(state.range(0));
+  Options options;
+  options.create_if_missing = true;
+  TransactionDBOptions txn_db_options;
+  txn_db_options.num_stripes = static_cast<size_t>(state.range(1));
+
+  if (state.thread_index() == 0) {
+    std::string db_path;
+    Status s = Env::Default()->GetTestDirectory(&db_path);
+    std::string db_name = db_path + kFilePathSeparator + "LockContention" +
+                          std::to_string(getpid());
+    DestroyDB(db_name, options);
+    TransactionDB* db_ptr = nullptr;
+    if (s.ok()) {
+      s = TransactionDB::Open(options, txn_db_options, db_name, &db_ptr);
+    }
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+      return;
+    }
+    db.reset(db_ptr);
+  }
+
+  Random rnd(301 + state.thread_index());
+  WriteOptions wo;
+  wo.disableWAL = true;
+  TransactionOptions txn_options;
+  txn_options.lock_timeout = 10000;
+  std::string value;
+  size_t num_failed = 0;
+  for (auto _ : state) {
+    std::unique_ptr<Transaction> txn(db->BeginTransaction(wo, txn_options));
+    std::string key = "key" + std::to_string(rnd.Uniform(num_keys));
+    Status s = txn->GetForUpdate(ReadOptions(), key, &value);
+    if (s.ok() || s.IsNotFound()) {
+      s = txn->Put(key, rnd.RandomString(16));
+    }
+    if (s.ok()) {
+      s = txn->Commit();
+    }
+    if (!s.ok()) {
+      num_failed++;
+      txn->Rollback().PermitUncheckedError();
+    }
+  }
+  if (num_failed > 0) {
+    state.SkipWithError("transaction failed");
+  }
+
+  if (state.thread_index() == 0) {
+    std::string db_name = db->GetName();
+    Status s = db->Close();
+    if (!s.ok()) {
+      state.SkipWithError(s.ToString().c_str());
+    }
+    db.reset();
+    DestroyDB(db_name, options);
+  }
+}
+
+BENCHMARK(LockContention)
+    ->Threads(1)
+    ->Threads(8)
+    ->Threads(32)
+    ->Apply(LockContentionArguments);
+
+}  // namespace ROCKSDB_NAMESPACE
+
+BENCHMARK_MAIN();
@@ -170,6 +170,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    use_direct_io_for_flush_and_compaction),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"use_async_io_for_writes",
+         {offsetof(struct ImmutableDBOptions, use_async_io_for_writes),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"allow_2pc",
          {offsetof(struct ImmutableDBOptions, allow_2pc), OptionType::kBoolean,
           OptionVerificationType::kNormal, OptionTypeFlags::kNone}},
@@ -221,6 +225,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, flush_verify_memtable_count),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"max_flush_partitions",
+         {offsetof(struct ImmutableDBOptions, max_flush_partitions),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"compaction_verify_record_count",
          {offsetof(struct ImmutableDBOptions, compaction_verify_record_count),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -264,6 +272,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, max_file_opening_threads),
           OptionType::kInt, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"open_files_in_background",
+         {offsetof(struct ImmutableDBOptions, open_files_in_background),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"table_cache_numshardbits",
          {offsetof(struct ImmutableDBOptions, table_cache_numshardbits),
           OptionType::kInt, OptionVerificationType::kNormal,
@@ -306,6 +318,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, WAL_ttl_seconds),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"max_manifest_space_amp_pct",
+         {offsetof(struct ImmutableDBOptions, max_manifest_space_amp_pct),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"max_manifest_file_size",
          {offsetof(struct ImmutableDBOptions, max_manifest_file_size),
           OptionType::kUInt64T, OptionVerificationType::kNormal,
@@ -322,6 +338,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct ImmutableDBOptions, enable_pipelined_write),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"parallel_wal_checksum",
+         {offsetof(struct ImmutableDBOptions, parallel_wal_checksum),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"unordered_write",
          {offsetof(struct ImmutableDBOptions, unordered_write),
           OptionType::kBoolean, OptionVerificationType::kNormal,
@@ -334,6 +354,14 @@ static std::unordered_map<std::string, OptionTypeInfo>
          OptionTypeInfo::Enum<WALRecoveryMode>(
              offsetof(struct ImmutableDBOptions, wal_recovery_mode),
              &wal_recovery_mode_string_map)},
+        {"wal_recovery_threads",
+         {offsetof(struct ImmutableDBOptions, wal_recovery_threads),
+          OptionType::kInt, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
+        {"row_cache_admission_threshold",
+         {offsetof(struct ImmutableDBOptions, row_cache_admission_threshold),
+          OptionType::kUInt32T, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"enable_write_thread_adaptive_yield",
          {offsetof(struct ImmutableDBOptions,
                    enable_write_thread_adaptive_yield),
@@ -697,6 +725,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       error_if_exists(options.error_if_exists),
       paranoid_checks(options.paranoid_checks),
       flush_verify_memtable_count(options.flush_verify_memtable_count),
+      max_flush_partitions(options.max_flush_partitions),
       compaction_verify_record_count(options.compaction_verify_record_count),
       track_and_verify_wals_in_manifest(
           options.track_and_verify_wals_in_manifest),
@@ -708,6 +737,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       info_log(options.info_log),
       info_log_level(options.info_log_level),
       max_file_opening_threads(options.max_file_opening_threads),
+      open_files_in_background(options.open_files_in_background),
       statistics(options.statistics),
       use_fsync(options.use_fsync),
       db_paths(options.db_paths),
@@ -718,6 +748,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       keep_log_file_num(options.keep_log_file_num),
       recycle_log_file_num(options.recycle_log_file_num),
       max_manifest_file_size(options.max_manifest_file_size),
+      max_manifest_space_amp_pct(options.max_manifest_space_amp_pct),
       table_cache_numshardbits(options.table_cache_numshardbits),
       WAL_ttl_seconds(options.WAL_ttl_seconds),
       WAL_size_limit_MB(options.WAL_size_limit_MB),
@@ -729,6 +760,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       use_direct_reads(options.use_direct_reads),
       use_direct_io_for_flush_and_compaction(
           options.use_direct_io_for_flush_and_compaction),
+      use_async_io_for_writes(options.use_async_io_for_writes),
       allow_fallocate(options.allow_fallocate),
       is_fd_close_on_exec(options.is_fd_close_on_exec),
       advise_random_on_open(options.advise_random_on_open),
@@ -739,6 +771,7 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       listeners(options.listeners),
       enable_thread_tracking(options.enable_thread_tracking),
       enable_pipelined_write(options.enable_pipelined_write),
+      parallel_wal_checksum(options.parallel_wal_checksum),
       unordered_write(options.unordered_write),
       allow_concurrent_memtable_write(options.allow_concurrent_memtable_write),
       enable_write_thread_adaptive_yield(
@@ -749,8 +782,10 @@ ImmutableDBOptions::ImmutableDBOptions(const DBOptions& options)
       skip_checking_sst_file_sizes_on_db_open(
           options.skip_checking_sst_file_sizes_on_db_open),
       wal_recovery_mode(options.wal_recovery_mode),
+      wal_recovery_threads(options.wal_recovery_threads),
       allow_2pc(options.allow_2pc),
       row_cache(options.row_cache),
+      row_cache_admission_threshold(options.row_cache_admission_threshold),
       wal_filter(options.wal_filter),
       fail_if_options_file_error(options.fail_if_options_file_error),
       dump_malloc_stats(options.dump_malloc_stats),
@@ -794,6 +829,9 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    paranoid_checks);
   ROCKS_LOG_HEADER(log, "            Options.flush_verify_memtable_count: %d",
                    flush_verify_memtable_count);
+  ROCKS_LOG_HEADER(log,
+                   "                   Options.max_flush_partitions: %" PRIu32,
+                   max_flush_partitions);
   ROCKS_LOG_HEADER(log, "         Options.compaction_verify_record_count: %d",
                    compaction_verify_record_count);
   ROCKS_LOG_HEADER(log,
@@ -810,6 +848,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    info_log.get());
   ROCKS_LOG_HEADER(log, "               Options.max_file_opening_threads: %d",
                    max_file_opening_threads);
+  ROCKS_LOG_HEADER(log, "               Options.open_files_in_background: %d",
+                   open_files_in_background);
   ROCKS_LOG_HEADER(log, "                             Options.statistics: %p",
                    stats);
   if (stats) {
@@ -825,6 +865,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
   ROCKS_LOG_HEADER(log,
                    "                 Options.max_manifest_file_size: %" PRIu64,
                    max_manifest_file_size);
+  ROCKS_LOG_HEADER(log, "             Options.max_manifest_space_amp_pct: %d",
+                   max_manifest_space_amp_pct);
   ROCKS_LOG_HEADER(
       log, "                  Options.log_file_time_to_roll: %" ROCKSDB_PRIszt,
       log_file_time_to_roll);
@@ -846,6 +888,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
                    "                       "
                    "Options.use_direct_io_for_flush_and_compaction: %d",
                    use_direct_io_for_flush_and_compaction);
+  ROCKS_LOG_HEADER(log, "                Options.use_async_io_for_writes: %d",
+                   use_async_io_for_writes);
   ROCKS_LOG_HEADER(log, "         Options.create_missing_column_families: %d",
                    create_missing_column_families);
   ROCKS_LOG_HEADER(log, "                             Options.db_log_dir: %s",
@@ -888,10 +932,14 @@ void ImmutableDBOptions::Dump(Logger* log) const {
       sst_file_manager ? sst_file_manager->GetDeleteRateBytesPerSecond() : 0);
   ROCKS_LOG_HEADER(log, "                      Options.wal_recovery_mode: %d",
                    static_cast<int>(wal_recovery_mode));
+  ROCKS_LOG_HEADER(log, "                   Options.wal_recovery_threads: %d",
+                   wal_recovery_threads);
   ROCKS_LOG_HEADER(log, "                 Options.enable_thread_tracking: %d",
                    enable_thread_tracking);
   ROCKS_LOG_HEADER(log, "                 Options.enable_pipelined_write: %d",
                    enable_pipelined_write);
+  ROCKS_LOG_HEADER(log, "                  Options.parallel_wal_checksum: %d",
+                   parallel_wal_checksum);
   ROCKS_LOG_HEADER(log, "                 Options.unordered_write: %d",
                    unordered_write);
   ROCKS_LOG_HEADER(log, "        Options.allow_concurrent_memtable_write: %d",
@@ -913,6 +961,8 @@ void ImmutableDBOptions::Dump(Logger* log) const {
     ROCKS_LOG_HEADER(log,
                      "                              Options.row_cache: None");
   }
+  ROCKS_LOG_HEADER(log, "          Options.row_cache_admission_threshold: %u",
+                   row_cache_admission_threshold);
   ROCKS_LOG_HEADER(log, "                             Options.wal_filter: %s",
                    wal_filter ? wal_filter->Name() : "None");
 
@@ -25,6 +25,7 @@ struct ImmutableDBOptions {
   bool error_if_exists;
   bool paranoid_checks;
   bool flush_verify_memtable_count;
+  uint32_t max_flush_partitions;
   bool compaction_verify_record_count;
   bool track_and_verify_wals_in_manifest;
   bool verify_sst_unique_id_in_manifest;
@@ -34,6 +35,7 @@ struct ImmutableDBOptions {
   std::shared_ptr<Logger> info_log;
   InfoLogLevel info_log_level;
   int max_file_opening_threads;
+  bool open_files_in_background;
   std::shared_ptr<Statistics> statistics;
   bool use_fsync;
   std::vector<DbPath> db_paths;
@@ -47,6 +49,7 @@ struct ImmutableDBOptions {
   size_t keep_log_file_num;
   size_t recycle_log_file_num;
   uint64_t max_manifest_file_size;
+  int max_manifest_space_amp_pct;
   int table_cache_numshardbits;
   uint64_t WAL_ttl_seconds;
   uint64_t WAL_size_limit_MB;
@@ -56,6 +59,7 @@ struct ImmutableDBOptions {
   bool allow_mmap_writes;
   bool use_direct_reads;
   bool use_direct_io_for_flush_and_compaction;
+  bool use_async_io_for_writes;
   bool allow_fallocate;
   bool is_fd_close_on_exec;
   bool advise_random_on_open;
@@ -66,6 +70,7 @@ struct ImmutableDBOptions {
   std::vector<std::shared_ptr<EventListener>> listeners;
   bool enable_thread_tracking;
   bool enable_pipelined_write;
+  bool parallel_wal_checksum;
   bool unordered_write;
   bool allow_concurrent_memtable_write;
   bool enable_write_thread_adaptive_yield;
@@ -74,8 +79,10 @@ struct ImmutableDBOptions {
   bool skip_stats_update_on_db_open;
   bool skip_checking_sst_file_sizes_on_db_open;
   WALRecoveryMode wal_recovery_mode;
+  int wal_recovery_threads;
   bool allow_2pc;
   std::shared_ptr<Cache> row_cache;
+  uint32_t row_cache_admission_threshold;
   WalFilter* wal_filter;
   bool fail_if_options_file_error;
   bool dump_malloc_stats;
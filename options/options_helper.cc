@@ -63,6 +63,7 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.paranoid_checks = immutable_db_options.paranoid_checks;
   options.flush_verify_memtable_count =
       immutable_db_options.flush_verify_memtable_count;
+  options.max_flush_partitions = immutable_db_options.max_flush_partitions;
   options.compaction_verify_record_count =
       immutable_db_options.compaction_verify_record_count;
   options.track_and_verify_wals_in_manifest =
@@ -77,6 +78,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.max_open_files = mutable_db_options.max_open_files;
   options.max_file_opening_threads =
       immutable_db_options.max_file_opening_threads;
+  options.open_files_in_background =
+      immutable_db_options.open_files_in_background;
   options.max_total_wal_size = mutable_db_options.max_total_wal_size;
   options.statistics = immutable_db_options.statistics;
   options.use_fsync = immutable_db_options.use_fsync;
@@ -98,6 +101,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.keep_log_file_num = immutable_db_options.keep_log_file_num;
   options.recycle_log_file_num = immutable_db_options.recycle_log_file_num;
   options.max_manifest_file_size = immutable_db_options.max_manifest_file_size;
+  options.max_manifest_space_amp_pct =
+      immutable_db_options.max_manifest_space_amp_pct;
   options.table_cache_numshardbits =
       immutable_db_options.table_cache_numshardbits;
   options.WAL_ttl_seconds = immutable_db_options.WAL_ttl_seconds;
@@ -109,6 +114,8 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.use_direct_reads = immutable_db_options.use_direct_reads;
   options.use_direct_io_for_flush_and_compaction =
       immutable_db_options.use_direct_io_for_flush_and_compaction;
+  options.use_async_io_for_writes =
+      immutable_db_options.use_async_io_for_writes;
   options.allow_fallocate = immutable_db_options.allow_fallocate;
   options.is_fd_close_on_exec = immutable_db_options.is_fd_close_on_exec;
   options.stats_dump_period_sec = mutable_db_options.stats_dump_period_sec;
@@ -131,6 +138,7 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.enable_thread_tracking = immutable_db_options.enable_thread_tracking;
   options.delayed_write_rate = mutable_db_options.delayed_write_rate;
   options.enable_pipelined_write = immutable_db_options.enable_pipelined_write;
+  options.parallel_wal_checksum = immutable_db_options.parallel_wal_checksum;
   options.unordered_write = immutable_db_options.unordered_write;
   options.allow_concurrent_memtable_write =
       immutable_db_options.allow_concurrent_memtable_write;
@@ -147,8 +155,11 @@ DBOptions BuildDBOptions(const ImmutableDBOptions& immutable_db_options,
   options.skip_checking_sst_file_sizes_on_db_open =
       immutable_db_options.skip_checking_sst_file_sizes_on_db_open;
   options.wal_recovery_mode = immutable_db_options.wal_recovery_mode;
+  options.wal_recovery_threads = immutable_db_options.wal_recovery_threads;
   options.allow_2pc = immutable_db_options.allow_2pc;
   options.row_cache = immutable_db_options.row_cache;
+  options.row_cache_admission_threshold =
+      immutable_db_options.row_cache_admission_threshold;
   options.wal_filter = immutable_db_options.wal_filter;
   options.fail_if_options_file_error =
       immutable_db_options.fail_if_options_file_error;
@@ -1247,6 +1247,11 @@ TEST_F(OptionsTest, GetMemTableRepFactoryFromString) {
   ASSERT_NOK(GetMemTableRepFactoryFromString("vector:1024:invalid_opt",
                                              &new_mem_factory));
 
+  ASSERT_OK(GetMemTableRepFactoryFromString("btree", &new_mem_factory));
+  ASSERT_EQ(std::string(new_mem_factory->Name()), "BTreeRepFactory");
+  ASSERT_TRUE(new_mem_factory->IsInsertConcurrentlySupported());
+  ASSERT_NOK(GetMemTableRepFactoryFromString("btree:1024", &new_mem_factory));
+
   ASSERT_NOK(GetMemTableRepFactoryFromString("cuckoo", &new_mem_factory));
   // CuckooHash memtable is already removed.
   ASSERT_NOK(GetMemTableRepFactoryFromString("cuckoo:1024", &new_mem_factory));
@@ -9,6 +9,7 @@ LIB_SOURCES =                                                   \
   cache/clock_cache.cc                                          \
   cache/lru_cache.cc                                            \
   cache/compressed_secondary_cache.cc                           \
+  cache/log_structured_secondary_cache.cc                       \
   cache/secondary_cache.cc                                      \
   cache/secondary_cache_adapter.cc                              \
   cache/sharded_cache.cc                                        \
@@ -69,6 +70,7 @@ LIB_SOURCES =                                                   \
   db/flush_job.cc                                               \
   db/flush_scheduler.cc                                         \
   db/forward_iterator.cc                                        \
+  db/hot_key_tracker.cc                                         \
   db/import_column_family_job.cc                                \
   db/internal_stats.cc                                          \
   db/logs_with_prep_tracker.cc                                  \
@@ -96,6 +98,7 @@ LIB_SOURCES =                                                   \
   db/version_set.cc                                             \
   db/wal_edit.cc                                                \
   db/wal_manager.cc                                             \
+  db/wal_replay_pipeline.cc                                     \
   db/wide/wide_column_serialization.cc                          \
   db/wide/wide_columns.cc                                       \
   db/wide/wide_columns_helper.cc                                \
@@ -137,6 +140,7 @@ LIB_SOURCES =                                                   \
   memory/memkind_kmem_allocator.cc                              \
   memory/memory_allocator.cc                                    \
   memtable/alloc_tracker.cc                                     \
+  memtable/btreerep.cc                                          \
   memtable/hash_linklist_rep.cc                                 \
   memtable/hash_skiplist_rep.cc                                 \
   memtable/skiplistrep.cc                                       \
@@ -193,10 +197,13 @@ LIB_SOURCES =                                                   \
   table/block_based/hash_index_reader.cc                        \
   table/block_based/index_builder.cc                            \
   table/block_based/index_reader_common.cc                      \
+  table/block_based/learned_index.cc                            \
+  table/block_based/learned_index_reader.cc                     \
   table/block_based/parsed_full_filter_block.cc                 \
   table/block_based/partitioned_filter_block.cc                 \
   table/block_based/partitioned_index_iterator.cc               \
   table/block_based/partitioned_index_reader.cc                 \
+  table/block_based/range_filter.cc                             \
   table/block_based/reader_common.cc                            \
   table/block_based/uncompression_dict_reader.cc                \
   table/block_fetcher.cc                                        \
@@ -276,6 +283,7 @@ LIB_SOURCES =                                                   \
   utilities/checkpoint/checkpoint_impl.cc                       \
   utilities/compaction_filters.cc                               \
   utilities/compaction_filters/remove_emptyvalue_compactionfilter.cc    \
+  utilities/compaction_service/local_process_compaction_service.cc      \
   utilities/convenience/info_log_finder.cc                      \
   utilities/counted_fs.cc                                       \
   utilities/debug.cc                                            \
@@ -418,6 +426,7 @@ FOLLY_SOURCES =                                                 \
 TOOLS_MAIN_SOURCES =                                                    \
   db_stress_tool/db_stress.cc                                           \
   tools/blob_dump.cc                                                    \
+  tools/compaction_worker.cc                                            \
   tools/block_cache_analyzer/block_cache_trace_analyzer_tool.cc         \
   tools/db_repl_stress.cc                                               \
   tools/db_sanity_test.cc                                               \
@@ -444,6 +453,7 @@ TEST_MAIN_SOURCES =                                                     \
   cache/cache_test.cc                                                   \
   cache/cache_reservation_manager_test.cc                               \
   cache/compressed_secondary_cache_test.cc                              \
+  cache/log_structured_secondary_cache_test.cc                          \
   cache/lru_cache_test.cc                                               \
   cache/tiered_secondary_cache_test.cc					\
   db/blob/blob_counting_iterator_test.cc                                \
@@ -559,6 +569,7 @@ TEST_MAIN_SOURCES =                                                     \
   logging/event_logger_test.cc                                          \
   memory/arena_test.cc                                                  \
   memory/memory_allocator_test.cc                                       \
+  memtable/btree_test.cc                                                \
   memtable/inlineskiplist_test.cc                                       \
   memtable/skiplist_test.cc                                             \
   memtable/write_buffer_manager_test.cc                                 \
@@ -621,6 +632,7 @@ TEST_MAIN_SOURCES =                                                     \
   utilities/cassandra/cassandra_row_merge_test.cc                       \
   utilities/cassandra/cassandra_serialize_test.cc                       \
   utilities/checkpoint/checkpoint_test.cc                               \
+  utilities/compaction_service/local_process_compaction_service_test.cc \
   utilities/env_timed_test.cc                                           \
   utilities/memory/memory_test.cc                                       \
   utilities/merge_operators/string_append/stringappend_test.cc          \
@@ -652,6 +664,8 @@ TEST_MAIN_SOURCES_C = \
 MICROBENCH_SOURCES =                                          \
   microbench/ribbon_bench.cc                                  \
   microbench/db_basic_bench.cc                                  \
+  microbench/block_seek_bench.cc                                \
+  microbench/point_lock_manager_bench.cc                        \
 
 JNI_NATIVE_SOURCES =                                          \
   java/rocksjni/backupenginejni.cc                            \
@@ -698,6 +712,7 @@ JNI_NATIVE_SOURCES =                                          \
   java/rocksjni/options.cc                                    \
   java/rocksjni/options_util.cc                               \
   java/rocksjni/persistent_cache.cc                           \
+  java/rocksjni/pinned_value.cc                               \
   java/rocksjni/ratelimiterjni.cc                             \
   java/rocksjni/remove_emptyvalue_compactionfilterjni.cc      \
   java/rocksjni/cassandra_compactionfilterjni.cc              \
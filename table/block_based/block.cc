@@ -22,8 +22,14 @@
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_prefix_index.h"
 #include "table/block_based/data_block_footer.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 #include "util/coding.h"
+#include "util/math.h"
+
+#if defined(__AVX2__) || defined(__SSE4_2__)
+#include <immintrin.h>
+#endif
 
 namespace ROCKSDB_NAMESPACE {
 
@@ -141,6 +147,78 @@ struct DecodeKeyV4 {
   }
 };
 
+namespace {
+// Blocks with at most this many restart points count matching restart key
+// prefixes with a linear (vectorized when available) scan; larger ones use
+// binary search on the prefix array.
+constexpr uint32_t kRestartKeyPrefixScanLimit = 64;
+
+// Returns the first 8 bytes of `user_key` interpreted as a big-endian integer,
+// padded with zero bytes if the key is shorter. In bytewise order, a < b
+// implies RestartKeyPrefix(a) <= RestartKeyPrefix(b), and
+// RestartKeyPrefix(a) < RestartKeyPrefix(b) implies a < b. Complementing the
+// result gives the same guarantees for reverse bytewise order.
+inline uint64_t RestartKeyPrefix(const Slice& user_key, bool reversed) {
+  char buf[sizeof(uint64_t)] = {0};
+  memcpy(buf, user_key.data(), std::min(user_key.size(), sizeof(buf)));
+  uint64_t prefix = EndianSwapValue(DecodeFixed64(buf));
+  return reversed ? ~prefix : prefix;
+}
+
+// Sets `*num_less` and `*num_less_or_equal` to the number of entries of the
+// non-decreasing array `prefixes` that are less than, respectively not
+// greater than, `target`.
+void CountRestartKeyPrefixes(const uint64_t* prefixes, uint32_t n,
+                             uint64_t target, uint32_t* num_less,
+                             uint32_t* num_less_or_equal) {
+  if (n > kRestartKeyPrefixScanLimit) {
+    *num_less = static_cast<uint32_t>(
+        std::lower_bound(prefixes, prefixes + n, target) - prefixes);
+    *num_less_or_equal = static_cast<uint32_t>(
+        std::upper_bound(prefixes + *num_less, prefixes + n, target) -
+        prefixes);
+    return;
+  }
+  uint32_t less = 0;
+  uint32_t greater = 0;
+  uint32_t i = 0;
+#if defined(__AVX2__)
+  // There is no unsigned 64-bit compare, so flip the sign bits and use the
+  // signed one.
+  const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<int64_t>::min());
+  const __m256i t =
+      _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(target)), sign);
+  for (; i + 4 <= n; i += 4) {
+    __m256i v = _mm256_xor_si256(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prefixes + i)),
+        sign);
+    less += BitsSetToOne(static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(t, v)))));
+    greater += BitsSetToOne(static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(v, t)))));
+  }
+#elif defined(__SSE4_2__)
+  const __m128i sign = _mm_set1_epi64x(std::numeric_limits<int64_t>::min());
+  const __m128i t =
+      _mm_xor_si128(_mm_set1_epi64x(static_cast<int64_t>(target)), sign);
+  for (; i + 2 <= n; i += 2) {
+    __m128i v = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(prefixes + i)), sign);
+    less += BitsSetToOne(static_cast<uint32_t>(
+        _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(t, v)))));
+    greater += BitsSetToOne(static_cast<uint32_t>(
+        _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(v, t)))));
+  }
+#endif
+  for (; i < n; ++i) {
+    less += prefixes[i] < target;
+    greater += prefixes[i] > target;
+  }
+  *num_less = less;
+  *num_less_or_equal = n - greater;
+}
+}  // namespace
+
 struct DecodeEntryV4 {
   inline const char* operator()(const char* p, const char* limit,
                                 uint32_t* shared, uint32_t* non_shared,
@@ -158,9 +236,86 @@ void DataBlockIter::NextImpl() {
     return;
   }
 #endif
+  if (next_entries_idx_ < next_entries_offset_.size() &&
+      next_entries_offset_[next_entries_idx_] == NextEntryOffset()) {
+    const size_t idx = next_entries_idx_++;
+    current_ = next_entries_offset_[idx];
+    restart_index_ = next_entries_restart_index_[idx];
+    const Slice& key = next_entries_key_[idx];
+    raw_key_.SetKey(key, false /* copy */);
+    raw_key_transient_ = key.data() < data_ || key.data() >= data_ + restarts_;
+    value_ = next_entries_value_[idx];
+    ++cur_entry_idx_;
+    return;
+  }
+  raw_key_transient_ = false;
   bool is_shared = false;
   ParseNextDataKey(&is_shared);
   ++cur_entry_idx_;
+  if (!in_seek_scan_ && ++num_consecutive_nexts_ >= kMinNextsForBatchDecode &&
+      Valid() && !pad_min_timestamp_) {
+    DecodeNextEntries();
+  }
+}
+
+void DataBlockIter::DecodeNextEntries() {
+  ClearNextEntries();
+  // The first entry may share a prefix with the current key, so start the
+  // buffer with it. Delta encoded keys are then rebuilt from the previous key,
+  // which is either in the block (`prev_key_ptr`) or in the buffer.
+  const Slice current_key = raw_key_.GetKey();
+  next_entries_keys_buff_.assign(current_key.data(), current_key.size());
+  const char* prev_key_ptr = nullptr;
+  size_t prev_key_offset = 0;
+  size_t prev_key_size = current_key.size();
+
+  const char* const limit = data_ + restarts_;
+  uint32_t offset = NextEntryOffset();
+  uint32_t restart_index = restart_index_;
+  while (data_ + offset < limit) {
+    uint32_t shared, non_shared, value_length;
+    const char* p =
+        DecodeEntry()(data_ + offset, limit, &shared, &non_shared, &value_length);
+    if (p == nullptr || prev_key_size < shared) {
+      // Leave the corruption to be reported by ParseNextKey().
+      break;
+    }
+    if (shared == 0) {
+      next_entries_key_.emplace_back(p, non_shared);
+      prev_key_ptr = p;
+      prev_key_size = non_shared;
+      while (restart_index + 1 < num_restarts_ &&
+             GetRestartPoint(restart_index + 1) < offset) {
+        ++restart_index;
+      }
+    } else {
+      // The key is pointed at the buffer below, once it stops growing.
+      const size_t key_offset = next_entries_keys_buff_.size();
+      if (prev_key_ptr != nullptr) {
+        next_entries_keys_buff_.append(prev_key_ptr, shared);
+      } else {
+        next_entries_keys_buff_.append(next_entries_keys_buff_,
+                                       prev_key_offset, shared);
+      }
+      next_entries_keys_buff_.append(p, non_shared);
+      next_entries_key_.emplace_back(nullptr, shared + non_shared);
+      next_entries_key_offset_.push_back(key_offset);
+      prev_key_ptr = nullptr;
+      prev_key_offset = key_offset;
+      prev_key_size = shared + non_shared;
+    }
+    next_entries_offset_.push_back(offset);
+    next_entries_restart_index_.push_back(restart_index);
+    next_entries_value_.emplace_back(p + non_shared, value_length);
+    offset = static_cast<uint32_t>(p + non_shared + value_length - data_);
+  }
+  size_t i = 0;
+  for (Slice& key : next_entries_key_) {
+    if (key.data() == nullptr) {
+      key = Slice(next_entries_keys_buff_.data() + next_entries_key_offset_[i++],
+                  key.size());
+    }
+  }
 }
 
 void MetaBlockIter::NextImpl() {
@@ -219,6 +374,7 @@ void MetaBlockIter::PrevImpl() {
 // Similar to IndexBlockIter::PrevImpl but also caches the prev entries
 void DataBlockIter::PrevImpl() {
   assert(Valid());
+  ResetConsecutiveNexts();
 
   assert(prev_entries_idx_ == -1 ||
          static_cast<size_t>(prev_entries_idx_) < prev_entries_.size());
@@ -300,6 +456,7 @@ void DataBlockIter::PrevImpl() {
 }
 
 void DataBlockIter::SeekImpl(const Slice& target) {
+  ResetConsecutiveNexts();
   Slice seek_key = target;
   PERF_TIMER_GUARD(block_seek_nanos);
   if (data_ == nullptr) {  // Not init yet
@@ -312,7 +469,9 @@ void DataBlockIter::SeekImpl(const Slice& target) {
   if (!ok) {
     return;
   }
+  in_seek_scan_ = true;
   FindKeyAfterBinarySeek(seek_key, index, skip_linear_scan);
+  in_seek_scan_ = false;
 }
 
 void MetaBlockIter::SeekImpl(const Slice& target) {
@@ -357,6 +516,7 @@ void MetaBlockIter::SeekImpl(const Slice& target) {
 //    with a smaller [ type | seqno ] (i.e. a larger seqno, or the same seqno
 //    but larger type).
 bool DataBlockIter::SeekForGetImpl(const Slice& target) {
+  ResetConsecutiveNexts();
   Slice target_user_key = ExtractUserKey(target);
   uint32_t map_offset = restarts_ + num_restarts_ * sizeof(uint32_t);
   uint8_t entry =
@@ -507,6 +667,7 @@ void IndexBlockIter::SeekImpl(const Slice& target) {
 }
 
 void DataBlockIter::SeekForPrevImpl(const Slice& target) {
+  ResetConsecutiveNexts();
   PERF_TIMER_GUARD(block_seek_nanos);
   Slice seek_key = target;
   if (data_ == nullptr) {  // Not init yet
@@ -519,7 +680,9 @@ void DataBlockIter::SeekForPrevImpl(const Slice& target) {
   if (!ok) {
     return;
   }
+  in_seek_scan_ = true;
   FindKeyAfterBinarySeek(seek_key, index, skip_linear_scan);
+  in_seek_scan_ = false;
 
   if (!Valid()) {
     if (status_.ok()) {
@@ -559,6 +722,7 @@ void MetaBlockIter::SeekForPrevImpl(const Slice& target) {
 }
 
 void DataBlockIter::SeekToFirstImpl() {
+  raw_key_transient_ = false;
   if (data_ == nullptr) {  // Not init yet
     return;
   }
@@ -594,6 +758,7 @@ void IndexBlockIter::SeekToFirstImpl() {
 }
 
 void DataBlockIter::SeekToLastImpl() {
+  ResetConsecutiveNexts();
   if (data_ == nullptr) {  // Not init yet
     return;
   }
@@ -846,6 +1011,26 @@ bool BlockIter<TValue>::BinarySeek(const Slice& target, uint32_t* index,
   // - Any restart keys after index `right` are strictly greater than the target
   //   key.
   int64_t left = -1, right = num_restarts_ - 1;
+  if (restart_key_prefixes_ != nullptr) {
+    // Restart keys with a smaller prefix than the target are less than the
+    // target, and those with a larger prefix are greater. Only restart keys
+    // sharing the target's prefix need to be decoded and compared.
+    Slice target_user_key =
+        raw_key_.IsUserKey() ? target : ExtractUserKey(target);
+    uint32_t num_less = 0;
+    uint32_t num_less_or_equal = 0;
+    CountRestartKeyPrefixes(
+        restart_key_prefixes_, num_restarts_,
+        RestartKeyPrefix(target_user_key, restart_key_prefixes_reversed_),
+        &num_less, &num_less_or_equal);
+    left = static_cast<int64_t>(num_less) - 1;
+    right = static_cast<int64_t>(num_less_or_equal) - 1;
+  } else if (learned_index_model_ != nullptr) {
+    // Leaves the full range if the model does not match the block
+    learned_index_model_->GetRestartRange(
+        raw_key_.IsUserKey() ? target : ExtractUserKey(target), num_restarts_,
+        &left, &right);
+  }
   while (left != right) {
     // The `mid` is computed by rounding up so it lands in (`left`, `right`].
     int64_t mid = left + (right - left + 1) / 2;
@@ -1238,6 +1423,55 @@ void Block::InitializeMetaIndexBlockProtectionInfo(
   }
 }
 
+void Block::InitializeRestartKeyPrefixes(const Comparator* raw_ucmp,
+                                         bool key_includes_seq,
+                                         bool value_is_full) {
+  restart_key_prefixes_.reset();
+  if (size_ == 0 || num_restarts_ == 0 || restart_offset_ == 0 ||
+      raw_ucmp == nullptr || raw_ucmp->timestamp_size() != 0) {
+    return;
+  }
+  bool reversed;
+  if (raw_ucmp == BytewiseComparator()) {
+    reversed = false;
+  } else if (raw_ucmp == ReverseBytewiseComparator()) {
+    reversed = true;
+  } else {
+    return;
+  }
+  std::unique_ptr<uint64_t[]> prefixes(new uint64_t[num_restarts_]);
+  const char* limit = data_ + restart_offset_;
+  for (uint32_t i = 0; i < num_restarts_; ++i) {
+    uint32_t offset =
+        DecodeFixed32(data_ + restart_offset_ + i * sizeof(uint32_t));
+    if (offset >= restart_offset_) {
+      return;
+    }
+    uint32_t shared = 0, non_shared = 0, value_length = 0;
+    const char* key_ptr =
+        value_is_full
+            ? CheckAndDecodeEntry()(data_ + offset, limit, &shared,
+                                    &non_shared, &value_length)
+            : DecodeKeyV4()(data_ + offset, limit, &shared, &non_shared);
+    if (key_ptr == nullptr || shared != 0 ||
+        static_cast<uint32_t>(limit - key_ptr) < non_shared ||
+        (key_includes_seq && non_shared < kNumInternalBytes)) {
+      return;
+    }
+    Slice user_key(key_ptr,
+                   key_includes_seq ? non_shared - kNumInternalBytes
+                                    : non_shared);
+    prefixes[i] = RestartKeyPrefix(user_key, reversed);
+    if (i > 0 && prefixes[i] < prefixes[i - 1]) {
+      // Not sorted as the comparator promised; fall back to plain binary
+      // search.
+      return;
+    }
+  }
+  restart_key_prefixes_ = std::move(prefixes);
+  restart_key_prefixes_reversed_ = reversed;
+}
+
 MetaBlockIter* Block::NewMetaIterator(bool block_contents_pinned) {
   MetaBlockIter* iter = new MetaBlockIter();
   if (size_ < 2 * sizeof(uint32_t)) {
@@ -1280,6 +1514,8 @@ DataBlockIter* Block::NewDataIterator(const Comparator* raw_ucmp,
         user_defined_timestamps_persisted,
         data_block_hash_index_.Valid() ? &data_block_hash_index_ : nullptr,
         protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
+    ret_iter->SetRestartKeyPrefixes(restart_key_prefixes_.get(),
+                                    restart_key_prefixes_reversed_);
     if (read_amp_bitmap_) {
       if (read_amp_bitmap_->GetStatistics() != stats) {
         // DB changed the Statistics pointer, we need to notify read_amp_bitmap_
@@ -1319,6 +1555,8 @@ IndexBlockIter* Block::NewIndexIterator(
         prefix_index_ptr, have_first_key, key_includes_seq, value_is_full,
         block_contents_pinned, user_defined_timestamps_persisted,
         protection_bytes_per_key_, kv_checksum_, block_restart_interval_);
+    ret_iter->SetRestartKeyPrefixes(restart_key_prefixes_.get(),
+                                    restart_key_prefixes_reversed_);
   }
 
   return ret_iter;
@@ -1335,6 +1573,9 @@ size_t Block::ApproximateMemoryUsage() const {
     usage += read_amp_bitmap_->ApproximateMemoryUsage();
   }
   usage += checksum_size_;
+  if (restart_key_prefixes_) {
+    usage += num_restarts_ * sizeof(uint64_t);
+  }
   return usage;
 }
 
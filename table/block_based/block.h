@@ -39,6 +39,7 @@ class DataBlockIter;
 class IndexBlockIter;
 class MetaBlockIter;
 class BlockPrefixIndex;
+class LearnedIndexModel;
 
 // BlockReadAmpBitmap is a bitmap that map the ROCKSDB_NAMESPACE::Block data
 // bytes to a bitmap with ratio bytes_per_bit. Whenever we access a range of
@@ -268,6 +269,22 @@ class Block {
   // by NewMetaIterator will verify per key-value checksum for any key it read.
   void InitializeMetaIndexBlockProtectionInfo(uint8_t protection_bytes_per_key);
 
+  // Builds an in-memory array holding a fixed-width, order-preserving prefix
+  // of the user key at every restart point. Iterators returned afterwards by
+  // NewDataIterator/NewIndexIterator use it to narrow the restart point
+  // binary search without decoding and comparing full keys. See
+  // BlockBasedTableOptions::restart_key_prefix_seek.
+  //
+  // Only supported for BytewiseComparator and ReverseBytewiseComparator
+  // without user-defined timestamps. It is a no-op otherwise, or if the block
+  // cannot be parsed.
+  void InitializeRestartKeyPrefixes(const Comparator* raw_ucmp,
+                                    bool key_includes_seq, bool value_is_full);
+
+  const uint64_t* TEST_GetRestartKeyPrefixes() const {
+    return restart_key_prefixes_.get();
+  }
+
   static void GenerateKVChecksum(char* checksum_ptr, uint8_t checksum_len,
                                  const Slice& key, const Slice& value) {
     ProtectionInfo64().ProtectKV(key, value).Encode(checksum_len, checksum_ptr);
@@ -288,6 +305,11 @@ class Block {
   uint32_t block_restart_interval_{0};
   uint8_t protection_bytes_per_key_{0};
   DataBlockHashIndex data_block_hash_index_;
+  // One entry per restart point, see InitializeRestartKeyPrefixes().
+  std::unique_ptr<uint64_t[]> restart_key_prefixes_;
+  // Whether the prefixes are complemented so that they sort in the order of
+  // ReverseBytewiseComparator.
+  bool restart_key_prefixes_reversed_{false};
 };
 
 // A `BlockIter` iterates over the entries in a `Block`'s data buffer. The
@@ -425,6 +447,13 @@ class BlockIter : public InternalIteratorBase<TValue> {
 
   void SetCacheHandle(Cache::Handle* handle) { cache_handle_ = handle; }
 
+  // `prefixes` must either be nullptr or hold one entry per restart point, as
+  // built by Block::InitializeRestartKeyPrefixes().
+  void SetRestartKeyPrefixes(const uint64_t* prefixes, bool reversed) {
+    restart_key_prefixes_ = prefixes;
+    restart_key_prefixes_reversed_ = reversed;
+  }
+
   Cache::Handle* cache_handle() { return cache_handle_; }
 
  protected:
@@ -467,6 +496,15 @@ class BlockIter : public InternalIteratorBase<TValue> {
   uint8_t protection_bytes_per_key_;
 
   bool key_pinned_;
+  // Whether `raw_key_` points into a buffer owned by the iterator rather than
+  // into the block, in which case the key is not reported as pinned.
+  bool raw_key_transient_ = false;
+  // Order-preserving restart key prefixes owned by the block, or nullptr.
+  const uint64_t* restart_key_prefixes_ = nullptr;
+  bool restart_key_prefixes_reversed_ = false;
+  // Model of the restart keys owned by the index reader, or nullptr. Only
+  // set for index blocks.
+  const LearnedIndexModel* learned_index_model_ = nullptr;
   // Whether the block data is guaranteed to outlive this iterator, and
   // as long as the cleanup functions are transferred to another class,
   // e.g. PinnableSlice, the pointer to the bytes will still be valid.
@@ -604,7 +642,7 @@ class BlockIter : public InternalIteratorBase<TValue> {
       key_pinned_ = raw_key_.IsKeyPinned();
     } else if (global_seqno_ == kDisableGlobalSequenceNumber) {
       key_ = raw_key_.GetInternalKey();
-      key_pinned_ = raw_key_.IsKeyPinned();
+      key_pinned_ = raw_key_.IsKeyPinned() && !raw_key_transient_;
     } else {
       key_buf_.SetInternalKey(raw_key_.GetUserKey(), global_seqno_,
                               ExtractValueType(raw_key_.GetInternalKey()));
@@ -709,6 +747,9 @@ class DataBlockIter final : public BlockIter<Slice> {
     read_amp_bitmap_ = read_amp_bitmap;
     last_bitmap_offset_ = current_ + 1;
     data_block_hash_index_ = data_block_hash_index;
+    // The decoded entries belong to the previous block.
+    ClearNextEntries();
+    raw_key_transient_ = false;
   }
 
   Slice value() const override {
@@ -743,6 +784,7 @@ class DataBlockIter final : public BlockIter<Slice> {
     prev_entries_keys_buff_.clear();
     prev_entries_.clear();
     prev_entries_idx_ = -1;
+    ClearNextEntries();
   }
 
  protected:
@@ -784,6 +826,45 @@ class DataBlockIter final : public BlockIter<Slice> {
   std::vector<CachedPrevEntry> prev_entries_;
   int32_t prev_entries_idx_ = -1;
 
+  // Forward scans decode the remaining entries of a block in one pass into
+  // the columnar arrays below, after which NextImpl() only has to step
+  // through them. This kicks in after kMinNextsForBatchDecode consecutive
+  // calls to NextImpl() (carried over from one block to the next), so that
+  // short scans after a seek do not pay for decoding the whole block.
+  static constexpr uint32_t kMinNextsForBatchDecode = 8;
+  uint32_t num_consecutive_nexts_ = 0;
+  // Set while a seek steps through its restart interval with NextImpl(),
+  // which is not counted as part of a forward scan.
+  bool in_seek_scan_ = false;
+  // Offset in the block, restart index, key and value of each entry after
+  // the one that was current when DecodeNextEntries() was called. Keys that
+  // are not delta encoded point into the block, the others into
+  // next_entries_keys_buff_.
+  std::vector<uint32_t> next_entries_offset_;
+  std::vector<uint32_t> next_entries_restart_index_;
+  std::vector<Slice> next_entries_key_;
+  std::vector<Slice> next_entries_value_;
+  std::string next_entries_keys_buff_;
+  // Offsets in next_entries_keys_buff_ of the delta encoded keys.
+  std::vector<size_t> next_entries_key_offset_;
+  size_t next_entries_idx_ = 0;
+
+  void DecodeNextEntries();
+  void ClearNextEntries() {
+    next_entries_offset_.clear();
+    next_entries_restart_index_.clear();
+    next_entries_key_.clear();
+    next_entries_value_.clear();
+    next_entries_keys_buff_.clear();
+    next_entries_key_offset_.clear();
+    next_entries_idx_ = 0;
+  }
+  // Called by every positioning method other than Next() and SeekToFirst().
+  void ResetConsecutiveNexts() {
+    num_consecutive_nexts_ = 0;
+    raw_key_transient_ = false;
+  }
+
   DataBlockHashIndex* data_block_hash_index_;
 
   bool SeekForGetImpl(const Slice& target);
@@ -851,6 +932,7 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
                    kv_checksum, block_restart_interval);
     raw_key_.SetIsUserKey(!key_includes_seq);
     prefix_index_ = prefix_index;
+    learned_index_model_ = nullptr;
     value_delta_encoded_ = !value_is_full;
     have_first_key_ = have_first_key;
     if (have_first_key_ && global_seqno != kDisableGlobalSequenceNumber) {
@@ -889,6 +971,12 @@ class IndexBlockIter final : public BlockIter<IndexValue> {
     return global_seqno_state_ != nullptr ? false : BlockIter::IsValuePinned();
   }
 
+  // `model` must either be nullptr or outlive the iterator. See
+  // BlockBasedTableOptions::kLearnedIndexSearch.
+  void SetLearnedIndexModel(const LearnedIndexModel* model) {
+    learned_index_model_ = model;
+  }
+
  protected:
   friend Block;
   // IndexBlockIter follows a different contract for prefix iterator
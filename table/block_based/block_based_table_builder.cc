@@ -45,6 +45,7 @@
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/partitioned_filter_block.h"
+#include "table/block_based/range_filter.h"
 #include "table/format.h"
 #include "table/meta_blocks.h"
 #include "table/table_builder.h"
@@ -294,6 +295,8 @@ struct BlockBasedTableBuilder::Rep {
   InternalKeySliceTransform internal_prefix_transform;
   std::unique_ptr<IndexBuilder> index_builder;
   PartitionedIndexBuilder* p_index_builder_ = nullptr;
+  // Only set when range_filter_bits_per_key > 0
+  std::unique_ptr<RangeFilterBuilder> range_filter_builder;
 
   std::string last_key;
   const Slice* first_key_in_next_block = nullptr;
@@ -544,6 +547,11 @@ struct BlockBasedTableBuilder::Rep {
           &this->internal_prefix_transform, use_delta_encoding_for_index_values,
           table_options, ts_sz, persist_user_defined_timestamps));
     }
+    if (table_options.range_filter_bits_per_key > 0 && ts_sz == 0 &&
+        internal_comparator.user_comparator() == BytewiseComparator()) {
+      range_filter_builder.reset(
+          new RangeFilterBuilder(table_options.range_filter_bits_per_key));
+    }
     if (ioptions.optimize_filters_for_hits && tbo.is_bottommost) {
       // Apply optimize_filters_for_hits setting here when applicable by
       // skipping filter generation
@@ -568,6 +576,9 @@ struct BlockBasedTableBuilder::Rep {
         filter_context.num_levels = ioptions.num_levels;
         filter_context.level_at_creation = tbo.level_at_creation;
         filter_context.is_bottommost = tbo.is_bottommost;
+        filter_context.level_data_bytes = tbo.level_data_bytes;
+        filter_context.level_point_lookup_misses =
+            tbo.level_point_lookup_misses;
         assert(filter_context.level_at_creation < filter_context.num_levels);
       }
 
@@ -1011,6 +1022,10 @@ void BlockBasedTableBuilder::Add(const Slice& key, const Slice& value) {
     }
 #endif  // !NDEBUG
 
+    if (r->range_filter_builder != nullptr) {
+      r->range_filter_builder->AddKey(ExtractUserKey(key));
+    }
+
     auto should_flush = r->flush_block_policy->Update(key, value);
     if (should_flush) {
       assert(!r->data_block.empty());
@@ -1622,6 +1637,10 @@ void BlockBasedTableBuilder::WriteIndexBlock(
   } else if (ok() && !index_builder_status.ok()) {
     rep_->SetStatus(index_builder_status);
   }
+  // The index key format is only final once the index builder has finished,
+  // and it must be known when index blocks are parsed to warm the cache.
+  rep_->create_context.index_key_includes_seq =
+      rep_->index_builder->seperator_is_key_plus_seq();
   if (ok()) {
     for (const auto& item : index_blocks.meta_blocks) {
       BlockHandle block_handle;
@@ -1818,6 +1837,23 @@ void BlockBasedTableBuilder::WriteRangeDelBlock(
   }
 }
 
+void BlockBasedTableBuilder::WriteRangeFilterBlock(
+    MetaIndexBuilder* meta_index_builder) {
+  if (ok() && rep_->range_filter_builder != nullptr &&
+      !rep_->range_filter_builder->empty()) {
+    std::unique_ptr<const char[]> buf;
+    Slice contents = rep_->range_filter_builder->Finish(&buf);
+    if (contents.empty()) {
+      return;
+    }
+    BlockHandle range_filter_block_handle;
+    WriteMaybeCompressedBlock(contents, kNoCompression,
+                              &range_filter_block_handle,
+                              BlockType::kRangeFilter);
+    meta_index_builder->Add(kRangeFilterBlockName, range_filter_block_handle);
+  }
+}
+
 void BlockBasedTableBuilder::WriteFooter(BlockHandle& metaindex_block_handle,
                                          BlockHandle& index_block_handle) {
   assert(ok());
@@ -2036,15 +2072,17 @@ Status BlockBasedTableBuilder::Finish() {
   //    2. [meta block: index]
   //    3. [meta block: compression dictionary]
   //    4. [meta block: range deletion tombstone]
-  //    5. [meta block: properties]
-  //    6. [metaindex block]
-  //    7. Footer
+  //    5. [meta block: range filter]
+  //    6. [meta block: properties]
+  //    7. [metaindex block]
+  //    8. Footer
   BlockHandle metaindex_block_handle, index_block_handle;
   MetaIndexBuilder meta_index_builder;
   WriteFilterBlock(&meta_index_builder);
   WriteIndexBlock(&meta_index_builder, &index_block_handle);
   WriteCompressionDictBlock(&meta_index_builder);
   WriteRangeDelBlock(&meta_index_builder);
+  WriteRangeFilterBlock(&meta_index_builder);
   WritePropertiesBlock(&meta_index_builder);
   if (ok()) {
     // flush the meta index block
@@ -181,7 +181,9 @@ static std::unordered_map<std::string, BlockBasedTableOptions::IndexType>
         {"kTwoLevelIndexSearch",
          BlockBasedTableOptions::IndexType::kTwoLevelIndexSearch},
         {"kBinarySearchWithFirstKey",
-         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey}};
+         BlockBasedTableOptions::IndexType::kBinarySearchWithFirstKey},
+        {"kLearnedIndexSearch",
+         BlockBasedTableOptions::IndexType::kLearnedIndexSearch}};
 
 static std::unordered_map<std::string,
                           BlockBasedTableOptions::DataBlockIndexType>
@@ -269,6 +271,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
                    data_block_hash_table_util_ratio),
           OptionType::kDouble, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"restart_key_prefix_seek",
+         {offsetof(struct BlockBasedTableOptions, restart_key_prefix_seek),
+          OptionType::kBoolean, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"checksum",
          {offsetof(struct BlockBasedTableOptions, checksum),
           OptionType::kChecksumType, OptionVerificationType::kNormal,
@@ -321,6 +327,10 @@ static std::unordered_map<std::string, OptionTypeInfo>
          {offsetof(struct BlockBasedTableOptions, whole_key_filtering),
           OptionType::kBoolean, OptionVerificationType::kNormal,
           OptionTypeFlags::kNone}},
+        {"range_filter_bits_per_key",
+         {offsetof(struct BlockBasedTableOptions, range_filter_bits_per_key),
+          OptionType::kDouble, OptionVerificationType::kNormal,
+          OptionTypeFlags::kNone}},
         {"detect_filter_construct_corruption",
          {offsetof(struct BlockBasedTableOptions,
                    detect_filter_construct_corruption),
@@ -769,6 +779,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  data_block_hash_table_util_ratio: %lf\n",
            table_options_.data_block_hash_table_util_ratio);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  restart_key_prefix_seek: %d\n",
+           table_options_.restart_key_prefix_seek);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  checksum: %d\n", table_options_.checksum);
   ret.append(buffer);
   snprintf(buffer, kBufferSize, "  no_block_cache: %d\n",
@@ -824,6 +837,9 @@ std::string BlockBasedTableFactory::GetPrintableOptions() const {
   snprintf(buffer, kBufferSize, "  whole_key_filtering: %d\n",
            table_options_.whole_key_filtering);
   ret.append(buffer);
+  snprintf(buffer, kBufferSize, "  range_filter_bits_per_key: %lf\n",
+           table_options_.range_filter_bits_per_key);
+  ret.append(buffer);
   snprintf(buffer, kBufferSize, "  verify_compression: %d\n",
            table_options_.verify_compression);
   ret.append(buffer);
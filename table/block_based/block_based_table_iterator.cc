@@ -12,6 +12,37 @@ namespace ROCKSDB_NAMESPACE {
 
 void BlockBasedTableIterator::SeekToFirst() { SeekImpl(nullptr, false); }
 
+void BlockBasedTableIterator::PrepareSeekToFirst() {
+  // With async_io, this leaves async_read_in_progress_ set and the following
+  // SeekToFirst() runs the second pass.
+  SeekImpl(nullptr, /*async_prefetch=*/true);
+}
+
+void BlockBasedTableIterator::PrepareSeek(const Slice& target) {
+  if (read_options_.async_io) {
+    SeekImpl(&target, /*async_prefetch=*/true);
+  }
+}
+
+bool BlockBasedTableIterator::IsInLastDataBlock() const {
+  BlockHandle handle;
+  if (IsIndexAtCurr()) {
+    if (!index_iter_->Valid()) {
+      return false;
+    }
+    handle = index_iter_->value().handle;
+  } else if (DoesContainBlockHandles()) {
+    handle = block_handles_->front().handle_;
+  } else {
+    return false;
+  }
+  const TableProperties* props = table_->get_rep()->table_properties.get();
+  // Data blocks are at the start of the file
+  return props != nullptr &&
+         handle.offset() + BlockBasedTable::BlockSizeWithTrailer(handle) >=
+             props->data_size;
+}
+
 void BlockBasedTableIterator::Seek(const Slice& target) {
   SeekImpl(&target, true);
 }
@@ -33,20 +64,33 @@ void BlockBasedTableIterator::SeekSecondPass(const Slice* target) {
   }
 }
 
+void BlockBasedTableIterator::FinishAsyncSeek() {
+  assert(async_read_in_progress_);
+  if (async_seek_to_first_) {
+    SeekSecondPass(nullptr);
+  } else {
+    Slice target = async_seek_target_.GetKey();
+    SeekSecondPass(&target);
+  }
+}
+
 void BlockBasedTableIterator::SeekImpl(const Slice* target,
                                        bool async_prefetch) {
-  bool is_first_pass = !async_read_in_progress_;
-
-  if (!is_first_pass) {
-    SeekSecondPass(target);
-    return;
+  if (async_read_in_progress_) {
+    if (target == nullptr ? async_seek_to_first_
+                          : (!async_seek_to_first_ &&
+                             async_seek_target_.GetKey() == *target)) {
+      SeekSecondPass(target);
+      return;
+    }
+    // Seeking somewhere else than the async read was started for
+    FinishAsyncSeek();
   }
 
   ResetBlockCacheLookupVar();
 
-  bool autotune_readaheadsize = is_first_pass &&
-                                read_options_.auto_readahead_size &&
-                                read_options_.iterate_upper_bound;
+  bool autotune_readaheadsize =
+      read_options_.auto_readahead_size && read_options_.iterate_upper_bound;
 
   if (autotune_readaheadsize &&
       table_->get_rep()->table_options.block_cache.get() &&
@@ -58,8 +102,10 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
   is_at_first_key_from_index_ = false;
   seek_stat_state_ = kNone;
   bool filter_checked = false;
-  if (target &&
-      !CheckPrefixMayMatch(*target, IterDirection::kForward, &filter_checked)) {
+  if ((target &&
+       !CheckPrefixMayMatch(*target, IterDirection::kForward,
+                            &filter_checked)) ||
+      !CheckRangeMayMatch(target, &filter_checked)) {
     ResetDataIter();
     RecordTick(table_->GetStatistics(), is_last_level_
                                             ? LAST_LEVEL_SEEK_FILTERED
@@ -136,6 +182,10 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
       if (read_options_.async_io && async_prefetch) {
         AsyncInitDataBlock(/*is_first_pass=*/true);
         if (async_read_in_progress_) {
+          async_seek_to_first_ = target == nullptr;
+          if (target) {
+            async_seek_target_.SetKey(*target);
+          }
           // Status::TryAgain indicates asynchronous request for retrieval of
           // data blocks has been submitted. So it should return at this point
           // and Seek should be called again to retrieve the requested block
@@ -170,6 +220,9 @@ void BlockBasedTableIterator::SeekImpl(const Slice* target,
 }
 
 void BlockBasedTableIterator::SeekForPrev(const Slice& target) {
+  if (async_read_in_progress_) {
+    FinishAsyncSeek();
+  }
   direction_ = IterDirection::kBackward;
   ResetBlockCacheLookupVar();
   is_out_of_bound_ = false;
@@ -244,6 +297,9 @@ void BlockBasedTableIterator::SeekForPrev(const Slice& target) {
 }
 
 void BlockBasedTableIterator::SeekToLast() {
+  if (async_read_in_progress_) {
+    FinishAsyncSeek();
+  }
   direction_ = IterDirection::kBackward;
   ResetBlockCacheLookupVar();
   is_out_of_bound_ = false;
@@ -53,6 +53,9 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   void SeekForPrev(const Slice& target) override;
   void SeekToFirst() override;
   void SeekToLast() override;
+  void PrepareSeekToFirst() override;
+  void PrepareSeek(const Slice& target) override;
+  bool IsInLastDataBlock() const override;
   void Next() final override;
   bool NextAndGetResult(IterateResult* result) override;
   void Prev() override;
@@ -325,6 +328,11 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   bool need_upper_bound_check_;
 
   bool async_read_in_progress_;
+  // The seek that started the in-progress async read, so that the read can be
+  // completed if the iterator is repositioned elsewhere before the seek is
+  // retried (see PrepareSeek())
+  IterKey async_seek_target_;
+  bool async_seek_to_first_ = false;
 
   mutable SeekStatState seek_stat_state_ = SeekStatState::kNone;
   bool is_last_level_;
@@ -354,6 +362,8 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
   IterDirection direction_ = IterDirection::kForward;
 
   void SeekSecondPass(const Slice* target);
+  // Completes the seek that started the in-progress async read.
+  void FinishAsyncSeek();
 
   // If `target` is null, seek to first.
   void SeekImpl(const Slice* target, bool async_prefetch);
@@ -394,6 +404,31 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
     return true;
   }
 
+  // Checks the range filter of the table for a forward seek to `target`
+  // (nullptr for SeekToFirst()) when the scan is bounded by
+  // iterate_upper_bound.
+  bool CheckRangeMayMatch(const Slice* target, bool* filter_checked) {
+    if (read_options_.iterate_upper_bound == nullptr) {
+      return true;
+    }
+    Slice lower_user_key;
+    if (target) {
+      lower_user_key = ExtractUserKey(*target);
+    } else if (read_options_.iterate_lower_bound) {
+      lower_user_key = *read_options_.iterate_lower_bound;
+    }
+    const bool has_lower = target || read_options_.iterate_lower_bound;
+    if (!table_->RangeMayMatch(has_lower ? &lower_user_key : nullptr,
+                               *read_options_.iterate_upper_bound)) {
+      return false;
+    }
+    if (table_->get_rep()->range_filter != nullptr &&
+        table_->get_rep()->fragmented_range_dels == nullptr) {
+      *filter_checked = true;
+    }
+    return true;
+  }
+
   // *** BEGIN APIs relevant to auto tuning of readahead_size ***
 
   // This API is called to lookup the data blocks ahead in the cache to tune
@@ -431,7 +466,7 @@ class BlockBasedTableIterator : public InternalIteratorBase<Slice> {
     prev_block_offset_ = std::numeric_limits<uint64_t>::max();
   }
 
-  bool DoesContainBlockHandles() {
+  bool DoesContainBlockHandles() const {
     return block_handles_ != nullptr && !block_handles_->empty();
   }
 
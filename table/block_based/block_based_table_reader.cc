@@ -56,6 +56,7 @@
 #include "table/block_based/filter_policy_internal.h"
 #include "table/block_based/full_filter_block.h"
 #include "table/block_based/hash_index_reader.h"
+#include "table/block_based/learned_index_reader.h"
 #include "table/block_based/partitioned_filter_block.h"
 #include "table/block_based/partitioned_index_reader.h"
 #include "table/block_fetcher.h"
@@ -752,7 +753,7 @@ Status BlockBasedTable::Open(
       &rep->table_options, &rep->ioptions, rep->ioptions.stats,
       blocks_definitely_zstd_compressed, block_protection_bytes_per_key,
       rep->internal_comparator.user_comparator(), rep->index_value_is_full,
-      rep->index_has_first_key);
+      rep->index_has_first_key, rep->index_key_includes_seq);
 
   // Check expected unique id if provided
   if (expected_unique_id != kNullUniqueId64x2) {
@@ -843,6 +844,11 @@ Status BlockBasedTable::Open(
   if (!s.ok()) {
     return s;
   }
+  s = new_table->ReadRangeFilterBlock(ro, prefetch_buffer.get(),
+                                      metaindex_iter.get());
+  if (!s.ok()) {
+    return s;
+  }
   rep->verify_checksum_set_on_open = ro.verify_checksums;
   s = new_table->PrefetchIndexAndFilterBlocks(
       ro, prefetch_buffer.get(), metaindex_iter.get(), new_table.get(),
@@ -1100,6 +1106,50 @@ Status BlockBasedTable::ReadRangeDelBlock(
   return s;
 }
 
+Status BlockBasedTable::ReadRangeFilterBlock(
+    const ReadOptions& read_options, FilePrefetchBuffer* prefetch_buffer,
+    InternalIterator* meta_iter) {
+  BlockHandle range_filter_handle;
+  Status s = FindOptionalMetaBlock(meta_iter, kRangeFilterBlockName,
+                                   &range_filter_handle);
+  if (!s.ok()) {
+    ROCKS_LOG_WARN(rep_->ioptions.logger,
+                   "Error when seeking to range filter block from file: %s",
+                   s.ToString().c_str());
+    // The range filter is only an optimization
+    return Status::OK();
+  }
+  if (range_filter_handle.IsNull()) {
+    return s;
+  }
+  BlockContents contents;
+  BlockFetcher block_fetcher(
+      rep_->file.get(), prefetch_buffer, rep_->footer, read_options,
+      range_filter_handle, &contents, rep_->ioptions, false /*decompress*/,
+      false /*maybe_compressed*/, BlockType::kRangeFilter,
+      UncompressionDict::GetEmptyDict(), rep_->persistent_cache_options,
+      GetMemoryAllocator(rep_->table_options));
+  s = block_fetcher.ReadBlockContents();
+  if (!s.ok()) {
+    ROCKS_LOG_WARN(rep_->ioptions.logger,
+                   "Encountered error while reading range filter block: %s",
+                   s.ToString().c_str());
+    return s;
+  }
+  rep_->range_filter = RangeFilterReader::Create(std::move(contents));
+  return s;
+}
+
+bool BlockBasedTable::RangeMayMatch(const Slice* lower_user_key,
+                                    const Slice& upper_user_key) const {
+  // Range tombstones are not in the range filter, so a file with any could
+  // still cover keys of other files in the range.
+  if (rep_->range_filter == nullptr || rep_->fragmented_range_dels) {
+    return true;
+  }
+  return rep_->range_filter->RangeMayMatch(lower_user_key, upper_user_key);
+}
+
 Status BlockBasedTable::PrefetchIndexAndFilterBlocks(
     const ReadOptions& ro, FilePrefetchBuffer* prefetch_buffer,
     InternalIterator* meta_iter, BlockBasedTable* new_table, bool prefetch_all,
@@ -1333,6 +1383,9 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (rep_->uncompression_dict_reader) {
     usage += rep_->uncompression_dict_reader->ApproximateMemoryUsage();
   }
+  if (rep_->range_filter) {
+    usage += rep_->range_filter->ApproximateMemoryUsage();
+  }
   if (rep_->table_properties) {
     usage += rep_->table_properties->ApproximateMemoryUsage();
   }
@@ -2655,6 +2708,10 @@ BlockType BlockBasedTable::GetBlockTypeForMetaBlockByName(
     return BlockType::kIndex;
   }
 
+  if (meta_block_name == kRangeFilterBlockName) {
+    return BlockType::kRangeFilter;
+  }
+
   if (meta_block_name.starts_with(kObsoleteFilterBlockPrefix)) {
     // Obsolete but possible in old files
     return BlockType::kInvalid;
@@ -2804,6 +2861,11 @@ Status BlockBasedTable::CreateIndexReader(
                                              use_cache, prefetch, pin,
                                              lookup_context, index_reader);
     }
+    case BlockBasedTableOptions::kLearnedIndexSearch: {
+      return LearnedIndexReader::Create(this, ro, prefetch_buffer, meta_iter,
+                                        use_cache, prefetch, pin,
+                                        lookup_context, index_reader);
+    }
     case BlockBasedTableOptions::kHashSearch: {
       if (!rep_->table_prefix_extractor) {
         ROCKS_LOG_WARN(rep_->ioptions.logger,
@@ -26,6 +26,7 @@
 #include "table/block_based/block_type.h"
 #include "table/block_based/cachable_entry.h"
 #include "table/block_based/filter_block.h"
+#include "table/block_based/range_filter.h"
 #include "table/block_based/uncompression_dict_reader.h"
 #include "table/format.h"
 #include "table/persistent_cache_options.h"
@@ -205,6 +206,11 @@ class BlockBasedTable : public TableReader {
 
   size_t ApproximateMemoryUsage() const override;
 
+  // Returns false if the range filter of this file rules out any user key in
+  // [*lower_user_key, upper_user_key). `lower_user_key` may be nullptr.
+  bool RangeMayMatch(const Slice* lower_user_key,
+                     const Slice& upper_user_key) const;
+
   // convert SST file to a human readable form
   Status DumpTable(WritableFile* out_file) override;
 
@@ -500,6 +506,9 @@ class BlockBasedTable : public TableReader {
                            InternalIterator* meta_iter,
                            const InternalKeyComparator& internal_comparator,
                            BlockCacheLookupContext* lookup_context);
+  Status ReadRangeFilterBlock(const ReadOptions& ro,
+                              FilePrefetchBuffer* prefetch_buffer,
+                              InternalIterator* meta_iter);
   Status PrefetchIndexAndFilterBlocks(
       const ReadOptions& ro, FilePrefetchBuffer* prefetch_buffer,
       InternalIterator* meta_iter, BlockBasedTable* new_table,
@@ -623,6 +632,7 @@ struct BlockBasedTable::Rep {
   std::shared_ptr<const SliceTransform> table_prefix_extractor;
 
   std::shared_ptr<FragmentedRangeTombstoneList> fragmented_range_dels;
+  std::unique_ptr<RangeFilterReader> range_filter;
 
   // Context for block cache CreateCallback
   BlockCreateContext create_context;
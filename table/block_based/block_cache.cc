@@ -15,6 +15,10 @@ void BlockCreateContext::Create(std::unique_ptr<Block_kData>* parsed_out,
       std::move(block), table_options->read_amp_bytes_per_bit, statistics));
   parsed_out->get()->InitializeDataBlockProtectionInfo(protection_bytes_per_key,
                                                        raw_ucmp);
+  if (table_options->restart_key_prefix_seek) {
+    parsed_out->get()->InitializeRestartKeyPrefixes(
+        raw_ucmp, /*key_includes_seq=*/true, /*value_is_full=*/true);
+  }
 }
 void BlockCreateContext::Create(std::unique_ptr<Block_kIndex>* parsed_out,
                                 BlockContents&& block) {
@@ -23,6 +27,10 @@ void BlockCreateContext::Create(std::unique_ptr<Block_kIndex>* parsed_out,
   parsed_out->get()->InitializeIndexBlockProtectionInfo(
       protection_bytes_per_key, raw_ucmp, index_value_is_full,
       index_has_first_key);
+  if (table_options->restart_key_prefix_seek) {
+    parsed_out->get()->InitializeRestartKeyPrefixes(
+        raw_ucmp, index_key_includes_seq, index_value_is_full);
+  }
 }
 void BlockCreateContext::Create(
     std::unique_ptr<Block_kFilterPartitionIndex>* parsed_out,
@@ -75,6 +83,7 @@ const std::array<const Cache::CacheItemHelper*,
         nullptr,  // kHashIndexMetadata
         nullptr,  // kMetaIndex (not yet stored in block cache)
         BlockCacheInterface<Block_kIndex>::GetFullHelper(),
+        nullptr,  // kRangeFilter
         nullptr,  // kInvalid
     }};
 
@@ -92,6 +101,7 @@ const std::array<const Cache::CacheItemHelper*,
         nullptr,  // kHashIndexMetadata
         nullptr,  // kMetaIndex (not yet stored in block cache)
         BlockCacheInterface<Block_kIndex>::GetBasicHelper(),
+        nullptr,  // kRangeFilter
         nullptr,  // kInvalid
     }};
 }  // namespace
@@ -25,6 +25,7 @@
 #include "rocksdb/table.h"
 #include "table/block_based/block_based_table_reader.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 #include "test_util/testharness.h"
 #include "test_util/testutil.h"
@@ -236,6 +237,82 @@ void CheckBlockContents(BlockContents contents, const int max_key,
 }
 
 // In this test case, no two key share same prefix.
+TEST_P(BlockTest, BatchDecodedScan) {
+  Options options = Options();
+  if (isUDTEnabled()) {
+    options.comparator = test::BytewiseComparatorWithU64TsWrapper();
+  }
+  size_t ts_sz = options.comparator->timestamp_size();
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  BlockBasedTableOptions::DataBlockIndexType index_type =
+      isUDTEnabled() ? BlockBasedTableOptions::kDataBlockBinarySearch
+                     : dataBlockIndexType();
+  BlockBuilder builder(16, keyUseDeltaEncoding(),
+                       false /* use_value_delta_encoding */, index_type,
+                       0.75 /* data_block_hash_table_util_ratio */, ts_sz,
+                       shouldPersistUDT(), false /* is_user_key */);
+  const int num_records = 1000;
+  GenerateRandomKVs(&keys, &values, 0, num_records, 1 /* step */,
+                    0 /* padding_size */, 1 /* keys_share_prefix */, ts_sz);
+  for (int i = 0; i < num_records; i++) {
+    builder.Add(keys[i], values[i]);
+  }
+  BlockContents contents;
+  contents.data = builder.Finish();
+  Block reader(std::move(contents));
+
+  std::unique_ptr<DataBlockIter> iter(reader.NewDataIterator(
+      options.comparator, kDisableGlobalSequenceNumber, nullptr /* iter */,
+      nullptr /* stats */, true /* block_contents_pinned */,
+      shouldPersistUDT()));
+
+  // Most of the block is decoded in one batch by a full scan. Keys reported
+  // as pinned must stay valid for the lifetime of the iterator.
+  std::vector<std::pair<Slice, int>> pinned_keys;
+  int count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); count++, iter->Next()) {
+    ASSERT_EQ(keys[count], iter->key().ToString());
+    ASSERT_EQ(values[count], iter->value().ToString());
+    if (iter->IsKeyPinned()) {
+      pinned_keys.emplace_back(iter->key(), count);
+    }
+  }
+  ASSERT_OK(iter->status());
+  ASSERT_EQ(num_records, count);
+  if (!keyUseDeltaEncoding() && shouldPersistUDT()) {
+    ASSERT_EQ(static_cast<size_t>(num_records), pinned_keys.size());
+  }
+  for (const auto& pinned_key : pinned_keys) {
+    ASSERT_EQ(keys[pinned_key.second], pinned_key.first.ToString());
+  }
+
+  // Change direction and reposition in the middle of batch decoded scans.
+  Random rnd(301);
+  for (int i = 0; i < 200; i++) {
+    int index = static_cast<int>(rnd.Uniform(num_records));
+    iter->Seek(keys[index]);
+    const int num_nexts = static_cast<int>(rnd.Uniform(64));
+    for (int j = 0; j < num_nexts && index + 1 < num_records; j++, index++) {
+      iter->Next();
+    }
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(keys[index], iter->key().ToString());
+    const int num_prevs = static_cast<int>(rnd.Uniform(8));
+    for (int j = 0; j < num_prevs && index > 0; j++, index--) {
+      iter->Prev();
+    }
+    for (int j = 0; j < 32 && index < num_records; j++, index++) {
+      ASSERT_TRUE(iter->Valid());
+      ASSERT_EQ(keys[index], iter->key().ToString());
+      ASSERT_EQ(values[index], iter->value().ToString());
+      iter->Next();
+    }
+    ASSERT_OK(iter->status());
+  }
+}
+
 TEST_P(BlockTest, SimpleIndexHash) {
   const int kMaxKey = 100000;
   size_t ts_sz = isUDTEnabled() ? 8 : 0;
@@ -758,6 +835,306 @@ INSTANTIATE_TEST_CASE_P(
     ::testing::Combine(::testing::Bool(), ::testing::Bool(), ::testing::Bool(),
                        ::testing::ValuesIn(test::GetUDTTestModes())));
 
+// Param 0: use ReverseBytewiseComparator instead of BytewiseComparator
+// Param 1: restart interval
+class RestartKeyPrefixTest
+    : public testing::Test,
+      public testing::WithParamInterface<std::tuple<bool, int>> {
+ public:
+  const Comparator *ucmp() const {
+    return std::get<0>(GetParam()) ? ReverseBytewiseComparator()
+                                   : BytewiseComparator();
+  }
+  int restartInterval() const { return std::get<1>(GetParam()); }
+
+  // Random user keys drawn from a tiny alphabet so that many of them share
+  // their first 8 bytes or are shorter than 8 bytes.
+  static std::string RandomUserKey(Random *rnd) {
+    static const char kAlphabet[] = {'\0', 'a', 'b', '\xff'};
+    std::string key;
+    int len = rnd->Uniform(12);
+    for (int i = 0; i < len; ++i) {
+      key.push_back(kAlphabet[rnd->Uniform(sizeof(kAlphabet))]);
+    }
+    return key;
+  }
+
+  // Sorted, distinct internal keys with up to three versions per user key.
+  std::vector<std::string> GenerateSortedInternalKeys(Random *rnd, int n) {
+    std::set<std::string> user_keys;
+    while (static_cast<int>(user_keys.size()) < n) {
+      user_keys.insert(RandomUserKey(rnd));
+    }
+    std::vector<std::string> keys;
+    for (const auto &user_key : user_keys) {
+      int versions = 1 + rnd->Uniform(3);
+      for (int v = 0; v < versions; ++v) {
+        std::string key = user_key;
+        AppendInternalKeyFooter(&key, 100 + rnd->Uniform(100), kTypeValue);
+        keys.push_back(std::move(key));
+      }
+    }
+    InternalKeyComparator icmp(ucmp());
+    std::sort(keys.begin(), keys.end(),
+              [&](const std::string &a, const std::string &b) {
+                return icmp.Compare(a, b) < 0;
+              });
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+  }
+
+  std::string RandomTarget(Random *rnd, const std::vector<std::string> &keys) {
+    if (rnd->OneIn(2)) {
+      return keys[rnd->Uniform(static_cast<int>(keys.size()))];
+    }
+    std::string target = RandomUserKey(rnd);
+    AppendInternalKeyFooter(&target, rnd->Uniform(300), kTypeValue);
+    return target;
+  }
+};
+
+TEST_P(RestartKeyPrefixTest, DataBlockSeek) {
+  Random rnd(301);
+  std::vector<std::string> keys = GenerateSortedInternalKeys(&rnd, 500);
+  BlockBuilder builder(restartInterval());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    builder.Add(keys[i], std::to_string(i));
+  }
+  Slice rawblock = builder.Finish();
+  // On the heap, as ApproximateMemoryUsage() may use malloc_usable_size()
+  auto plain_block = std::make_unique<Block>(BlockContents(rawblock));
+  auto prefix_block = std::make_unique<Block>(BlockContents(rawblock));
+  prefix_block->InitializeRestartKeyPrefixes(
+      ucmp(), true /* key_includes_seq */, true /* value_is_full */);
+  ASSERT_NE(prefix_block->TEST_GetRestartKeyPrefixes(), nullptr);
+  ASSERT_GT(prefix_block->ApproximateMemoryUsage(),
+            plain_block->ApproximateMemoryUsage());
+
+  std::unique_ptr<DataBlockIter> plain_iter(
+      plain_block->NewDataIterator(ucmp(), kDisableGlobalSequenceNumber));
+  std::unique_ptr<DataBlockIter> prefix_iter(
+      prefix_block->NewDataIterator(ucmp(), kDisableGlobalSequenceNumber));
+  for (int i = 0; i < 5000; ++i) {
+    std::string target = RandomTarget(&rnd, keys);
+    plain_iter->Seek(target);
+    prefix_iter->Seek(target);
+    ASSERT_OK(prefix_iter->status());
+    ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+    if (plain_iter->Valid()) {
+      ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+    }
+
+    plain_iter->SeekForPrev(target);
+    prefix_iter->SeekForPrev(target);
+    ASSERT_OK(prefix_iter->status());
+    ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+    if (plain_iter->Valid()) {
+      ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+    }
+  }
+}
+
+TEST_P(RestartKeyPrefixTest, IndexBlockSeek) {
+  for (bool key_includes_seq : {true, false}) {
+    for (bool value_delta_encoding : {true, false}) {
+      Random rnd(302);
+      std::vector<std::string> keys = GenerateSortedInternalKeys(&rnd, 500);
+      if (!key_includes_seq) {
+        // Index keys must be unique, so keep one version per user key.
+        keys.erase(std::unique(keys.begin(), keys.end(),
+                               [](const std::string &a, const std::string &b) {
+                                 return ExtractUserKey(a) == ExtractUserKey(b);
+                               }),
+                   keys.end());
+      }
+      BlockBuilder builder(restartInterval(), true /* use_delta_encoding */,
+                           value_delta_encoding,
+                           BlockBasedTableOptions::kDataBlockBinarySearch,
+                           0.75 /* data_block_hash_table_util_ratio */,
+                           0 /* ts_sz */, true /* persist_user_defined_ts */,
+                           !key_includes_seq);
+      BlockHandle last_handle;
+      uint64_t offset = 0;
+      for (size_t i = 0; i < keys.size(); ++i) {
+        IndexValue entry(BlockHandle(offset, 100 + i), Slice());
+        offset += 100 + i + BlockBasedTable::kBlockTrailerSize;
+        std::string encoded_entry;
+        std::string delta_encoded_entry;
+        entry.EncodeTo(&encoded_entry, false /* have_first_key */, nullptr);
+        if (value_delta_encoding && i > 0) {
+          entry.EncodeTo(&delta_encoded_entry, false /* have_first_key */,
+                         &last_handle);
+        }
+        last_handle = entry.handle;
+        const Slice delta_encoded_entry_slice(delta_encoded_entry);
+        builder.Add(key_includes_seq ? Slice(keys[i]) : ExtractUserKey(keys[i]),
+                    encoded_entry, &delta_encoded_entry_slice);
+      }
+      Slice rawblock = builder.Finish();
+      Block plain_block{BlockContents(rawblock)};
+      Block prefix_block{BlockContents(rawblock)};
+      prefix_block.InitializeRestartKeyPrefixes(ucmp(), key_includes_seq,
+                                                !value_delta_encoding);
+      ASSERT_NE(prefix_block.TEST_GetRestartKeyPrefixes(), nullptr);
+
+      auto new_iter = [&](Block *block) {
+        return std::unique_ptr<IndexBlockIter>(block->NewIndexIterator(
+            ucmp(), kDisableGlobalSequenceNumber, nullptr /* iter */,
+            nullptr /* stats */, true /* total_order_seek */,
+            false /* have_first_key */, key_includes_seq,
+            !value_delta_encoding));
+      };
+      std::unique_ptr<IndexBlockIter> plain_iter = new_iter(&plain_block);
+      std::unique_ptr<IndexBlockIter> prefix_iter = new_iter(&prefix_block);
+      for (int i = 0; i < 5000; ++i) {
+        std::string target = RandomTarget(&rnd, keys);
+        plain_iter->Seek(target);
+        prefix_iter->Seek(target);
+        ASSERT_OK(prefix_iter->status());
+        ASSERT_EQ(plain_iter->Valid(), prefix_iter->Valid());
+        if (plain_iter->Valid()) {
+          ASSERT_EQ(plain_iter->key(), prefix_iter->key());
+          ASSERT_EQ(plain_iter->value().handle.offset(),
+                    prefix_iter->value().handle.offset());
+        }
+      }
+    }
+  }
+}
+
+TEST_P(RestartKeyPrefixTest, UnsupportedComparator) {
+  Random rnd(303);
+  std::vector<std::string> keys = GenerateSortedInternalKeys(&rnd, 10);
+  BlockBuilder builder(restartInterval());
+  for (const auto &key : keys) {
+    builder.Add(key, "v");
+  }
+  Slice rawblock = builder.Finish();
+  Block block{BlockContents(rawblock)};
+  block.InitializeRestartKeyPrefixes(test::BytewiseComparatorWithU64TsWrapper(),
+                                     true /* key_includes_seq */,
+                                     true /* value_is_full */);
+  ASSERT_EQ(block.TEST_GetRestartKeyPrefixes(), nullptr);
+}
+
+INSTANTIATE_TEST_CASE_P(P, RestartKeyPrefixTest,
+                        ::testing::Combine(::testing::Bool(),
+                                           ::testing::Values(1, 4, 16)));
+
+class LearnedIndexTest : public testing::Test,
+                         public testing::WithParamInterface<int> {
+ public:
+  int restartInterval() const { return GetParam(); }
+
+  static std::string BigEndianKey(uint64_t n, const std::string &suffix) {
+    std::string key(sizeof(n), '\0');
+    for (size_t i = 0; i < sizeof(n); ++i) {
+      key[i] = static_cast<char>(n >> (56 - 8 * i));
+    }
+    return key + suffix;
+  }
+};
+
+TEST_P(LearnedIndexTest, IndexBlockSeek) {
+  Random rnd(304);
+  // Dense and sparse regions, and some keys sharing their first 8 bytes
+  std::vector<std::string> keys;
+  uint64_t n = 1000;
+  for (int i = 0; i < 5000; ++i) {
+    n += (i / 1000) % 2 == 0 ? 1 + rnd.Uniform(10) : 1 + rnd.Uniform(100000);
+    keys.push_back(BigEndianKey(n, ""));
+    if (rnd.OneIn(20)) {
+      keys.push_back(BigEndianKey(n, "x"));
+    }
+  }
+
+  BlockBuilder builder(restartInterval(), true /* use_delta_encoding */,
+                       false /* use_value_delta_encoding */,
+                       BlockBasedTableOptions::kDataBlockBinarySearch,
+                       0.75 /* data_block_hash_table_util_ratio */,
+                       0 /* ts_sz */, true /* persist_user_defined_ts */,
+                       true /* is_user_key */);
+  LearnedIndexModelBuilder model_builder(2 /* max_error */);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    IndexValue entry(BlockHandle(i * 1000, 900), Slice());
+    std::string encoded_entry;
+    entry.EncodeTo(&encoded_entry, false /* have_first_key */, nullptr);
+    builder.Add(keys[i], encoded_entry);
+    if (i % restartInterval() == 0) {
+      model_builder.AddRestartKey(keys[i]);
+    }
+  }
+  Slice rawblock = builder.Finish();
+  Block block{BlockContents(rawblock)};
+  std::string model_contents = model_builder.Finish();
+  std::unique_ptr<LearnedIndexModel> model =
+      LearnedIndexModel::Create(model_contents);
+  ASSERT_NE(model, nullptr);
+  const size_t num_restarts =
+      (keys.size() + restartInterval() - 1) / restartInterval();
+  // Much smaller than the index keys
+  ASSERT_LT(model->TEST_NumSegments(), num_restarts / 4);
+
+  auto new_iter = [&](const LearnedIndexModel *m) {
+    std::unique_ptr<IndexBlockIter> iter(block.NewIndexIterator(
+        BytewiseComparator(), kDisableGlobalSequenceNumber, nullptr /* iter */,
+        nullptr /* stats */, true /* total_order_seek */,
+        false /* have_first_key */, false /* key_includes_seq */,
+        true /* value_is_full */));
+    iter->SetLearnedIndexModel(m);
+    return iter;
+  };
+  std::unique_ptr<IndexBlockIter> plain_iter = new_iter(nullptr);
+  std::unique_ptr<IndexBlockIter> model_iter = new_iter(model.get());
+  for (int i = 0; i < 20000; ++i) {
+    std::string target;
+    if (rnd.OneIn(2)) {
+      target = keys[rnd.Uniform(static_cast<int>(keys.size()))];
+    } else {
+      target = BigEndianKey(rnd.Uniform(static_cast<int>(n + 2000)),
+                            rnd.OneIn(2) ? "" : "y");
+    }
+    AppendInternalKeyFooter(&target, rnd.Uniform(300), kTypeValue);
+    plain_iter->Seek(target);
+    model_iter->Seek(target);
+    ASSERT_OK(model_iter->status());
+    ASSERT_EQ(plain_iter->Valid(), model_iter->Valid());
+    if (plain_iter->Valid()) {
+      ASSERT_EQ(plain_iter->key(), model_iter->key());
+      ASSERT_EQ(plain_iter->value().handle.offset(),
+                model_iter->value().handle.offset());
+    }
+  }
+
+  // A model for a different block is ignored
+  int64_t left = 7;
+  int64_t right = 7;
+  ASSERT_FALSE(model->GetRestartRange(keys[0], 3, &left, &right));
+  ASSERT_EQ(left, 7);
+  ASSERT_EQ(right, 7);
+}
+
+TEST_F(LearnedIndexTest, NoModel) {
+  // Too few restart keys for a model to help
+  LearnedIndexModelBuilder small_builder(2 /* max_error */);
+  for (uint64_t i = 0; i < 8; ++i) {
+    small_builder.AddRestartKey(BigEndianKey(i, ""));
+  }
+  ASSERT_TRUE(small_builder.Finish().empty());
+
+  // Keys that only differ after their first 8 bytes
+  LearnedIndexModelBuilder shared_builder(2 /* max_error */);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    shared_builder.AddRestartKey(BigEndianKey(42, std::to_string(i)));
+  }
+  ASSERT_TRUE(shared_builder.Finish().empty());
+
+  ASSERT_EQ(LearnedIndexModel::Create(Slice()), nullptr);
+  ASSERT_EQ(LearnedIndexModel::Create("garbage"), nullptr);
+}
+
+INSTANTIATE_TEST_CASE_P(P, LearnedIndexTest, ::testing::Values(1, 4, 16));
+
 class BlockPerKVChecksumTest : public DBTestBase {
  public:
   BlockPerKVChecksumTest()
@@ -12,6 +12,7 @@
 #include <array>
 #include <atomic>
 #include <climits>
+#include <cmath>
 #include <cstring>
 #include <deque>
 #include <limits>
@@ -1806,6 +1807,101 @@ FilterPolicy* NewRibbonFilterPolicy(double bloom_equivalent_bits_per_key,
                                 bloom_before_level);
 }
 
+LevelAdaptiveFilterPolicy::LevelAdaptiveFilterPolicy(
+    double bloom_equivalent_bits_per_key, int bloom_before_level)
+    : BloomLikeFilterPolicy(bloom_equivalent_bits_per_key),
+      bloom_before_level_(bloom_before_level) {}
+
+double LevelAdaptiveFilterPolicy::GetBitsPerKey(
+    const FilterBuildingContext& context) const {
+  const double avg_bits_per_key = GetMillibitsPerKey() / 1000.0;
+  const std::vector<uint64_t>& data_bytes = context.level_data_bytes;
+  const std::vector<uint64_t>& lookup_misses =
+      context.level_point_lookup_misses;
+  const int level = context.level_at_creation;
+  if (level < 0 || static_cast<size_t>(level) >= data_bytes.size()) {
+    return avg_bits_per_key;
+  }
+  auto misses_at = [&](size_t l) -> uint64_t {
+    return l < lookup_misses.size() ? lookup_misses[l] : 0;
+  };
+  uint64_t total_bytes = 0;
+  uint64_t total_misses = 0;
+  size_t num_levels_with_data = 0;
+  for (size_t l = 0; l < data_bytes.size(); ++l) {
+    if (data_bytes[l] > 0) {
+      total_bytes += data_bytes[l];
+      total_misses += misses_at(l);
+      ++num_levels_with_data;
+    }
+  }
+  if (total_bytes == 0) {
+    return avg_bits_per_key;
+  }
+  // Every level is assumed to get at least a tenth of an even share of the
+  // misses, so that levels without sampled lookups still get filters and
+  // the allocation without any samples only depends on the level sizes.
+  const double prior_misses =
+      1.0 + static_cast<double>(total_misses) /
+                (10.0 * static_cast<double>(num_levels_with_data));
+  auto log_weight = [&](size_t l) {
+    double bytes = static_cast<double>(std::max(data_bytes[l], uint64_t{1}));
+    return std::log(bytes / (static_cast<double>(misses_at(l)) + prior_misses));
+  };
+  // Minimizing sum(misses[l] * fp_rate[l]) for a fixed total filter size,
+  // where fp_rate[l] ~ exp(-ln(2)^2 * bits_per_key[l]), gives fp_rate[l]
+  // proportional to data_bytes[l] / misses[l]. Averaging the bits per key
+  // over all data to avg_bits_per_key then gives
+  //   bits_per_key[l] = avg_bits_per_key +
+  //       (avg(log_weight) - log_weight[l]) / ln(2)^2
+  double avg_log_weight = 0.0;
+  for (size_t l = 0; l < data_bytes.size(); ++l) {
+    if (data_bytes[l] > 0) {
+      avg_log_weight += static_cast<double>(data_bytes[l]) /
+                        static_cast<double>(total_bytes) * log_weight(l);
+    }
+  }
+  const double kLn2Squared = std::log(2.0) * std::log(2.0);
+  double bits_per_key =
+      avg_bits_per_key +
+      (avg_log_weight - log_weight(static_cast<size_t>(level))) / kLn2Squared;
+  return std::max(0.0, std::min(bits_per_key, 2.0 * avg_bits_per_key));
+}
+
+FilterBitsBuilder* LevelAdaptiveFilterPolicy::GetBuilderWithContext(
+    const FilterBuildingContext& context) const {
+  // Round to tenths of a bit per key to bound the number of policies kept.
+  int tenths = static_cast<int>(GetBitsPerKey(context) * 10.0 + 0.5);
+  RibbonFilterPolicy* policy;
+  {
+    std::lock_guard<std::mutex> lock(policies_mutex_);
+    std::unique_ptr<RibbonFilterPolicy>& entry = policies_[tenths];
+    if (!entry) {
+      entry.reset(new RibbonFilterPolicy(tenths / 10.0, bloom_before_level_));
+    }
+    policy = entry.get();
+  }
+  return policy->GetBuilderWithContext(context);
+}
+
+const char* LevelAdaptiveFilterPolicy::kClassName() {
+  return "leveladaptivefilter";
+}
+const char* LevelAdaptiveFilterPolicy::kNickName() {
+  return "rocksdb.LevelAdaptiveFilter";
+}
+
+std::string LevelAdaptiveFilterPolicy::GetId() const {
+  return BloomLikeFilterPolicy::GetId() + ":" +
+         std::to_string(bloom_before_level_);
+}
+
+FilterPolicy* NewLevelAdaptiveFilterPolicy(double bloom_equivalent_bits_per_key,
+                                           int bloom_before_level) {
+  return new LevelAdaptiveFilterPolicy(bloom_equivalent_bits_per_key,
+                                       bloom_before_level);
+}
+
 FilterBuildingContext::FilterBuildingContext(
     const BlockBasedTableOptions& _table_options)
     : table_options(_table_options) {}
@@ -1908,6 +2004,29 @@ static int RegisterBuiltinFilterPolicies(ObjectLibrary& library,
         guard->reset(NewRibbonFilterPolicy(bits_per_key, bloom_before_level));
         return guard->get();
       });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(LevelAdaptiveFilterPolicy::kClassName())
+          .AnotherName(LevelAdaptiveFilterPolicy::kNickName()),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        double bits_per_key = ParseDouble(vals[1]);
+        guard->reset(NewLevelAdaptiveFilterPolicy(bits_per_key));
+        return guard->get();
+      });
+  library.AddFactory<const FilterPolicy>(
+      FilterPatternEntryWithBits(LevelAdaptiveFilterPolicy::kClassName())
+          .AnotherName(LevelAdaptiveFilterPolicy::kNickName())
+          .AddNumber(":", true),
+      [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
+         std::string* /* errmsg */) {
+        const std::vector<std::string> vals = StringSplit(uri, ':');
+        double bits_per_key = ParseDouble(vals[1]);
+        int bloom_before_level = ParseInt(vals[2]);
+        guard->reset(
+            NewLevelAdaptiveFilterPolicy(bits_per_key, bloom_before_level));
+        return guard->get();
+      });
   library.AddFactory<const FilterPolicy>(
       FilterPatternEntryWithBits(test::LegacyBloomFilterPolicy::kClassName()),
       [](const std::string& uri, std::unique_ptr<const FilterPolicy>* guard,
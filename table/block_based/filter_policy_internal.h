@@ -9,7 +9,9 @@
 #pragma once
 
 #include <atomic>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -297,6 +299,36 @@ class RibbonFilterPolicy : public BloomLikeFilterPolicy {
   std::atomic<int> bloom_before_level_;
 };
 
+// For NewLevelAdaptiveFilterPolicy
+//
+// This is a user-facing policy that picks the bits per key of each filter
+// from the per-level statistics in the context, and defers to a
+// RibbonFilterPolicy with those bits per key to build it.
+class LevelAdaptiveFilterPolicy : public BloomLikeFilterPolicy {
+ public:
+  explicit LevelAdaptiveFilterPolicy(double bloom_equivalent_bits_per_key,
+                                     int bloom_before_level);
+
+  FilterBitsBuilder* GetBuilderWithContext(
+      const FilterBuildingContext&) const override;
+
+  // Returns the bits per key (Bloom equivalent) of a filter built in
+  // `context`, before rounding.
+  double GetBitsPerKey(const FilterBuildingContext& context) const;
+
+  static const char* kClassName();
+  const char* Name() const override { return kClassName(); }
+  static const char* kNickName();
+  const char* NickName() const override { return kNickName(); }
+  std::string GetId() const override;
+
+ private:
+  const int bloom_before_level_;
+  // Policies to build filters with, by tenths of bits per key
+  mutable std::mutex policies_mutex_;
+  mutable std::map<int, std::unique_ptr<RibbonFilterPolicy>> policies_;
+};
+
 // For testing only, but always constructable with internal names
 namespace test {
 
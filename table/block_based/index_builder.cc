@@ -57,6 +57,13 @@ IndexBuilder* IndexBuilder::CreateIndexBuilder(
           persist_user_defined_timestamps);
       break;
     }
+    case BlockBasedTableOptions::kLearnedIndexSearch: {
+      result = new LearnedIndexBuilder(
+          comparator, table_opt.index_block_restart_interval,
+          table_opt.format_version, use_value_delta_encoding,
+          table_opt.index_shortening, ts_sz, persist_user_defined_timestamps);
+      break;
+    }
     case BlockBasedTableOptions::kBinarySearchWithFirstKey: {
       result = new ShortenedIndexBuilder(
           comparator, table_opt.index_block_restart_interval,
@@ -18,6 +18,7 @@
 #include "rocksdb/comparator.h"
 #include "table/block_based/block_based_table_factory.h"
 #include "table/block_based/block_builder.h"
+#include "table/block_based/learned_index.h"
 #include "table/format.h"
 
 namespace ROCKSDB_NAMESPACE {
@@ -419,6 +420,81 @@ class HashIndexBuilder : public IndexBuilder {
   uint64_t current_restart_index_ = 0;
 };
 
+// LearnedIndexBuilder writes a regular binary search index block plus a
+// piecewise linear model of its restart keys, see
+// BlockBasedTableOptions::kLearnedIndexSearch. The model is only built for
+// BytewiseComparator.
+class LearnedIndexBuilder : public IndexBuilder {
+ public:
+  LearnedIndexBuilder(
+      const InternalKeyComparator* comparator, int index_block_restart_interval,
+      int format_version, bool use_value_delta_encoding,
+      BlockBasedTableOptions::IndexShorteningMode shortening_mode,
+      size_t ts_sz, const bool persist_user_defined_timestamps)
+      : IndexBuilder(comparator, ts_sz, persist_user_defined_timestamps),
+        primary_index_builder_(comparator, index_block_restart_interval,
+                               format_version, use_value_delta_encoding,
+                               shortening_mode, /* include_first_key */ false,
+                               ts_sz, persist_user_defined_timestamps),
+        index_block_restart_interval_(index_block_restart_interval) {
+    if (comparator->user_comparator() == BytewiseComparator()) {
+      model_builder_.reset(new LearnedIndexModelBuilder(kMaxError));
+    }
+  }
+
+  void AddIndexEntry(std::string* last_key_in_current_block,
+                     const Slice* first_key_in_next_block,
+                     const BlockHandle& block_handle) override {
+    primary_index_builder_.AddIndexEntry(last_key_in_current_block,
+                                         first_key_in_next_block, block_handle);
+    // The primary index builder leaves the separator it added in
+    // *last_key_in_current_block.
+    if (model_builder_ != nullptr &&
+        num_entries_ % index_block_restart_interval_ == 0) {
+      model_builder_->AddRestartKey(
+          ExtractUserKey(*last_key_in_current_block));
+    }
+    ++num_entries_;
+  }
+
+  void OnKeyAdded(const Slice& key) override {
+    primary_index_builder_.OnKeyAdded(key);
+  }
+
+  Status Finish(IndexBlocks* index_blocks,
+                const BlockHandle& last_partition_block_handle) override {
+    Status s = primary_index_builder_.Finish(index_blocks,
+                                             last_partition_block_handle);
+    if (model_builder_ != nullptr) {
+      model_block_ = model_builder_->Finish();
+      if (!model_block_.empty()) {
+        index_blocks->meta_blocks.insert(
+            {kLearnedIndexModelBlock.c_str(), model_block_});
+      }
+    }
+    return s;
+  }
+
+  size_t IndexSize() const override {
+    return primary_index_builder_.IndexSize() + model_block_.size();
+  }
+
+  bool seperator_is_key_plus_seq() override {
+    return primary_index_builder_.seperator_is_key_plus_seq();
+  }
+
+ private:
+  // Maximum distance between the predicted and the actual restart point of a
+  // key that the model is fitted for
+  static constexpr uint32_t kMaxError = 2;
+
+  ShortenedIndexBuilder primary_index_builder_;
+  const int index_block_restart_interval_;
+  std::unique_ptr<LearnedIndexModelBuilder> model_builder_;
+  uint64_t num_entries_ = 0;
+  std::string model_block_;
+};
+
 /**
  * IndexBuilder for two-level indexing. Internally it creates a new index for
  * each partition and Finish then in order when Finish is called on it
@@ -0,0 +1,221 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/learned_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "util/coding.h"
+#include "util/math.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+const std::string kLearnedIndexModelBlock = "rocksdb.learnedindex.model";
+
+namespace {
+constexpr char kLearnedIndexFormatVersion = 1;
+
+uint64_t KeyPrefix(const Slice& user_key) {
+  char buf[sizeof(uint64_t)] = {};
+  memcpy(buf, user_key.data(), std::min(user_key.size(), sizeof(buf)));
+  // Big-endian so that the order of prefixes matches the order of keys
+  return EndianSwapValue(DecodeFixed64(buf));
+}
+
+// Position of `prefix` predicted by the segment starting at `first_prefix`
+// and `first_restart`, where `end_restart` is the first restart of the next
+// segment. Monotonic in `prefix` as long as `slope` >= 0.
+double Predict(uint64_t first_prefix, double slope, uint32_t first_restart,
+               uint32_t end_restart, uint64_t prefix) {
+  double pred = static_cast<double>(first_restart) +
+                slope * static_cast<double>(prefix - first_prefix);
+  return std::min(pred, static_cast<double>(end_restart));
+}
+}  // namespace
+
+std::unique_ptr<LearnedIndexModel> LearnedIndexModel::Create(
+    const Slice& contents) {
+  Slice input = contents;
+  if (input.empty() || input[0] != kLearnedIndexFormatVersion) {
+    return nullptr;
+  }
+  input.remove_prefix(1);
+  std::unique_ptr<LearnedIndexModel> model(new LearnedIndexModel());
+  uint32_t num_segments = 0;
+  if (!GetVarint32(&input, &model->num_restarts_) ||
+      !GetVarint32(&input, &model->max_error_) ||
+      !GetVarint32(&input, &model->max_run_) ||
+      !GetVarint32(&input, &num_segments) || num_segments == 0 ||
+      num_segments > model->num_restarts_) {
+    return nullptr;
+  }
+  model->first_prefixes_.reserve(num_segments);
+  model->segments_.reserve(num_segments);
+  for (uint32_t i = 0; i < num_segments; ++i) {
+    uint64_t first_prefix = 0;
+    uint64_t slope_bits = 0;
+    Segment segment;
+    if (!GetFixed64(&input, &first_prefix) ||
+        !GetFixed64(&input, &slope_bits) ||
+        !GetFixed32(&input, &segment.first_restart)) {
+      return nullptr;
+    }
+    memcpy(&segment.slope, &slope_bits, sizeof(segment.slope));
+    // Segments must cover all restarts in order with monotonic predictions
+    if (!std::isfinite(segment.slope) || segment.slope < 0 ||
+        segment.first_restart >= model->num_restarts_ ||
+        (i == 0 && segment.first_restart != 0) ||
+        (i > 0 && (first_prefix <= model->first_prefixes_.back() ||
+                   segment.first_restart <=
+                       model->segments_.back().first_restart))) {
+      return nullptr;
+    }
+    model->first_prefixes_.push_back(first_prefix);
+    model->segments_.push_back(segment);
+  }
+  if (!input.empty()) {
+    return nullptr;
+  }
+  return model;
+}
+
+bool LearnedIndexModel::GetRestartRange(const Slice& user_key,
+                                        uint32_t num_restarts, int64_t* left,
+                                        int64_t* right) const {
+  if (num_restarts != num_restarts_) {
+    return false;
+  }
+  const uint64_t prefix = KeyPrefix(user_key);
+  size_t i = std::upper_bound(first_prefixes_.begin(), first_prefixes_.end(),
+                              prefix) -
+             first_prefixes_.begin();
+  if (i == 0) {
+    // All restart keys are greater
+    *left = *right = -1;
+    return true;
+  }
+  --i;
+  const uint32_t end_restart = i + 1 < segments_.size()
+                                   ? segments_[i + 1].first_restart
+                                   : num_restarts_;
+  double pred = Predict(first_prefixes_[i], segments_[i].slope,
+                        segments_[i].first_restart, end_restart, prefix);
+  // The prediction is within max_error_ of the first restart with the
+  // largest prefix not greater than `prefix`, and up to max_run_ restart
+  // keys share that prefix.
+  const int64_t slack = static_cast<int64_t>(max_run_) + max_error_;
+  const int64_t last = static_cast<int64_t>(num_restarts_) - 1;
+  *left = std::clamp(static_cast<int64_t>(std::floor(pred)) - slack - 1,
+                     int64_t{-1}, last);
+  *right = std::clamp(static_cast<int64_t>(std::ceil(pred)) + slack - 1,
+                      int64_t{-1}, last);
+  return true;
+}
+
+size_t LearnedIndexModel::ApproximateMemoryUsage() const {
+  return sizeof(*this) + first_prefixes_.capacity() * sizeof(uint64_t) +
+         segments_.capacity() * sizeof(Segment);
+}
+
+LearnedIndexModelBuilder::LearnedIndexModelBuilder(uint32_t max_error)
+    : max_error_(max_error) {}
+
+void LearnedIndexModelBuilder::AddRestartKey(const Slice& user_key) {
+  assert(prefixes_.empty() || KeyPrefix(user_key) >= prefixes_.back());
+  prefixes_.push_back(KeyPrefix(user_key));
+}
+
+std::string LearnedIndexModelBuilder::Finish() {
+  const uint32_t num_restarts = static_cast<uint32_t>(prefixes_.size());
+  // Fit the first restart of each distinct prefix
+  std::vector<uint64_t> xs;
+  std::vector<uint32_t> ys;
+  for (uint32_t i = 0; i < num_restarts; ++i) {
+    if (i == 0 || prefixes_[i] != prefixes_[i - 1]) {
+      xs.push_back(prefixes_[i]);
+      ys.push_back(i);
+    }
+  }
+  uint32_t max_run = 0;
+  for (size_t k = 0; k < ys.size(); ++k) {
+    uint32_t end = k + 1 < ys.size() ? ys[k + 1] : num_restarts;
+    max_run = std::max(max_run, end - ys[k]);
+  }
+  if ((uint64_t{max_run} + max_error_) * 4 >= num_restarts) {
+    // Binary search over the whole block is about as cheap
+    return std::string();
+  }
+
+  // Greedily extend each segment while some slope keeps all of its points
+  // within max_error_ of their position ("shrinking cone").
+  struct FittedSegment {
+    size_t first_point;
+    double slope;
+  };
+  std::vector<FittedSegment> segments;
+  const double eps = static_cast<double>(max_error_);
+  size_t start = 0;
+  double lo = -std::numeric_limits<double>::infinity();
+  double hi = std::numeric_limits<double>::infinity();
+  for (size_t k = 1; k <= xs.size(); ++k) {
+    if (k < xs.size()) {
+      double dx = static_cast<double>(xs[k] - xs[start]);
+      double dy = static_cast<double>(ys[k]) - static_cast<double>(ys[start]);
+      double new_lo = std::max(lo, (dy - eps) / dx);
+      double new_hi = std::min(hi, (dy + eps) / dx);
+      if (new_lo <= new_hi) {
+        lo = new_lo;
+        hi = new_hi;
+        continue;
+      }
+    }
+    double slope = k - start > 1 ? std::max(0.0, (lo + hi) / 2) : 0.0;
+    segments.push_back({start, slope});
+    start = k;
+    lo = -std::numeric_limits<double>::infinity();
+    hi = std::numeric_limits<double>::infinity();
+  }
+
+  // Measure the actual error, including rounding and clamping, the way
+  // lookups compute predictions
+  double max_error = 0;
+  for (size_t s = 0; s < segments.size(); ++s) {
+    size_t first = segments[s].first_point;
+    size_t end = s + 1 < segments.size() ? segments[s + 1].first_point
+                                         : xs.size();
+    uint32_t end_restart = end < xs.size() ? ys[end] : num_restarts;
+    for (size_t k = first; k < end; ++k) {
+      double pred = Predict(xs[first], segments[s].slope, ys[first],
+                            end_restart, xs[k]);
+      max_error = std::max(max_error, std::fabs(pred - ys[k]));
+    }
+  }
+
+  const uint32_t max_error_rounded =
+      static_cast<uint32_t>(std::ceil(max_error));
+  if ((uint64_t{max_run} + max_error_rounded) * 4 >= num_restarts) {
+    return std::string();
+  }
+
+  std::string result;
+  result.push_back(kLearnedIndexFormatVersion);
+  PutVarint32(&result, num_restarts);
+  PutVarint32(&result, max_error_rounded);
+  PutVarint32(&result, max_run);
+  PutVarint32(&result, static_cast<uint32_t>(segments.size()));
+  for (const auto& segment : segments) {
+    uint64_t slope_bits;
+    memcpy(&slope_bits, &segment.slope, sizeof(slope_bits));
+    PutFixed64(&result, xs[segment.first_point]);
+    PutFixed64(&result, slope_bits);
+    PutFixed32(&result, ys[segment.first_point]);
+  }
+  return result;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,90 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rocksdb/slice.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+// Name of the meta block holding the model of
+// BlockBasedTableOptions::kLearnedIndexSearch
+extern const std::string kLearnedIndexModelBlock;
+
+// A piecewise linear model of the position of a key among the restart points
+// of an index block, in the spirit of FITing-tree and PGM-index. Keys are
+// mapped to the big-endian integer of their first 8 bytes (zero padded), which
+// is monotonic in bytewise order. Each segment covers a run of restart keys
+// and predicts the restart index of a key prefix within a known error bound,
+// so a seek only needs to binary search a few restart points around the
+// prediction.
+//
+// Block format:
+//   [format version: 1 byte][num restarts: varint32][max error: varint32]
+//   [max run: varint32][num segments: varint32]
+//   num segments * [first prefix: fixed64][slope: fixed64 (IEEE 754 double)]
+//                  [first restart: fixed32]
+class LearnedIndexModel {
+ public:
+  // Returns nullptr if `contents` is not a supported model.
+  static std::unique_ptr<LearnedIndexModel> Create(const Slice& contents);
+
+  // Narrows the restart point binary search for `user_key` in an index block
+  // with `num_restarts` restart points: the last restart key not greater than
+  // the seek key is within [*left, *right], where -1 stands for none. Returns
+  // false, leaving the outputs untouched, if the model was not built for a
+  // block with that many restart points.
+  bool GetRestartRange(const Slice& user_key, uint32_t num_restarts,
+                       int64_t* left, int64_t* right) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+  size_t TEST_NumSegments() const { return first_prefixes_.size(); }
+
+ private:
+  struct Segment {
+    double slope;
+    uint32_t first_restart;
+  };
+
+  LearnedIndexModel() = default;
+
+  uint32_t num_restarts_ = 0;
+  // Maximum distance between the predicted and the actual position of a
+  // distinct prefix, rounded up
+  uint32_t max_error_ = 0;
+  // Maximum number of restart keys sharing a prefix
+  uint32_t max_run_ = 0;
+  // Sorted, for finding the segment of a key prefix
+  std::vector<uint64_t> first_prefixes_;
+  std::vector<Segment> segments_;
+};
+
+class LearnedIndexModelBuilder {
+ public:
+  // `max_error` bounds the distance between the prediction of a segment and
+  // the actual position for the keys used to fit it.
+  explicit LearnedIndexModelBuilder(uint32_t max_error);
+
+  // REQUIRES: called for every restart key of the index block, in bytewise
+  // order
+  void AddRestartKey(const Slice& user_key);
+
+  // Returns the contents of the model block, or an empty string if a model
+  // would not narrow the search much, e.g. because many restart keys share
+  // their first 8 bytes.
+  std::string Finish();
+
+ private:
+  const uint32_t max_error_;
+  std::vector<uint64_t> prefixes_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,166 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "table/block_based/range_filter.h"
+
+#include <algorithm>
+
+#include "rocksdb/table.h"
+#include "table/block_based/filter_policy_internal.h"
+#include "util/coding.h"
+#include "util/math.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+const std::string kRangeFilterBlockName = "rocksdb.range_filter";
+
+namespace {
+constexpr char kRangeFilterFormatVersion = 1;
+constexpr int kBitsPerLevel = 4;
+constexpr int kNumLevels = 5;
+// A range is only checked if it spans at most this many prefixes at the
+// coarsest level.
+constexpr uint64_t kMaxTopLevelPrefixes = 16;
+constexpr size_t kHeaderSize = 3;
+constexpr size_t kEntrySize = 1 + sizeof(uint64_t);
+
+uint64_t KeyPrefix(const Slice& user_key) {
+  char buf[sizeof(uint64_t)] = {};
+  memcpy(buf, user_key.data(), std::min(user_key.size(), sizeof(buf)));
+  // Big-endian so that the order of prefixes matches the order of keys
+  return EndianSwapValue(DecodeFixed64(buf));
+}
+
+void EncodeEntry(int level, uint64_t prefix, char* buf) {
+  buf[0] = static_cast<char>(level);
+  EncodeFixed64(buf + 1, prefix);
+}
+}  // namespace
+
+RangeFilterBuilder::RangeFilterBuilder(double bits_per_key)
+    : bits_per_key_(bits_per_key) {}
+
+void RangeFilterBuilder::AddKey(const Slice& user_key) {
+  uint64_t key_prefix = KeyPrefix(user_key);
+  char buf[kEntrySize];
+  for (int level = 0; level < kNumLevels; ++level) {
+    int shift = level * kBitsPerLevel;
+    // Keys arrive sorted, so a prefix is new iff it differs from the one of
+    // the previous key.
+    if (num_keys_ > 0 &&
+        (key_prefix >> shift) == (last_key_prefix_ >> shift)) {
+      break;
+    }
+    EncodeEntry(level, key_prefix >> shift, buf);
+    entries_.append(buf, kEntrySize);
+    ++num_entries_;
+  }
+  last_key_prefix_ = key_prefix;
+  ++num_keys_;
+}
+
+Slice RangeFilterBuilder::Finish(std::unique_ptr<const char[]>* buf) {
+  if (num_entries_ == 0) {
+    return Slice();
+  }
+  // Spread the memory of bits_per_key_ over all entries
+  double bits_per_entry = bits_per_key_ * static_cast<double>(num_keys_) /
+                          static_cast<double>(num_entries_);
+  BloomFilterPolicy policy(bits_per_entry);
+  BlockBasedTableOptions table_options;
+  FilterBuildingContext context(table_options);
+  std::unique_ptr<FilterBitsBuilder> bits_builder(
+      policy.GetBuilderWithContext(context));
+  if (bits_builder == nullptr) {
+    return Slice();
+  }
+  for (size_t i = 0; i < num_entries_; ++i) {
+    bits_builder->AddKey(Slice(entries_.data() + i * kEntrySize, kEntrySize));
+  }
+  std::unique_ptr<const char[]> filter_buf;
+  Slice filter = bits_builder->Finish(&filter_buf);
+
+  char* data = new char[kHeaderSize + filter.size()];
+  data[0] = kRangeFilterFormatVersion;
+  data[1] = static_cast<char>(kBitsPerLevel);
+  data[2] = static_cast<char>(kNumLevels);
+  memcpy(data + kHeaderSize, filter.data(), filter.size());
+  buf->reset(data);
+  return Slice(data, kHeaderSize + filter.size());
+}
+
+std::unique_ptr<RangeFilterReader> RangeFilterReader::Create(
+    BlockContents&& contents) {
+  const Slice& data = contents.data;
+  if (data.size() <= kHeaderSize || data[0] != kRangeFilterFormatVersion ||
+      data[1] != static_cast<char>(kBitsPerLevel) ||
+      data[2] != static_cast<char>(kNumLevels)) {
+    return nullptr;
+  }
+  std::unique_ptr<FilterBitsReader> bits_reader(
+      BuiltinFilterPolicy::GetBuiltinFilterBitsReader(
+          Slice(data.data() + kHeaderSize, data.size() - kHeaderSize)));
+  return std::unique_ptr<RangeFilterReader>(
+      new RangeFilterReader(std::move(contents), std::move(bits_reader)));
+}
+
+RangeFilterReader::RangeFilterReader(
+    BlockContents&& contents, std::unique_ptr<FilterBitsReader>&& bits_reader)
+    : contents_(std::move(contents)), bits_reader_(std::move(bits_reader)) {}
+
+RangeFilterReader::~RangeFilterReader() = default;
+
+bool RangeFilterReader::PrefixMayMatch(int level, uint64_t prefix) const {
+  char buf[kEntrySize];
+  EncodeEntry(level, prefix, buf);
+  return bits_reader_->MayMatch(Slice(buf, kEntrySize));
+}
+
+bool RangeFilterReader::LevelRangeMayMatch(int level, uint64_t lower,
+                                           uint64_t upper) const {
+  const int shift = level * kBitsPerLevel;
+  const uint64_t low_bits = (uint64_t{1} << shift) - 1;
+  for (uint64_t prefix = lower >> shift;; ++prefix) {
+    if (PrefixMayMatch(level, prefix)) {
+      if (level == 0) {
+        return true;
+      }
+      uint64_t sub_lower = std::max(lower, prefix << shift);
+      uint64_t sub_upper = std::min(upper, (prefix << shift) | low_bits);
+      if (LevelRangeMayMatch(level - 1, sub_lower, sub_upper)) {
+        return true;
+      }
+    }
+    if (prefix == upper >> shift) {
+      return false;
+    }
+  }
+}
+
+bool RangeFilterReader::RangeMayMatch(const Slice* lower,
+                                      const Slice& upper) const {
+  // Keys in [lower, upper) have prefixes in [KeyPrefix(lower),
+  // KeyPrefix(upper)], as prefixes are monotonic in bytewise order.
+  uint64_t lower_prefix = lower != nullptr ? KeyPrefix(*lower) : 0;
+  uint64_t upper_prefix = KeyPrefix(upper);
+  if (lower_prefix > upper_prefix) {
+    // Empty range
+    return false;
+  }
+  constexpr int kTopLevel = kNumLevels - 1;
+  constexpr int kTopShift = kTopLevel * kBitsPerLevel;
+  if ((upper_prefix >> kTopShift) - (lower_prefix >> kTopShift) >=
+      kMaxTopLevelPrefixes) {
+    // Too wide to check cheaply
+    return true;
+  }
+  return LevelRangeMayMatch(kTopLevel, lower_prefix, upper_prefix);
+}
+
+size_t RangeFilterReader::ApproximateMemoryUsage() const {
+  return sizeof(*this) + contents_.ApproximateMemoryUsage();
+}
+
+}  // namespace ROCKSDB_NAMESPACE
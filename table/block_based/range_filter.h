@@ -0,0 +1,79 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "rocksdb/slice.h"
+#include "table/format.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class FilterBitsReader;
+
+// Name of the range filter block in the metaindex
+extern const std::string kRangeFilterBlockName;
+
+// A range filter answers whether an SST file may have a user key in a range,
+// for BlockBasedTableOptions::range_filter_bits_per_key. In the spirit of
+// Rosetta (SIGMOD 2020), it is a single Bloom filter over the prefixes of
+// every key at several granularities: a key is mapped to the big-endian
+// integer of its first 8 bytes (zero padded), which is monotonic in bytewise
+// order, and the prefixes of that integer dropping 0, 4, 8, 12 and 16 low
+// bits are added. A range is checked by probing the coarsest prefixes it
+// spans and descending only into those that may match, so that a miss
+// usually takes a few probes.
+//
+// Block format:
+//   [format version: 1 byte][bits per level: 1 byte][levels: 1 byte]
+//   [built-in filter contents]
+class RangeFilterBuilder {
+ public:
+  explicit RangeFilterBuilder(double bits_per_key);
+
+  // REQUIRES: keys are added in bytewise order
+  void AddKey(const Slice& user_key);
+
+  bool empty() const { return num_keys_ == 0; }
+
+  // Returns the contents of the filter block, backed by `buf`.
+  Slice Finish(std::unique_ptr<const char[]>* buf);
+
+ private:
+  const double bits_per_key_;
+  uint64_t num_keys_ = 0;
+  uint64_t last_key_prefix_ = 0;
+  // Fixed-size entries (level, prefix) to add to the Bloom filter
+  std::string entries_;
+  size_t num_entries_ = 0;
+};
+
+class RangeFilterReader {
+ public:
+  // Returns nullptr if the contents are not a supported range filter.
+  static std::unique_ptr<RangeFilterReader> Create(BlockContents&& contents);
+
+  ~RangeFilterReader();
+
+  // Returns false if no key in [*lower, upper) was added to the filter.
+  // `lower` may be nullptr for no lower bound.
+  bool RangeMayMatch(const Slice* lower, const Slice& upper) const;
+
+  size_t ApproximateMemoryUsage() const;
+
+ private:
+  RangeFilterReader(BlockContents&& contents,
+                    std::unique_ptr<FilterBitsReader>&& bits_reader);
+
+  bool PrefixMayMatch(int level, uint64_t prefix) const;
+  bool LevelRangeMayMatch(int level, uint64_t lower, uint64_t upper) const;
+
+  BlockContents contents_;
+  std::unique_ptr<FilterBitsReader> bits_reader_;
+};
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -205,6 +205,23 @@ class InternalIteratorBase : public Cleanable {
   // Default implementation is no-op and its implemented by iterators.
   virtual void SetReadaheadState(ReadaheadFileInfo* /*readahead_file_info*/) {}
 
+  // For iterators over a table file: whether the iterator is positioned in
+  // the last data block of the file, so that a forward scan is about to move
+  // to the next file. LevelIterator uses it to prepare that file early.
+  virtual bool IsInLastDataBlock() const { return false; }
+
+  // For iterators over a table file: starts reading what SeekToFirst() needs
+  // asynchronously, where supported (ReadOptions::async_io). The iterator is
+  // not positioned until the following SeekToFirst(), which completes the
+  // read. Default implementation is no-op.
+  virtual void PrepareSeekToFirst() {}
+
+  // Starts reading what Seek(target) needs asynchronously, where supported
+  // (ReadOptions::async_io), without waiting for the reads. The iterator is
+  // not positioned until it is repositioned; a following Seek(target)
+  // completes the reads. Default implementation is no-op.
+  virtual void PrepareSeek(const Slice& /*target*/) {}
+
   // When used under merging iterator, LevelIterator treats file boundaries
   // as sentinel keys to prevent it from moving to next SST file before range
   // tombstones in the current SST file are no longer needed. This method makes
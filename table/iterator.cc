@@ -30,6 +30,22 @@ Status Iterator::GetProperty(std::string prop_name, std::string* prop) {
   return Status::InvalidArgument("Unidentified property.");
 }
 
+size_t Iterator::NextBatch(size_t max_entries,
+                           std::vector<PinnableSlice>* keys,
+                           std::vector<PinnableSlice>* values) {
+  assert(keys != nullptr);
+  assert(values != nullptr);
+  size_t num_entries = 0;
+  for (; num_entries < max_entries && Valid(); ++num_entries) {
+    keys->emplace_back();
+    keys->back().PinSelf(key());
+    values->emplace_back();
+    values->back().PinSelf(value());
+    Next();
+  }
+  return num_entries;
+}
+
 namespace {
 class EmptyIterator : public Iterator {
  public:
@@ -142,6 +142,11 @@ class IteratorWrapperBase {
     iter_->SeekForPrev(k);
     Update();
   }
+  void PrepareSeek(const Slice& k) {
+    assert(iter_);
+    iter_->PrepareSeek(k);
+    Update();
+  }
   void SeekToFirst() {
     assert(iter_);
     iter_->SeekToFirst();
@@ -330,6 +330,17 @@ class MergingIterator : public InternalIterator {
     }
   }
 
+  // Lets every child start the reads for Seek(target) before any of them is
+  // waited on. The children are left unpositioned, so this iterator is
+  // invalid until the next Seek*().
+  void PrepareSeek(const Slice& target) override {
+    ClearHeaps();
+    current_ = nullptr;
+    for (auto& child : children_) {
+      child.iter.PrepareSeek(target);
+    }
+  }
+
   void SeekForPrev(const Slice& target) override {
     assert(range_tombstone_iters_.empty() ||
            range_tombstone_iters_.size() == children_.size());
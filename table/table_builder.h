@@ -161,6 +161,9 @@ struct TableBuilderOptions : public TablePropertiesCollectorFactory::Context {
   // in the table options of the ioptions.table_factory
   bool skip_filters = false;
   const uint64_t cur_file_num;
+  // For FilterBuildingContext, see there. Set by flush and compaction.
+  std::vector<uint64_t> level_data_bytes;
+  std::vector<uint64_t> level_point_lookup_misses;
 };
 
 // TableBuilder provides the interface used to build a Table
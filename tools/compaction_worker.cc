@@ -0,0 +1,109 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+//
+// A worker process for LocalProcessCompactionService: runs the compaction jobs
+// that DBs using the service write to a job directory. Any number of workers
+// can share a directory. Workers are either started by the service (see
+// LocalProcessCompactionServiceOptions::worker_command), or separately, e.g.
+// within a cgroup limiting their CPU and memory:
+//
+//   compaction_worker --job_dir=/path/to/jobs
+
+#include <cstdio>
+
+#ifndef GFLAGS
+int main() {
+  fprintf(stderr, "Please install gflags to run rocksdb tools\n");
+  return 1;
+}
+#else
+
+#include <atomic>
+#include <cerrno>
+#include <string>
+#include <thread>
+
+#ifndef OS_WIN
+#include <signal.h>
+#endif
+
+#include "rocksdb/env.h"
+#include "rocksdb/utilities/local_process_compaction_service.h"
+#include "util/gflags_compat.h"
+
+using GFLAGS_NAMESPACE::ParseCommandLineFlags;
+using GFLAGS_NAMESPACE::SetUsageMessage;
+
+DEFINE_string(job_dir, "", "Directory of the compaction jobs to run");
+DEFINE_uint64(poll_interval_us, 1000,
+              "How often to look for new jobs when idle");
+DEFINE_bool(load_options_from_db, true,
+            "Load the table factory, comparator, merge operator etc. of each "
+            "job from the OPTIONS file of its DB");
+DEFINE_int64(parent_pid, 0,
+             "If set, exit once the process with this pid has exited");
+
+namespace ROCKSDB_NAMESPACE {
+namespace {
+std::atomic<bool> stop{false};
+
+#ifndef OS_WIN
+void HandleSignal(int /*sig*/) { stop.store(true); }
+#endif
+}  // namespace
+
+int RunWorker() {
+  if (FLAGS_job_dir.empty()) {
+    fprintf(stderr, "--job_dir must be set\n");
+    return 1;
+  }
+#ifndef OS_WIN
+  // Finish the current job cleanly
+  signal(SIGTERM, HandleSignal);
+  signal(SIGINT, HandleSignal);
+#endif
+
+  std::thread parent_watcher;
+  if (FLAGS_parent_pid > 0) {
+    parent_watcher = std::thread([]() {
+      while (!stop.load()) {
+#ifndef OS_WIN
+        if (kill(static_cast<pid_t>(FLAGS_parent_pid), 0) != 0 &&
+            errno == ESRCH) {
+          stop.store(true);
+          break;
+        }
+#endif
+        Env::Default()->SleepForMicroseconds(100 * 1000);
+      }
+    });
+  }
+
+  CompactionWorkerOptions options;
+  options.job_dir = FLAGS_job_dir;
+  options.poll_interval_us = FLAGS_poll_interval_us;
+  options.load_options_from_db = FLAGS_load_options_from_db;
+  options.stop = &stop;
+  Status s = RunCompactionWorker(options);
+  stop.store(true);
+  if (parent_watcher.joinable()) {
+    parent_watcher.join();
+  }
+  if (!s.ok()) {
+    fprintf(stderr, "%s\n", s.ToString().c_str());
+    return 1;
+  }
+  return 0;
+}
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  SetUsageMessage(std::string("\nUSAGE:\n") + std::string(argv[0]) +
+                  " --job_dir=<dir> [OPTIONS]...");
+  ParseCommandLineFlags(&argc, &argv, true);
+  return ROCKSDB_NAMESPACE::RunWorker();
+}
+
+#endif  // GFLAGS
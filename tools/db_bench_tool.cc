@@ -63,6 +63,7 @@
 #include "rocksdb/stats_history.h"
 #include "rocksdb/table.h"
 #include "rocksdb/utilities/backup_engine.h"
+#include "rocksdb/utilities/local_process_compaction_service.h"
 #include "rocksdb/utilities/object_registry.h"
 #include "rocksdb/utilities/optimistic_transaction_db.h"
 #include "rocksdb/utilities/options_type.h"
@@ -119,6 +120,7 @@ DEFINE_string(
     "seekrandom,"
     "seekrandomwhilewriting,"
     "seekrandomwhilemerging,"
+    "seekrandomprepared,"
     "readseq,"
     "readreverse,"
     "compact,"
@@ -207,6 +209,9 @@ DEFINE_string(
     "overwrite\n"
     "\tseekrandomwhilemerging -- seekrandom and 1 thread doing "
     "merge\n"
+    "\tseekrandomprepared -- seekrandom keeping concurrent_scans scans in "
+    "flight per thread, starting their reads with PrepareSeek() first. "
+    "Use with --async_io\n"
     "\tcrc32c        -- repeated crc32c of <block size> data\n"
     "\txxhash        -- repeated xxHash of <block size> data\n"
     "\txxhash64      -- repeated xxHash64 of <block size> data\n"
@@ -309,8 +314,12 @@ DEFINE_int32(value_size_max, 102400, "Max size of random value");
 
 DEFINE_int32(seek_nexts, 0,
              "How many times to call Next() after Seek() in "
-             "fillseekseq, seekrandom, seekrandomwhilewriting and "
-             "seekrandomwhilemerging");
+             "fillseekseq, seekrandom, seekrandomwhilewriting, "
+             "seekrandomwhilemerging and seekrandomprepared");
+
+DEFINE_int32(concurrent_scans, 16,
+             "Number of scans each thread of seekrandomprepared keeps in "
+             "flight");
 
 DEFINE_bool(reverse_iterator, false,
             "When true use Prev rather than Next for iterators that do "
@@ -485,6 +494,20 @@ DEFINE_int32(max_background_jobs,
              "The maximum number of concurrent background jobs that can occur "
              "in parallel.");
 
+DEFINE_string(compaction_service_job_dir, "",
+              "If not empty, compactions run in compaction_worker processes "
+              "through a LocalProcessCompactionService with this job "
+              "directory, which must be on the same file system as the DB.");
+
+DEFINE_string(compaction_worker_command, "",
+              "Path of the compaction_worker binary started by the "
+              "LocalProcessCompactionService. If empty, workers must be "
+              "started separately with the same --job_dir.");
+
+DEFINE_int32(compaction_workers, 1,
+             "Number of compaction_worker processes started with "
+             "--compaction_worker_command.");
+
 DEFINE_int32(num_bottom_pri_threads, 0,
              "The number of threads in the bottom-priority thread pool (used "
              "by universal compaction only).");
@@ -515,6 +538,11 @@ DEFINE_int32(max_background_flushes,
              "The maximum number of concurrent background flushes"
              " that can occur in parallel.");
 
+DEFINE_uint32(max_flush_partitions,
+              ROCKSDB_NAMESPACE::Options().max_flush_partitions,
+              "The maximum number of L0 files that a single flush builds in "
+              "parallel.");
+
 static ROCKSDB_NAMESPACE::CompactionStyle FLAGS_compaction_style_e;
 DEFINE_int32(compaction_style,
              (int32_t)ROCKSDB_NAMESPACE::Options().compaction_style,
@@ -648,6 +676,9 @@ DEFINE_bool(partition_index, false, "Partition index blocks");
 
 DEFINE_bool(index_with_first_key, false, "Include first key in the index");
 
+DEFINE_bool(learned_index, false,
+            "Use a learned model to narrow searches of the index block");
+
 DEFINE_bool(
     optimize_filters_for_memory,
     ROCKSDB_NAMESPACE::BlockBasedTableOptions().optimize_filters_for_memory,
@@ -728,6 +759,10 @@ DEFINE_double(data_block_hash_table_util_ratio, 0.75,
               "This is only valid if use_data_block_hash_index is "
               "set to true");
 
+DEFINE_bool(restart_key_prefix_seek,
+            ROCKSDB_NAMESPACE::BlockBasedTableOptions().restart_key_prefix_seek,
+            "Sets BlockBasedTableOptions::restart_key_prefix_seek");
+
 DEFINE_int64(compressed_cache_size, -1,
              "Number of bytes to use as a cache of compressed data.");
 
@@ -735,6 +770,11 @@ DEFINE_int64(row_cache_size, 0,
              "Number of bytes to use as a cache of individual rows"
              " (0 = disabled).");
 
+DEFINE_uint32(row_cache_admission_threshold,
+              ROCKSDB_NAMESPACE::Options().row_cache_admission_threshold,
+              "Only insert rows into the row cache once their key has been "
+              "looked up about this many times (0 = admit every row).");
+
 DEFINE_int32(open_files, ROCKSDB_NAMESPACE::Options().max_open_files,
              "Maximum number of files to keep open at the same time"
              " (use default if == 0)");
@@ -744,6 +784,11 @@ DEFINE_int32(file_opening_threads,
              "If open_files is set to -1, this option set the number of "
              "threads that will be used to open files during DB::Open()");
 
+DEFINE_bool(open_files_in_background,
+            ROCKSDB_NAMESPACE::Options().open_files_in_background,
+            "If open_files is set to -1, only open the files of L0 and L1 "
+            "during DB::Open() and the others in the background");
+
 DEFINE_uint64(compaction_readahead_size,
               ROCKSDB_NAMESPACE::Options().compaction_readahead_size,
               "Compaction readahead size");
@@ -762,6 +807,10 @@ DEFINE_int32(bloom_bits, -1,
 
 DEFINE_bool(use_ribbon_filter, false, "Use Ribbon instead of Bloom filter");
 
+DEFINE_bool(level_adaptive_filter, false,
+            "Spread the filter bits per key of --bloom_bits unevenly across "
+            "levels, see NewLevelAdaptiveFilterPolicy");
+
 DEFINE_double(memtable_bloom_size_ratio, 0,
               "Ratio of memtable size used for bloom filter. 0 means no bloom "
               "filter.");
@@ -774,6 +823,12 @@ DEFINE_bool(whole_key_filtering,
             ROCKSDB_NAMESPACE::BlockBasedTableOptions().whole_key_filtering,
             "Use whole keys (in addition to prefixes) in SST bloom filter.");
 
+DEFINE_double(range_filter_bits_per_key,
+              ROCKSDB_NAMESPACE::BlockBasedTableOptions()
+                  .range_filter_bits_per_key,
+              "Bits per key of the SST range filter, used by bounded scans "
+              "such as seekrandom with --max_scan_distance. 0 to disable.");
+
 DEFINE_bool(use_existing_db, false,
             "If true, do not destroy the existing database.  If you set this "
             "flag and also specify a benchmark that wants a fresh database, "
@@ -1204,10 +1259,19 @@ DEFINE_bool(async_io, false,
             "When set true, RocksDB does asynchronous reads for internal auto "
             "readahead prefetching.");
 
+DEFINE_int32(iter_batch_size, 0,
+             "If positive, readseq reads up to this many entries at a time "
+             "with Iterator::NextBatch() instead of calling Next() for each "
+             "entry.");
+
 DEFINE_bool(optimize_multiget_for_io, true,
             "When set true, RocksDB does asynchronous reads for SST files in "
             "multiple levels for MultiGet.");
 
+DEFINE_uint64(multiget_parallelism, 1,
+              "If greater than 1, large MultiGet batches are split into up to "
+              "this many key ranges that are looked up concurrently.");
+
 DEFINE_bool(charge_compression_dictionary_building_buffer, false,
             "Setting for "
             "CacheEntryRoleOptions::charged of "
@@ -1452,6 +1516,11 @@ DEFINE_uint64(delayed_write_rate, 8388608u,
 DEFINE_bool(enable_pipelined_write, true,
             "Allow WAL and memtable writes to be pipelined");
 
+DEFINE_bool(parallel_wal_checksum,
+            ROCKSDB_NAMESPACE::Options().parallel_wal_checksum,
+            "Have each writer checksum its own batch for the WAL, and write "
+            "the batches of a write group without merging them");
+
 DEFINE_bool(
     unordered_write, false,
     "Enable the unordered write feature, which provides higher throughput but "
@@ -1460,6 +1529,10 @@ DEFINE_bool(
 DEFINE_bool(allow_concurrent_memtable_write, true,
             "Allow multi-writers to update mem tables in parallel.");
 
+DEFINE_int32(wal_recovery_threads,
+             ROCKSDB_NAMESPACE::Options().wal_recovery_threads,
+             "Number of threads used to replay the WAL when opening the DB.");
+
 DEFINE_double(experimental_mempurge_threshold, 0.0,
               "Maximum useful payload ratio estimate that triggers a mempurge "
               "(memtable garbage collection).");
@@ -1612,6 +1685,11 @@ DEFINE_bool(use_direct_io_for_flush_and_compaction,
             ROCKSDB_NAMESPACE::Options().use_direct_io_for_flush_and_compaction,
             "Use O_DIRECT for background flush and compaction writes");
 
+DEFINE_bool(use_async_io_for_writes,
+            ROCKSDB_NAMESPACE::Options().use_async_io_for_writes,
+            "Submit buffered file appends and syncs asynchronously through "
+            "io_uring");
+
 DEFINE_bool(advise_random_on_open,
             ROCKSDB_NAMESPACE::Options().advise_random_on_open,
             "Advise random access on table file open");
@@ -1747,6 +1825,14 @@ DEFINE_bool(read_with_latest_user_timestamp, true,
 
 DEFINE_string(secondary_cache_uri, "",
               "Full URI for creating a custom secondary cache object");
+
+DEFINE_string(log_structured_secondary_cache_path, "",
+              "If not empty, use a log-structured secondary cache in this "
+              "file, e.g. on local flash, as the secondary cache, or as the "
+              "bottom tier with --use_tiered_cache");
+
+DEFINE_int64(log_structured_secondary_cache_size, 1LL << 30,
+             "Size of the file of the log-structured secondary cache");
 static class std::shared_ptr<ROCKSDB_NAMESPACE::SecondaryCache> secondary_cache;
 
 static const bool FLAGS_prefix_size_dummy __attribute__((__unused__)) =
@@ -2160,6 +2246,7 @@ enum OperationType : unsigned char {
   kUncompress,
   kCrc,
   kHash,
+  kNext,
   kOthers
 };
 
@@ -2169,7 +2256,7 @@ static std::unordered_map<OperationType, std::string, std::hash<unsigned char>>
                            {kMerge, "merge"},       {kUpdate, "update"},
                            {kCompress, "compress"}, {kCompress, "uncompress"},
                            {kCrc, "crc"},           {kHash, "hash"},
-                           {kOthers, "op"}};
+                           {kNext, "next"},         {kOthers, "op"}};
 
 class CombinedStats;
 class Stats {
@@ -2300,6 +2387,17 @@ class Stats {
     last_op_finish_ = clock_->NowMicros();
   }
 
+  // Adds the latency of a step within an operation, such as each Next() of a
+  // seek, to the histogram of `op_type` when --histogram is set. The
+  // operation itself is still reported with FinishedOps().
+  void AddStepLatency(enum OperationType op_type, uint64_t micros) {
+    auto it = hist_.find(op_type);
+    if (it == hist_.end()) {
+      it = hist_.insert({op_type, std::make_shared<HistogramImpl>()}).first;
+    }
+    it->second->Add(micros);
+  }
+
   void FinishedOps(DBWithColumnFamilies* db_with_cfh, DB* db, int64_t num_ops,
                    enum OperationType op_type = kOthers) {
     if (reporter_agent_) {
@@ -3128,6 +3226,31 @@ class Benchmark {
         exit(1);
       }
     }
+    if (!FLAGS_log_structured_secondary_cache_path.empty()) {
+      if (!FLAGS_secondary_cache_uri.empty() ||
+          (!use_tiered_cache && FLAGS_use_compressed_secondary_cache)) {
+        fprintf(stderr,
+                "--log_structured_secondary_cache_path is not compatible with "
+                "--secondary_cache_uri, nor with "
+                "--use_compressed_secondary_cache without a tiered cache\n");
+        exit(1);
+      }
+      // Shared by all block caches, as they would truncate each other's file
+      if (secondary_cache == nullptr) {
+        LogStructuredSecondaryCacheOptions ls_cache_opts;
+        ls_cache_opts.file_path = FLAGS_log_structured_secondary_cache_path;
+        ls_cache_opts.capacity =
+            static_cast<size_t>(FLAGS_log_structured_secondary_cache_size);
+        Status s =
+            NewLogStructuredSecondaryCache(ls_cache_opts, &secondary_cache);
+        if (!s.ok()) {
+          fprintf(stderr,
+                  "Unable to create log-structured secondary cache: %s\n",
+                  s.ToString().c_str());
+          exit(1);
+        }
+      }
+    }
 
     std::shared_ptr<Cache> block_cache;
     if (FLAGS_cache_type == "clock_cache") {
@@ -3160,7 +3283,7 @@ class Benchmark {
         tiered_opts.adm_policy = adm_policy;
         block_cache = NewTieredCache(tiered_opts);
       } else {
-        if (!FLAGS_secondary_cache_uri.empty()) {
+        if (secondary_cache != nullptr) {
           opts.secondary_cache = secondary_cache;
         } else if (FLAGS_use_compressed_secondary_cache) {
           opts.secondary_cache =
@@ -3188,7 +3311,7 @@ class Benchmark {
         tiered_opts.adm_policy = adm_policy;
         block_cache = NewTieredCache(tiered_opts);
       } else {
-        if (!FLAGS_secondary_cache_uri.empty()) {
+        if (secondary_cache != nullptr) {
           opts.secondary_cache = secondary_cache;
         } else if (FLAGS_use_compressed_secondary_cache) {
           opts.secondary_cache =
@@ -3474,6 +3597,8 @@ class Benchmark {
       read_options_.adaptive_readahead = FLAGS_adaptive_readahead;
       read_options_.async_io = FLAGS_async_io;
       read_options_.optimize_multiget_for_io = FLAGS_optimize_multiget_for_io;
+      read_options_.multiget_parallelism =
+          static_cast<size_t>(FLAGS_multiget_parallelism);
       read_options_.auto_readahead_size = FLAGS_auto_readahead_size;
 
       void (Benchmark::*method)(ThreadState*) = nullptr;
@@ -3616,6 +3741,8 @@ class Benchmark {
         method = &Benchmark::IteratorCreationWhileWriting;
       } else if (name == "seekrandom") {
         method = &Benchmark::SeekRandom;
+      } else if (name == "seekrandomprepared") {
+        method = &Benchmark::SeekRandomPrepared;
       } else if (name == "seekrandomwhilewriting") {
         num_threads++;  // Add extra thread for writing
         method = &Benchmark::SeekRandomWhileWriting;
@@ -4251,6 +4378,21 @@ class Benchmark {
     options.max_background_compactions = FLAGS_max_background_compactions;
     options.max_subcompactions = static_cast<uint32_t>(FLAGS_subcompactions);
     options.max_background_flushes = FLAGS_max_background_flushes;
+    if (!FLAGS_compaction_service_job_dir.empty()) {
+      LocalProcessCompactionServiceOptions service_options;
+      service_options.job_dir = FLAGS_compaction_service_job_dir;
+      service_options.worker_command = FLAGS_compaction_worker_command;
+      service_options.num_workers = FLAGS_compaction_workers;
+      service_options.env = FLAGS_env;
+      Status s = NewLocalProcessCompactionService(
+          service_options, &options.compaction_service);
+      if (!s.ok()) {
+        fprintf(stderr, "Unable to create compaction service: %s\n",
+                s.ToString().c_str());
+        exit(1);
+      }
+    }
+    options.max_flush_partitions = FLAGS_max_flush_partitions;
     options.compaction_style = FLAGS_compaction_style_e;
     options.compaction_pri = FLAGS_compaction_pri_e;
     options.allow_mmap_reads = FLAGS_mmap_read;
@@ -4258,6 +4400,7 @@ class Benchmark {
     options.use_direct_reads = FLAGS_use_direct_reads;
     options.use_direct_io_for_flush_and_compaction =
         FLAGS_use_direct_io_for_flush_and_compaction;
+    options.use_async_io_for_writes = FLAGS_use_async_io_for_writes;
     options.manual_wal_flush = FLAGS_manual_wal_flush;
     options.wal_compression = FLAGS_wal_compression_e;
     options.ttl = FLAGS_fifo_compaction_ttl;
@@ -4286,6 +4429,7 @@ class Benchmark {
     }
     options.bloom_locality = FLAGS_bloom_locality;
     options.max_file_opening_threads = FLAGS_file_opening_threads;
+    options.open_files_in_background = FLAGS_open_files_in_background;
     options.compaction_readahead_size = FLAGS_compaction_readahead_size;
     options.log_readahead_size = FLAGS_log_readahead_size;
     options.random_access_max_buffer_size = FLAGS_random_access_max_buffer_size;
@@ -4382,6 +4526,9 @@ class Benchmark {
       } else if (FLAGS_index_with_first_key) {
         block_based_options.index_type =
             BlockBasedTableOptions::kBinarySearchWithFirstKey;
+      } else if (FLAGS_learned_index) {
+        block_based_options.index_type =
+            BlockBasedTableOptions::kLearnedIndexSearch;
       }
       BlockBasedTableOptions::IndexShorteningMode index_shortening =
           block_based_options.index_shortening;
@@ -4460,6 +4607,8 @@ class Benchmark {
           FLAGS_enable_index_compression;
       block_based_options.block_align = FLAGS_block_align;
       block_based_options.whole_key_filtering = FLAGS_whole_key_filtering;
+      block_based_options.range_filter_bits_per_key =
+          FLAGS_range_filter_bits_per_key;
       block_based_options.max_auto_readahead_size =
           FLAGS_max_auto_readahead_size;
       block_based_options.initial_auto_readahead_size =
@@ -4490,6 +4639,8 @@ class Benchmark {
       }
       block_based_options.data_block_hash_table_util_ratio =
           FLAGS_data_block_hash_table_util_ratio;
+      block_based_options.restart_key_prefix_seek =
+          FLAGS_restart_key_prefix_seek;
       if (FLAGS_read_cache_path != "") {
         Status rc_status;
 
@@ -4620,6 +4771,7 @@ class Benchmark {
     options.delayed_write_rate = FLAGS_delayed_write_rate;
     options.allow_concurrent_memtable_write =
         FLAGS_allow_concurrent_memtable_write;
+    options.wal_recovery_threads = FLAGS_wal_recovery_threads;
     options.experimental_mempurge_threshold =
         FLAGS_experimental_mempurge_threshold;
     options.inplace_update_support = FLAGS_inplace_update_support;
@@ -4627,6 +4779,7 @@ class Benchmark {
     options.enable_write_thread_adaptive_yield =
         FLAGS_enable_write_thread_adaptive_yield;
     options.enable_pipelined_write = FLAGS_enable_pipelined_write;
+    options.parallel_wal_checksum = FLAGS_parallel_wal_checksum;
     options.unordered_write = FLAGS_unordered_write;
     options.write_thread_max_yield_usec = FLAGS_write_thread_max_yield_usec;
     options.write_thread_slow_yield_usec = FLAGS_write_thread_slow_yield_usec;
@@ -4767,6 +4920,9 @@ class Benchmark {
           table_options->filter_policy = BlockBasedTableOptions().filter_policy;
         } else if (FLAGS_bloom_bits == 0) {
           table_options->filter_policy.reset();
+        } else if (FLAGS_level_adaptive_filter) {
+          table_options->filter_policy.reset(NewLevelAdaptiveFilterPolicy(
+              FLAGS_bloom_bits, FLAGS_use_ribbon_filter ? 0 : INT_MAX));
         } else {
           table_options->filter_policy.reset(
               FLAGS_use_ribbon_filter ? NewRibbonFilterPolicy(FLAGS_bloom_bits)
@@ -4785,6 +4941,7 @@ class Benchmark {
         }
       }
     }
+    options.row_cache_admission_threshold = FLAGS_row_cache_admission_threshold;
 
     if (options.env == Env::Default()) {
       options.env = FLAGS_env;
@@ -5880,16 +6037,40 @@ class Benchmark {
     Iterator* iter = db->NewIterator(options);
     int64_t i = 0;
     int64_t bytes = 0;
-    for (iter->SeekToFirst(); i < reads_ && iter->Valid(); iter->Next()) {
-      bytes += iter->key().size() + iter->value().size();
-      thread->stats.FinishedOps(nullptr, db, 1, kRead);
-      ++i;
+    if (FLAGS_iter_batch_size > 0) {
+      std::vector<PinnableSlice> keys;
+      std::vector<PinnableSlice> values;
+      for (iter->SeekToFirst(); i < reads_ && iter->Valid();) {
+        keys.clear();
+        values.clear();
+        size_t num_entries = iter->NextBatch(
+            static_cast<size_t>(
+                std::min<int64_t>(FLAGS_iter_batch_size, reads_ - i)),
+            &keys, &values);
+        for (size_t j = 0; j < num_entries; j++) {
+          bytes += keys[j].size() + values[j].size();
+        }
+        thread->stats.FinishedOps(nullptr, db, num_entries, kRead);
+        i += num_entries;
+
+        if (thread->shared->read_rate_limiter.get() != nullptr) {
+          thread->shared->read_rate_limiter->Request(
+              num_entries, Env::IO_HIGH, nullptr /* stats */,
+              RateLimiter::OpType::kRead);
+        }
+      }
+    } else {
+      for (iter->SeekToFirst(); i < reads_ && iter->Valid(); iter->Next()) {
+        bytes += iter->key().size() + iter->value().size();
+        thread->stats.FinishedOps(nullptr, db, 1, kRead);
+        ++i;
 
-      if (thread->shared->read_rate_limiter.get() != nullptr &&
-          i % 1024 == 1023) {
-        thread->shared->read_rate_limiter->Request(1024, Env::IO_HIGH,
-                                                   nullptr /* stats */,
-                                                   RateLimiter::OpType::kRead);
+        if (thread->shared->read_rate_limiter.get() != nullptr &&
+            i % 1024 == 1023) {
+          thread->shared->read_rate_limiter->Request(
+              1024, Env::IO_HIGH, nullptr /* stats */,
+              RateLimiter::OpType::kRead);
+        }
       }
     }
 
@@ -6862,11 +7043,16 @@ class Benchmark {
                std::min(value.size(), sizeof(value_buffer)));
         bytes += iter_to_use->key().size() + iter_to_use->value().size();
 
+        uint64_t step_start = FLAGS_histogram ? FLAGS_env->NowMicros() : 0;
         if (!FLAGS_reverse_iterator) {
           iter_to_use->Next();
         } else {
           iter_to_use->Prev();
         }
+        if (FLAGS_histogram) {
+          thread->stats.AddStepLatency(kNext,
+                                       FLAGS_env->NowMicros() - step_start);
+        }
         assert(iter_to_use->status().ok());
       }
 
@@ -6889,6 +7075,66 @@ class Benchmark {
     thread->stats.AddMessage(msg);
   }
 
+  // Multiplexes concurrent_scans scans on each thread: the reads of all of
+  // them are started with PrepareSeek() before any of them is waited on.
+  void SeekRandomPrepared(ThreadState* thread) {
+    int64_t read = 0;
+    int64_t found = 0;
+    int64_t bytes = 0;
+    const size_t num_scans =
+        static_cast<size_t>(std::max(1, FLAGS_concurrent_scans));
+    std::vector<std::unique_ptr<const char[]>> key_guards(num_scans);
+    std::vector<Slice> keys(num_scans);
+    for (size_t i = 0; i < num_scans; ++i) {
+      keys[i] = AllocateKey(&key_guards[i]);
+    }
+    std::vector<std::unique_ptr<Iterator>> iters(num_scans);
+
+    Duration duration(FLAGS_duration, reads_);
+    char value_buffer[256];
+    while (!duration.Done(static_cast<int64_t>(num_scans))) {
+      DB* db = SelectDB(thread);
+      for (size_t i = 0; i < num_scans; ++i) {
+        int64_t seek_pos = thread->rand.Next() % FLAGS_num;
+        GenerateKeyFromIntForSeek(static_cast<uint64_t>(seek_pos), FLAGS_num,
+                                  &keys[i]);
+        iters[i].reset(db->NewIterator(read_options_));
+        iters[i]->PrepareSeek(keys[i]);
+      }
+      for (size_t i = 0; i < num_scans; ++i) {
+        Iterator* iter = iters[i].get();
+        iter->Seek(keys[i]);
+        read++;
+        if (iter->Valid() && iter->key().compare(keys[i]) == 0) {
+          found++;
+        }
+        for (int j = 0; j < FLAGS_seek_nexts && iter->Valid(); ++j) {
+          // Copy out iterator's value to make sure we read them.
+          Slice value = iter->value();
+          memcpy(value_buffer, value.data(),
+                 std::min(value.size(), sizeof(value_buffer)));
+          bytes += iter->key().size() + value.size();
+          iter->Next();
+        }
+        assert(iter->status().ok());
+      }
+
+      if (thread->shared->read_rate_limiter.get() != nullptr) {
+        thread->shared->read_rate_limiter->Request(
+            static_cast<int64_t>(num_scans), Env::IO_HIGH, nullptr /* stats */,
+            RateLimiter::OpType::kRead);
+      }
+      thread->stats.FinishedOps(&db_, db_.db, static_cast<int64_t>(num_scans),
+                                kSeek);
+    }
+
+    char msg[100];
+    snprintf(msg, sizeof(msg), "(%" PRIu64 " of %" PRIu64 " found)\n", found,
+             read);
+    thread->stats.AddBytes(bytes);
+    thread->stats.AddMessage(msg);
+  }
+
   void SeekRandomWhileWriting(ThreadState* thread) {
     if (thread->tid > 0) {
       SeekRandom(thread);
@@ -1193,6 +1193,65 @@ TEST(RibbonTest, RibbonTestLevelThreshold) {
   }
 }
 
+TEST(LevelAdaptiveFilterTest, BitsPerKeyAcrossLevels) {
+  BlockBasedTableOptions opts;
+  FilterBuildingContext ctx(opts);
+  std::shared_ptr<FilterPolicy> policy{NewLevelAdaptiveFilterPolicy(10)};
+  auto adaptive = static_cast<LevelAdaptiveFilterPolicy*>(policy.get());
+
+  // Without level statistics, like SstFileWriter
+  std::unique_ptr<FilterBitsBuilder> builder{
+      policy->GetBuilderWithContext(ctx)};
+  ASSERT_EQ(adaptive->GetBitsPerKey(ctx), 10.0);
+  ASSERT_GT(GetEffectiveBitsPerKey(builder.get()), 9);
+  ASSERT_LT(GetEffectiveBitsPerKey(builder.get()), 11);
+
+  // Levels growing by 10x, without sampled lookups
+  ctx.reason = TableFileCreationReason::kCompaction;
+  ctx.level_data_bytes = {0, 1 << 20, 10 << 20, 100 << 20, 1000 << 20};
+  std::vector<double> bits_per_key;
+  double avg_bits_per_key = 0;
+  uint64_t total_bytes = 0;
+  for (int level = 1; level <= 4; level++) {
+    ctx.level_at_creation = level;
+    bits_per_key.push_back(adaptive->GetBitsPerKey(ctx));
+    avg_bits_per_key +=
+        bits_per_key.back() * static_cast<double>(ctx.level_data_bytes[level]);
+    total_bytes += ctx.level_data_bytes[level];
+  }
+  // Smaller levels get more bits per key, with the same total
+  for (size_t i = 1; i < bits_per_key.size(); i++) {
+    ASSERT_GT(bits_per_key[i - 1], bits_per_key[i]);
+  }
+  ASSERT_NEAR(avg_bits_per_key / static_cast<double>(total_bytes), 10.0, 0.01);
+  ASSERT_LE(bits_per_key.front(), 20.0);
+
+  // Filters on the last level save more reads if most lookups miss there
+  ctx.level_at_creation = 4;
+  ctx.level_point_lookup_misses = {0, 0, 0, 0, 1000000};
+  double last_level_bits_per_key = adaptive->GetBitsPerKey(ctx);
+  ASSERT_GT(last_level_bits_per_key, bits_per_key.back());
+  builder.reset(policy->GetBuilderWithContext(ctx));
+  ASSERT_NEAR(GetEffectiveBitsPerKey(builder.get()), last_level_bits_per_key,
+              1.0);
+
+  // And less if lookups do not reach it
+  ctx.level_point_lookup_misses = {0, 1000000, 1000000, 1000000, 0};
+  ASSERT_LT(adaptive->GetBitsPerKey(ctx), bits_per_key.back());
+
+  // "No filter" special case
+  std::shared_ptr<FilterPolicy> no_filter{NewLevelAdaptiveFilterPolicy(0)};
+  builder.reset(no_filter->GetBuilderWithContext(ctx));
+  ASSERT_EQ(builder, nullptr);
+
+  // Round trip through the options string
+  std::shared_ptr<const FilterPolicy> copy;
+  ASSERT_OK(FilterPolicy::CreateFromString(ConfigOptions(), policy->GetId(),
+                                           &copy));
+  ASSERT_STREQ(copy->Name(), LevelAdaptiveFilterPolicy::kClassName());
+  ASSERT_EQ(copy->GetId(), policy->GetId());
+}
+
 }  // namespace ROCKSDB_NAMESPACE
 
 int main(int argc, char** argv) {
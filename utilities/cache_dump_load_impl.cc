@@ -15,6 +15,7 @@
 #include "rocksdb/file_system.h"
 #include "rocksdb/utilities/ldb_cmd.h"
 #include "table/block_based/block_based_table_reader.h"
+#include "table/block_based/block_cache.h"
 #include "table/format.h"
 #include "util/crc32c.h"
 
@@ -82,9 +83,15 @@ IOStatus CacheDumperImpl::DumpCacheEntriesToWriter() {
   }
 
   // Then, we iterate the block cache and dump out the blocks that are not
-  // filtered out.
+  // filtered out. Index and filter blocks are used by every lookup in their
+  // file, so they are dumped in a first pass, ahead of the data blocks. This
+  // way they are kept if the dump is cut short by the deadline or size limit,
+  // and they are loaded first.
   std::string buf;
-  cache_->ApplyToAllEntries(DumpOneBlockCallBack(buf), {});
+  cache_->ApplyToAllEntries(
+      DumpOneBlockCallBack(buf, /*dump_data_blocks=*/false), {});
+  cache_->ApplyToAllEntries(
+      DumpOneBlockCallBack(buf, /*dump_data_blocks=*/true), {});
 
   // Finally, write the footer
   io_s = WriteFooter();
@@ -110,12 +117,15 @@ bool CacheDumperImpl::ShouldFilterOut(const Slice& key) {
 // Cache::ApplyToAllEntries. In this callback function, we will get the block
 // type, decide if the block needs to be dumped based on the filter, and write
 // the block through the provided writer. `buf` is passed in for efficiennt
-// reuse.
+// reuse. Only data blocks are dumped if `dump_data_blocks` is set, and only
+// the other blocks otherwise.
 std::function<void(const Slice&, Cache::ObjectPtr, size_t,
                    const Cache::CacheItemHelper*)>
-CacheDumperImpl::DumpOneBlockCallBack(std::string& buf) {
-  return [&](const Slice& key, Cache::ObjectPtr value, size_t /*charge*/,
-             const Cache::CacheItemHelper* helper) {
+CacheDumperImpl::DumpOneBlockCallBack(std::string& buf, bool dump_data_blocks) {
+  return [&buf, dump_data_blocks, this](const Slice& key,
+                                        Cache::ObjectPtr value,
+                                        size_t /*charge*/,
+                                        const Cache::CacheItemHelper* helper) {
     if (helper == nullptr || helper->size_cb == nullptr ||
         helper->saveto_cb == nullptr) {
       // Not compatible with dumping. Skip this entry.
@@ -157,6 +167,10 @@ CacheDumperImpl::DumpOneBlockCallBack(std::string& buf) {
         return;
     }
 
+    if ((type == CacheDumpUnitType::kData) != dump_data_blocks) {
+      return;
+    }
+
     // based on the key prefix, check if the block should be filter out.
     if (!dump_all_keys_ && ShouldFilterOut(key)) {
       return;
@@ -304,6 +318,96 @@ IOStatus CacheDumpedLoaderImpl::RestoreCacheEntriesToSecondaryCache() {
   }
 }
 
+// Restore the data and filter blocks of the dump into the block cache of the
+// table options. Blocks are created from the dumped contents with the same
+// cache item helpers as the table reader uses, so a table of the reopened DB
+// finds them as if it had read them. Index blocks are skipped as parsing them
+// depends on properties of their table. Since the hottest blocks come first,
+// loading stops when the block cache is full rather than evicting them.
+IOStatus CacheDumpedLoaderImpl::RestoreCacheEntriesToBlockCache() {
+  const std::shared_ptr<Cache>& block_cache = toptions_.block_cache;
+  if (block_cache == nullptr) {
+    return IOStatus::InvalidArgument("Block cache is null");
+  }
+  if (reader_ == nullptr) {
+    return IOStatus::InvalidArgument("CacheDumpReader is null");
+  }
+  if (options_.deadline.count() && options_.clock == nullptr) {
+    return IOStatus::InvalidArgument("System clock is null");
+  }
+
+  IOStatus io_s;
+  DumpUnit dump_unit;
+  std::string data;
+  io_s = ReadHeader(&data, &dump_unit);
+  if (!io_s.ok()) {
+    return io_s;
+  }
+
+  BlockCreateContext create_context(&toptions_, /*_ioptions=*/nullptr,
+                                    /*_statistics=*/nullptr,
+                                    /*_using_zstd=*/false,
+                                    /*_protection_bytes_per_key=*/0,
+                                    /*_raw_ucmp=*/nullptr);
+  MemoryAllocator* allocator = block_cache->memory_allocator();
+  uint64_t loaded_size_bytes = 0;
+  while (io_s.ok()) {
+    dump_unit.reset();
+    data.clear();
+    io_s = ReadCacheBlock(&data, &dump_unit);
+    if (!io_s.ok() || dump_unit.type == CacheDumpUnitType::kFooter) {
+      break;
+    }
+    if (options_.deadline.count() &&
+        std::chrono::microseconds(options_.clock->NowMicros()) >=
+            options_.deadline) {
+      break;
+    }
+    if (options_.max_size_bytes > 0 &&
+        loaded_size_bytes > options_.max_size_bytes) {
+      break;
+    }
+
+    BlockType block_type;
+    Cache::Priority priority = Cache::Priority::LOW;
+    if (dump_unit.type == CacheDumpUnitType::kData) {
+      block_type = BlockType::kData;
+    } else if (dump_unit.type == CacheDumpUnitType::kFilter) {
+      block_type = BlockType::kFilter;
+      if (toptions_.cache_index_and_filter_blocks_with_high_priority) {
+        priority = Cache::Priority::HIGH;
+      }
+    } else {
+      continue;
+    }
+
+    const Cache::CacheItemHelper* helper = GetCacheItemHelper(block_type);
+    Slice content(static_cast<char*>(dump_unit.value), dump_unit.value_len);
+    Cache::ObjectPtr value = nullptr;
+    size_t charge = 0;
+    Status s =
+        helper->create_cb(content, kNoCompression, CacheTier::kVolatileTier,
+                          &create_context, allocator, &value, &charge);
+    if (!s.ok()) {
+      io_s = status_to_io_status(std::move(s));
+      break;
+    }
+    if (block_cache->GetUsage() + charge > block_cache->GetCapacity()) {
+      helper->del_cb(value, allocator);
+      break;
+    }
+    s = block_cache->Insert(dump_unit.key, value, helper, charge,
+                            /*handle=*/nullptr, priority);
+    if (!s.ok()) {
+      helper->del_cb(value, allocator);
+      io_s = status_to_io_status(std::move(s));
+      break;
+    }
+    loaded_size_bytes += dump_unit.value_len;
+  }
+  return io_s;
+}
+
 // Read and copy the dump unit metadata to std::string data, decode and create
 // the unit metadata based on the string
 IOStatus CacheDumpedLoaderImpl::ReadDumpUnitMeta(std::string* data,
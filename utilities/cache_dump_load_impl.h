@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <unordered_map>
 
 #include "file/random_access_file_reader.h"
@@ -19,8 +20,9 @@
 
 namespace ROCKSDB_NAMESPACE {
 
-// the read buffer size of for the default CacheDumpReader
-const unsigned int kDumpReaderBufferSize = 1024;  // 1KB
+// the read buffer size of for the default CacheDumpReader. The dump is read
+// sequentially in reads of this size.
+const unsigned int kDumpReaderBufferSize = 1024 * 1024;  // 1MB
 static const unsigned int kSizePrefixLen = 4;
 
 enum CacheDumpUnitType : unsigned char {
@@ -111,7 +113,7 @@ class CacheDumperImpl : public CacheDumper {
   bool ShouldFilterOut(const Slice& key);
   std::function<void(const Slice&, Cache::ObjectPtr, size_t,
                      const Cache::CacheItemHelper*)>
-  DumpOneBlockCallBack(std::string& buf);
+  DumpOneBlockCallBack(std::string& buf, bool dump_data_blocks);
 
   CacheDumpOptions options_;
   std::shared_ptr<Cache> cache_;
@@ -134,14 +136,16 @@ class CacheDumperImpl : public CacheDumper {
 class CacheDumpedLoaderImpl : public CacheDumpedLoader {
  public:
   CacheDumpedLoaderImpl(const CacheDumpOptions& dump_options,
-                        const BlockBasedTableOptions& /*toptions*/,
+                        const BlockBasedTableOptions& toptions,
                         const std::shared_ptr<SecondaryCache>& secondary_cache,
                         std::unique_ptr<CacheDumpReader>&& reader)
       : options_(dump_options),
+        toptions_(toptions),
         secondary_cache_(secondary_cache),
         reader_(std::move(reader)) {}
   ~CacheDumpedLoaderImpl() {}
   IOStatus RestoreCacheEntriesToSecondaryCache() override;
+  IOStatus RestoreCacheEntriesToBlockCache() override;
 
  private:
   IOStatus ReadDumpUnitMeta(std::string* data, DumpUnitMeta* unit_meta);
@@ -150,6 +154,7 @@ class CacheDumpedLoaderImpl : public CacheDumpedLoader {
   IOStatus ReadCacheBlock(std::string* data, DumpUnit* dump_unit);
 
   CacheDumpOptions options_;
+  BlockBasedTableOptions toptions_;
   std::shared_ptr<SecondaryCache> secondary_cache_;
   std::unique_ptr<CacheDumpReader> reader_;
 };
@@ -208,7 +213,8 @@ class ToFileCacheDumpWriter : public CacheDumpWriter {
 
 // The default implementation of CacheDumpReader. It is implemented based on
 // RandomAccessFileReader. Note that, we keep an internal variable to remember
-// the current offset.
+// the current offset. The file is read sequentially in large reads of
+// kDumpReaderBufferSize, from which the packets are copied out.
 class FromFileCacheDumpReader : public CacheDumpReader {
  public:
   explicit FromFileCacheDumpReader(
@@ -253,32 +259,28 @@ class FromFileCacheDumpReader : public CacheDumpReader {
 
   IOStatus Read(size_t len, std::string* data) {
     assert(file_reader_ != nullptr);
-    IOStatus io_s;
-
-    unsigned int bytes_to_read = static_cast<unsigned int>(len);
-    unsigned int to_read = bytes_to_read > kDumpReaderBufferSize
-                               ? kDumpReaderBufferSize
-                               : bytes_to_read;
-
-    while (to_read > 0) {
-      io_s = file_reader_->Read(IOOptions(), offset_, to_read, &result_,
-                                buffer_, nullptr);
-      if (!io_s.ok()) {
-        return io_s;
-      }
-      if (result_.size() < to_read) {
-        return IOStatus::Corruption("Corrupted cache dump file.");
+    while (len > 0) {
+      if (result_.empty()) {
+        IOStatus io_s =
+            file_reader_->Read(IOOptions(), offset_, kDumpReaderBufferSize,
+                               &result_, buffer_, nullptr);
+        if (!io_s.ok()) {
+          return io_s;
+        }
+        if (result_.empty()) {
+          return IOStatus::Corruption("Corrupted cache dump file.");
+        }
+        offset_ += result_.size();
       }
-      data->append(result_.data(), result_.size());
-
-      offset_ += to_read;
-      bytes_to_read -= to_read;
-      to_read = bytes_to_read > kDumpReaderBufferSize ? kDumpReaderBufferSize
-                                                      : bytes_to_read;
+      size_t to_copy = std::min(len, result_.size());
+      data->append(result_.data(), to_copy);
+      result_.remove_prefix(to_copy);
+      len -= to_copy;
     }
-    return io_s;
+    return IOStatus::OK();
   }
   std::unique_ptr<RandomAccessFileReader> file_reader_;
+  // The part of the last read that has not been consumed yet
   Slice result_;
   size_t offset_;
   char* buffer_;
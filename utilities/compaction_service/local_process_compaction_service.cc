@@ -0,0 +1,417 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/utilities/local_process_compaction_service.h"
+
+#ifndef OS_WIN
+#include <signal.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+#include <cerrno>
+#include <map>
+#include <vector>
+
+#include "db/compaction/compaction_job.h"
+#include "port/port.h"
+#include "rocksdb/db.h"
+#include "rocksdb/utilities/options_util.h"
+#include "util/coding.h"
+#include "util/string_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+namespace {
+const std::string kJobSuffix = ".job";
+const std::string kRunningInfix = ".running.";
+const std::string kResultSuffix = ".result";
+const std::string kTmpSuffix = ".tmp";
+
+// Whether the process that claimed a job is still running, or may be
+bool IsProcessAlive(uint64_t pid) {
+#ifndef OS_WIN
+  return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#else
+  (void)pid;
+  return true;
+#endif
+}
+
+// Writes `contents` to `fname` so that readers never see partial contents
+Status WriteFileAtomically(Env* env, const std::string& fname,
+                           const std::string& contents) {
+  const std::string tmp = fname + kTmpSuffix;
+  Status s = WriteStringToFile(env, contents, tmp, /*should_sync=*/false);
+  if (s.ok()) {
+    s = env->RenameFile(tmp, fname);
+  }
+  return s;
+}
+
+// Deletes a job output directory and whatever the worker left in it
+void DeleteOutputDir(Env* env, const std::string& dir) {
+  std::vector<std::string> children;
+  if (env->GetChildren(dir, &children).ok()) {
+    for (const auto& child : children) {
+      env->DeleteFile(dir + "/" + child).PermitUncheckedError();
+    }
+  }
+  env->DeleteDir(dir).PermitUncheckedError();
+}
+
+class LocalProcessCompactionService : public CompactionService {
+ public:
+  explicit LocalProcessCompactionService(
+      const LocalProcessCompactionServiceOptions& options)
+      : options_(options), env_(options.env) {}
+
+  ~LocalProcessCompactionService() override {
+    PurgeOutputDirs();
+#ifndef OS_WIN
+    for (pid_t pid : workers_) {
+      if (pid > 0) {
+        kill(pid, SIGTERM);
+        waitpid(pid, nullptr, 0);
+      }
+    }
+#endif
+  }
+
+  static const char* kClassName() { return "LocalProcessCompactionService"; }
+
+  const char* Name() const override { return kClassName(); }
+
+  Status Start() {
+    Status s = env_->CreateDirIfMissing(options_.job_dir);
+    if (!s.ok() || options_.worker_command.empty()) {
+      return s;
+    }
+    MutexLock l(&mutex_);
+    workers_.resize(options_.num_workers, 0);
+    for (size_t i = 0; s.ok() && i < workers_.size(); ++i) {
+      s = SpawnWorker(&workers_[i]);
+    }
+    return s;
+  }
+
+  CompactionServiceScheduleResponse Schedule(
+      const CompactionServiceJobInfo& info,
+      const std::string& compaction_service_input) override {
+    PurgeOutputDirs();
+    std::string id = env_->GenerateUniqueId();
+    std::string job;
+    PutLengthPrefixedSlice(&job, info.db_name);
+    job.append(compaction_service_input);
+    if (!WriteFileAtomically(env_, JobPath(id) + kJobSuffix, job).ok()) {
+      return CompactionServiceScheduleResponse(
+          CompactionServiceJobStatus::kUseLocal);
+    }
+    {
+      MutexLock l(&mutex_);
+      scheduled_[id] = env_->NowMicros();
+    }
+    return CompactionServiceScheduleResponse(
+        id, CompactionServiceJobStatus::kSuccess);
+  }
+
+  CompactionServiceJobStatus Wait(const std::string& scheduled_job_id,
+                                  std::string* result) override {
+    uint64_t schedule_time;
+    {
+      MutexLock l(&mutex_);
+      auto it = scheduled_.find(scheduled_job_id);
+      if (it == scheduled_.end()) {
+        return CompactionServiceJobStatus::kFailure;
+      }
+      schedule_time = it->second;
+    }
+    const std::string path = JobPath(scheduled_job_id);
+    while (true) {
+      if (env_->FileExists(path + kResultSuffix).ok()) {
+        std::string contents;
+        Status s = ReadFileToString(env_, path + kResultSuffix, &contents);
+        env_->DeleteFile(path + kResultSuffix).PermitUncheckedError();
+        Finish(scheduled_job_id, /*delete_output=*/false);
+        if (!s.ok() || contents.empty()) {
+          return CompactionServiceJobStatus::kFailure;
+        }
+        result->assign(contents, 1);
+        return contents[0] == '1' ? CompactionServiceJobStatus::kSuccess
+                                  : CompactionServiceJobStatus::kFailure;
+      }
+      if (env_->FileExists(path + kJobSuffix).ok()) {
+        // Not claimed by a worker yet. Withdraw it after the timeout, unless
+        // a worker claims it first.
+        if (options_.schedule_timeout_us > 0 &&
+            env_->NowMicros() - schedule_time >=
+                options_.schedule_timeout_us &&
+            env_->RenameFile(path + kJobSuffix, path + kTmpSuffix).ok()) {
+          env_->DeleteFile(path + kTmpSuffix).PermitUncheckedError();
+          Finish(scheduled_job_id, /*delete_output=*/true);
+          return CompactionServiceJobStatus::kUseLocal;
+        }
+      } else if (!IsWorkerAlive(scheduled_job_id) &&
+                 !env_->FileExists(path + kResultSuffix).ok()) {
+        // The worker writes the result before it removes the claimed job, so
+        // there will be no result
+        Finish(scheduled_job_id, /*delete_output=*/true);
+        return CompactionServiceJobStatus::kUseLocal;
+      }
+      RestartExitedWorkers();
+      env_->SleepForMicroseconds(
+          static_cast<int>(options_.poll_interval_us));
+    }
+  }
+
+ private:
+  std::string JobPath(const std::string& id) const {
+    return options_.job_dir + "/" + id;
+  }
+
+  // Whether the worker that claimed job `id` is still running
+  bool IsWorkerAlive(const std::string& id) {
+    std::vector<std::string> children;
+    if (!env_->GetChildren(options_.job_dir, &children).ok()) {
+      return true;
+    }
+    const std::string prefix = id + kRunningInfix;
+    for (const auto& child : children) {
+      if (StartsWith(child, prefix)) {
+        return IsProcessAlive(ParseUint64(child.substr(prefix.size())));
+      }
+    }
+    return false;
+  }
+
+  void Finish(const std::string& id, bool delete_output) {
+    if (delete_output) {
+      DeleteOutputDir(env_, JobPath(id));
+    }
+    MutexLock l(&mutex_);
+    scheduled_.erase(id);
+    if (!delete_output) {
+      finished_.push_back(id);
+    }
+  }
+
+  // Deletes the output directories of finished jobs once the DB has moved
+  // the output files out of them
+  void PurgeOutputDirs() {
+    std::vector<std::string> finished;
+    {
+      MutexLock l(&mutex_);
+      finished.swap(finished_);
+    }
+    std::vector<std::string> pending;
+    for (const auto& id : finished) {
+      std::vector<std::string> children;
+      Status s = env_->GetChildren(JobPath(id), &children);
+      bool installed = true;
+      for (const auto& child : children) {
+        if (EndsWith(child, ".sst") || EndsWith(child, ".blob")) {
+          installed = false;
+          break;
+        }
+      }
+      if (!s.ok() || installed) {
+        DeleteOutputDir(env_, JobPath(id));
+      } else {
+        pending.push_back(id);
+      }
+    }
+    MutexLock l(&mutex_);
+    finished_.insert(finished_.end(), pending.begin(), pending.end());
+  }
+
+#ifndef OS_WIN
+  // REQUIRES: mutex_ held
+  Status SpawnWorker(pid_t* pid) {
+    std::string job_dir_arg = "--job_dir=" + options_.job_dir;
+    std::string parent_arg = "--parent_pid=" + std::to_string(getpid());
+    char* argv[] = {const_cast<char*>(options_.worker_command.c_str()),
+                    const_cast<char*>(job_dir_arg.c_str()),
+                    const_cast<char*>(parent_arg.c_str()), nullptr};
+    int err = posix_spawn(pid, options_.worker_command.c_str(), nullptr,
+                          nullptr, argv, environ);
+    if (err != 0) {
+      *pid = 0;
+      return Status::IOError("While starting " + options_.worker_command,
+                             errnoStr(err));
+    }
+    return Status::OK();
+  }
+
+  void RestartExitedWorkers() {
+    MutexLock l(&mutex_);
+    for (pid_t& pid : workers_) {
+      if (pid <= 0 || waitpid(pid, nullptr, WNOHANG) == pid) {
+        SpawnWorker(&pid).PermitUncheckedError();
+      }
+    }
+  }
+#else
+  Status SpawnWorker(int* /*pid*/) {
+    return Status::NotSupported("Starting compaction workers");
+  }
+
+  void RestartExitedWorkers() {}
+#endif
+
+  const LocalProcessCompactionServiceOptions options_;
+  Env* const env_;
+
+  port::Mutex mutex_;
+  // Jobs waiting for a result, with the time they were scheduled
+  std::map<std::string, uint64_t> scheduled_;
+  // Jobs whose output directories are to be deleted
+  std::vector<std::string> finished_;
+#ifndef OS_WIN
+  std::vector<pid_t> workers_;
+#else
+  std::vector<int> workers_;
+#endif
+};
+
+// Replaces the options of `options_override` that are loaded with the latest
+// OPTIONS file of `db_name`, for the column family of `input`
+Status LoadOptionsOverride(Env* env, const std::string& db_name,
+                           const std::string& input,
+                           CompactionServiceOptionsOverride* options_override) {
+  CompactionServiceInput compaction_input;
+  Status s = CompactionServiceInput::Read(input, &compaction_input);
+  if (!s.ok()) {
+    return s;
+  }
+  ConfigOptions config_options;
+  config_options.env = env;
+  config_options.ignore_unknown_options = true;
+  config_options.ignore_unsupported_options = true;
+  DBOptions db_options;
+  std::vector<ColumnFamilyDescriptor> cf_descs;
+  s = LoadLatestOptions(config_options, db_name, &db_options, &cf_descs);
+  if (!s.ok()) {
+    return s;
+  }
+  for (const auto& cf_desc : cf_descs) {
+    if (cf_desc.name != compaction_input.column_family.name) {
+      continue;
+    }
+    const ColumnFamilyOptions& cf_options = cf_desc.options;
+    options_override->comparator = cf_options.comparator;
+    options_override->merge_operator = cf_options.merge_operator;
+    options_override->compaction_filter_factory =
+        cf_options.compaction_filter_factory;
+    options_override->prefix_extractor = cf_options.prefix_extractor;
+    options_override->table_factory = cf_options.table_factory;
+    options_override->sst_partitioner_factory =
+        cf_options.sst_partitioner_factory;
+    options_override->table_properties_collector_factories =
+        cf_options.table_properties_collector_factories;
+    return Status::OK();
+  }
+  return Status::NotFound("Column family not in OPTIONS file",
+                          compaction_input.column_family.name);
+}
+
+// Runs the job claimed as `running` and publishes its result
+void RunJob(const CompactionWorkerOptions& options, const std::string& id,
+            const std::string& running) {
+  Env* env = options.options_override.env;
+  const std::string path = options.job_dir + "/" + id;
+  std::string job;
+  Status s = ReadFileToString(env, running, &job);
+  Slice input = job;
+  Slice db_name;
+  if (s.ok() && !GetLengthPrefixedSlice(&input, &db_name)) {
+    s = Status::Corruption("Invalid compaction job", running);
+  }
+  CompactionServiceOptionsOverride options_override = options.options_override;
+  if (s.ok() && options.load_options_from_db) {
+    s = LoadOptionsOverride(env, db_name.ToString(), input.ToString(),
+                            &options_override);
+  }
+  std::string result;
+  if (s.ok()) {
+    OpenAndCompactOptions open_and_compact_options;
+    open_and_compact_options.canceled = options.stop;
+    s = DB::OpenAndCompact(open_and_compact_options, db_name.ToString(), path,
+                           input.ToString(), &result, options_override);
+  }
+  std::string contents(1, s.ok() ? '1' : '0');
+  contents.append(result);
+  WriteFileAtomically(env, path + kResultSuffix, contents)
+      .PermitUncheckedError();
+  env->DeleteFile(running).PermitUncheckedError();
+}
+}  // namespace
+
+Status NewLocalProcessCompactionService(
+    const LocalProcessCompactionServiceOptions& options,
+    std::shared_ptr<CompactionService>* service) {
+  if (options.job_dir.empty()) {
+    return Status::InvalidArgument("job_dir must be set");
+  }
+  if (!options.worker_command.empty() && options.num_workers < 1) {
+    return Status::InvalidArgument("num_workers must be positive");
+  }
+  if (options.env == nullptr) {
+    return Status::InvalidArgument("env must be set");
+  }
+  auto local_service = std::make_shared<LocalProcessCompactionService>(options);
+  Status s = local_service->Start();
+  if (s.ok()) {
+    *service = std::move(local_service);
+  }
+  return s;
+}
+
+Status RunCompactionWorker(const CompactionWorkerOptions& options) {
+  if (options.job_dir.empty()) {
+    return Status::InvalidArgument("job_dir must be set");
+  }
+  if (options.options_override.table_factory == nullptr &&
+      !options.load_options_from_db) {
+    return Status::InvalidArgument(
+        "options_override.table_factory must be set unless "
+        "load_options_from_db is");
+  }
+  Env* env = options.options_override.env;
+  Status s = env->CreateDirIfMissing(options.job_dir);
+  const std::string running_suffix =
+      kRunningInfix + std::to_string(port::GetProcessID());
+  auto stopped = [&options]() {
+    return options.stop != nullptr &&
+           options.stop->load(std::memory_order_acquire);
+  };
+  while (s.ok() && !stopped()) {
+    std::vector<std::string> children;
+    s = env->GetChildren(options.job_dir, &children);
+    bool found_job = false;
+    for (size_t i = 0; s.ok() && i < children.size() && !stopped(); ++i) {
+      const std::string& name = children[i];
+      if (!EndsWith(name, kJobSuffix)) {
+        continue;
+      }
+      const std::string id = name.substr(0, name.size() - kJobSuffix.size());
+      const std::string running = options.job_dir + "/" + id + running_suffix;
+      // Fails if another worker claimed the job, or the service withdrew it
+      if (env->RenameFile(options.job_dir + "/" + name, running).ok()) {
+        found_job = true;
+        RunJob(options, id, running);
+      }
+    }
+    if (s.ok() && !found_job) {
+      env->SleepForMicroseconds(static_cast<int>(options.poll_interval_us));
+    }
+  }
+  return s;
+}
+
+}  // namespace ROCKSDB_NAMESPACE
@@ -0,0 +1,156 @@
+//  Copyright (c) Meta Platforms, Inc. and affiliates.
+//  This source code is licensed under both the GPLv2 (found in the
+//  COPYING file in the root directory) and Apache 2.0 License
+//  (found in the LICENSE.Apache file in the root directory).
+
+#include "rocksdb/utilities/local_process_compaction_service.h"
+
+#include <thread>
+
+#include "db/db_test_util.h"
+#include "file/file_util.h"
+#include "port/stack_trace.h"
+#include "util/string_util.h"
+
+namespace ROCKSDB_NAMESPACE {
+
+class LocalProcessCompactionServiceTest : public DBTestBase {
+ public:
+  LocalProcessCompactionServiceTest()
+      : DBTestBase("local_process_compaction_service_test",
+                   /*env_do_fsync=*/false) {
+    job_dir_ = dbname_ + "_jobs";
+  }
+
+  ~LocalProcessCompactionServiceTest() override {
+    StopWorker();
+    EXPECT_OK(DestroyDir(env_, job_dir_));
+  }
+
+ protected:
+  void ReopenWithCompactionService(uint64_t schedule_timeout_us) {
+    Options options = CurrentOptions();
+    options.disable_auto_compactions = true;
+    options.statistics = CreateDBStatistics();
+    LocalProcessCompactionServiceOptions service_options;
+    service_options.job_dir = job_dir_;
+    service_options.schedule_timeout_us = schedule_timeout_us;
+    ASSERT_OK(NewLocalProcessCompactionService(service_options,
+                                               &options.compaction_service));
+    DestroyAndReopen(options);
+  }
+
+  // Runs a worker in a thread, as the worker binary would in a process
+  void StartWorker() {
+    worker_ = std::thread([this]() {
+      CompactionWorkerOptions worker_options;
+      worker_options.job_dir = job_dir_;
+      worker_options.options_override.table_factory =
+          last_options_.table_factory;
+      worker_options.stop = &stop_;
+      ASSERT_OK(RunCompactionWorker(worker_options));
+    });
+  }
+
+  void StopWorker() {
+    if (worker_.joinable()) {
+      stop_.store(true);
+      worker_.join();
+    }
+  }
+
+  void GenerateTestData() {
+    for (int i = 0; i < 5; i++) {
+      for (int j = 0; j < 100; j++) {
+        ASSERT_OK(Put(Key(j), "value" + std::to_string(i * 100 + j)));
+      }
+      ASSERT_OK(Flush());
+    }
+  }
+
+  void VerifyTestData() {
+    for (int j = 0; j < 100; j++) {
+      ASSERT_EQ(Get(Key(j)), "value" + std::to_string(400 + j));
+    }
+  }
+
+  // Number of files of jobs in the job directory, ignoring output directories
+  int NumJobFiles() {
+    std::vector<std::string> children;
+    EXPECT_OK(env_->GetChildren(job_dir_, &children));
+    int num_job_files = 0;
+    for (const auto& child : children) {
+      if (EndsWith(child, ".job") || EndsWith(child, ".result") ||
+          child.find(".running.") != std::string::npos) {
+        num_job_files++;
+      }
+    }
+    return num_job_files;
+  }
+
+  std::string job_dir_;
+  std::atomic<bool> stop_{false};
+  std::thread worker_;
+};
+
+TEST_F(LocalProcessCompactionServiceTest, BasicCompactions) {
+  ReopenWithCompactionService(/*schedule_timeout_us=*/0);
+  StartWorker();
+  GenerateTestData();
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  VerifyTestData();
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+
+  Statistics* statistics = last_options_.statistics.get();
+  ASSERT_GT(statistics->getTickerCount(REMOTE_COMPACT_WRITE_BYTES), 0);
+  ASSERT_EQ(statistics->getTickerCount(COMPACT_WRITE_BYTES), 0);
+  ASSERT_EQ(NumJobFiles(), 0);
+
+  // Survives a reopen. TryReopen() resets last_options_.table_factory, so
+  // pass a copy.
+  Options options = last_options_;
+  Reopen(options);
+  VerifyTestData();
+}
+
+TEST_F(LocalProcessCompactionServiceTest, NoWorker) {
+  // Jobs that no worker claims are run locally
+  ReopenWithCompactionService(/*schedule_timeout_us=*/1000);
+  GenerateTestData();
+  ASSERT_OK(db_->CompactRange(CompactRangeOptions(), nullptr, nullptr));
+  VerifyTestData();
+  ASSERT_EQ(NumTableFilesAtLevel(0), 0);
+
+  Statistics* statistics = last_options_.statistics.get();
+  ASSERT_EQ(statistics->getTickerCount(REMOTE_COMPACT_WRITE_BYTES), 0);
+  ASSERT_GT(statistics->getTickerCount(COMPACT_WRITE_BYTES), 0);
+  ASSERT_EQ(NumJobFiles(), 0);
+}
+
+TEST_F(LocalProcessCompactionServiceTest, InvalidOptions) {
+  std::shared_ptr<CompactionService> service;
+  LocalProcessCompactionServiceOptions service_options;
+  ASSERT_TRUE(NewLocalProcessCompactionService(service_options, &service)
+                  .IsInvalidArgument());
+  service_options.job_dir = job_dir_;
+  service_options.worker_command = "compaction_worker";
+  service_options.num_workers = 0;
+  ASSERT_TRUE(NewLocalProcessCompactionService(service_options, &service)
+                  .IsInvalidArgument());
+  ASSERT_EQ(service, nullptr);
+
+  CompactionWorkerOptions worker_options;
+  ASSERT_TRUE(RunCompactionWorker(worker_options).IsInvalidArgument());
+  // No table factory to open the DB with
+  worker_options.job_dir = job_dir_;
+  ASSERT_TRUE(RunCompactionWorker(worker_options).IsInvalidArgument());
+}
+
+}  // namespace ROCKSDB_NAMESPACE
+
+int main(int argc, char** argv) {
+  ROCKSDB_NAMESPACE::port::InstallStackTraceHandler();
+  ::testing::InitGoogleTest(&argc, argv);
+  RegisterCustomObjects(argc, argv);
+  return RUN_ALL_TESTS();
+}
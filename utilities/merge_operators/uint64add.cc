@@ -16,37 +16,27 @@
 
 namespace ROCKSDB_NAMESPACE {  // anonymous namespace
 
-bool UInt64AddOperator::Merge(const Slice& /*key*/, const Slice* existing_value,
-                              const Slice& value, std::string* new_value,
-                              Logger* logger) const {
-  uint64_t orig_value = 0;
-  if (existing_value) {
-    orig_value = DecodeInteger(*existing_value, logger);
-  }
-  uint64_t operand = DecodeInteger(value, logger);
-
-  assert(new_value);
-  new_value->clear();
-  PutFixed64(new_value, orig_value + operand);
-
-  return true;  // Return true always since corruption will be treated as 0
-}
-
-uint64_t UInt64AddOperator::DecodeInteger(const Slice& value,
-                                          Logger* logger) const {
-  uint64_t result = 0;
-
+bool UInt64AddOperator::Decode(const Slice& value, uint64_t* decoded,
+                               Logger* logger) const {
   if (value.size() == sizeof(uint64_t)) {
-    result = DecodeFixed64(value.data());
-  } else if (logger != nullptr) {
+    *decoded = DecodeFixed64(value.data());
+    return true;
+  }
+  if (logger != nullptr) {
     // If value is corrupted, treat it as 0
     ROCKS_LOG_ERROR(logger,
                     "uint64 value corruption, size: %" ROCKSDB_PRIszt
                     " > %" ROCKSDB_PRIszt,
                     value.size(), sizeof(uint64_t));
   }
+  *decoded = 0;
+  return true;  // Return true always since corruption will be treated as 0
+}
 
-  return result;
+void UInt64AddOperator::Encode(const uint64_t& acc,
+                               std::string* encoded) const {
+  assert(encoded);
+  PutFixed64(encoded, acc);
 }
 
 std::shared_ptr<MergeOperator> MergeOperators::CreateUInt64AddOperator() {
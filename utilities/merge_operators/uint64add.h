@@ -4,7 +4,7 @@
 //  (found in the LICENSE.Apache file in the root directory).
 //
 // A 'model' merge operator with uint64 addition semantics
-// Implemented as an AssociativeMergeOperator for simplicity and example.
+// Implemented as a TypedAssociativeMergeOperator for simplicity and example.
 
 #pragma once
 
@@ -15,21 +15,22 @@ namespace ROCKSDB_NAMESPACE {
 class Logger;
 class Slice;
 
-class UInt64AddOperator : public AssociativeMergeOperator {
+class UInt64AddOperator : public TypedAssociativeMergeOperator<uint64_t> {
  public:
   static const char* kClassName() { return "UInt64AddOperator"; }
   static const char* kNickName() { return "uint64add"; }
   const char* Name() const override { return kClassName(); }
   const char* NickName() const override { return kNickName(); }
 
-  bool Merge(const Slice& /*key*/, const Slice* existing_value,
-             const Slice& value, std::string* new_value,
-             Logger* logger) const override;
+  // On error, logs a message and decodes the value as 0
+  bool Decode(const Slice& value, uint64_t* decoded,
+              Logger* logger) const override;
 
- private:
-  // Takes the string and decodes it into a uint64_t
-  // On error, prints a message and returns 0
-  uint64_t DecodeInteger(const Slice& value, Logger* logger) const;
+  void Fold(const uint64_t& value, uint64_t* acc) const override {
+    *acc += value;
+  }
+
+  void Encode(const uint64_t& acc, std::string* encoded) const override;
 };
 
 }  // namespace ROCKSDB_NAMESPACE
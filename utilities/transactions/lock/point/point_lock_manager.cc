@@ -45,22 +45,82 @@ struct LockInfo {
 };
 
 struct LockMapStripe {
-  explicit LockMapStripe(std::shared_ptr<TransactionDBMutexFactory> factory) {
-    stripe_mutex = factory->AllocateMutex();
-    stripe_cv = factory->AllocateCondVar();
+  explicit LockMapStripe(std::shared_ptr<TransactionDBMutexFactory> factory)
+      : mutex_factory(std::move(factory)) {
+    stripe_mutex = mutex_factory->AllocateMutex();
     assert(stripe_mutex);
-    assert(stripe_cv);
   }
 
+  // Returns the condition variable to wait on for `key` to be unlocked, and
+  // registers the caller as one of its waiters.
+  // REQUIRED: stripe_mutex must be held.
+  std::shared_ptr<TransactionDBCondVar> AddWaiter(const std::string& key) {
+    KeyWaiters& key_waiters = waiters[key];
+    if (key_waiters.num_waiters++ == 0) {
+      if (free_cvs.empty()) {
+        key_waiters.cv = mutex_factory->AllocateCondVar();
+        assert(key_waiters.cv);
+      } else {
+        key_waiters.cv = std::move(free_cvs.back());
+        free_cvs.pop_back();
+      }
+    }
+    return key_waiters.cv;
+  }
+
+  // REQUIRED: stripe_mutex must be held.
+  void RemoveWaiter(const std::string& key) {
+    auto waiters_iter = waiters.find(key);
+    assert(waiters_iter != waiters.end());
+    if (--waiters_iter->second.num_waiters == 0) {
+      free_cvs.push_back(std::move(waiters_iter->second.cv));
+      waiters.erase(waiters_iter);
+    }
+  }
+
+  // Adds the condition variable of `key` to `cvs` if anybody is waiting for
+  // it, so that it can be signaled once stripe_mutex is released. With
+  // `all_keys`, adds those of all the keys that are waited for instead.
+  // REQUIRED: stripe_mutex must be held.
+  void GetWaitersToNotify(
+      const std::string& key, bool all_keys,
+      autovector<std::shared_ptr<TransactionDBCondVar>>* cvs) const {
+    if (waiters.empty()) {
+      return;
+    }
+    if (all_keys) {
+      for (const auto& key_waiters : waiters) {
+        cvs->push_back(key_waiters.second.cv);
+      }
+      return;
+    }
+    auto waiters_iter = waiters.find(key);
+    if (waiters_iter != waiters.end()) {
+      cvs->push_back(waiters_iter->second.cv);
+    }
+  }
+
+  std::shared_ptr<TransactionDBMutexFactory> mutex_factory;
+
   // Mutex must be held before modifying keys map
   std::shared_ptr<TransactionDBMutex> stripe_mutex;
 
-  // Condition Variable per stripe for waiting on a lock
-  std::shared_ptr<TransactionDBCondVar> stripe_cv;
-
   // Locked keys mapped to the info about the transactions that locked them.
   // TODO(agiardullo): Explore performance of other data structures.
   UnorderedMap<std::string, LockInfo> keys;
+
+  // Keys that transactions are waiting to lock. Each key has its own
+  // condition variable, so that unlocking a key only wakes up the
+  // transactions waiting for that key rather than all the waiters of the
+  // stripe.
+  struct KeyWaiters {
+    std::shared_ptr<TransactionDBCondVar> cv;
+    int num_waiters = 0;
+  };
+  UnorderedMap<std::string, KeyWaiters> waiters;
+
+  // Condition variables of keys that are no longer waited for, kept for reuse.
+  std::vector<std::shared_ptr<TransactionDBCondVar>> free_cvs;
 };
 
 // Map of #num_stripes LockMapStripes
@@ -282,6 +342,7 @@ Status PointLockManager::AcquireWithTimeout(
   if (!result.ok() && timeout != 0) {
     PERF_TIMER_GUARD(key_lock_wait_time);
     PERF_COUNTER_ADD(key_lock_wait_count, 1);
+    std::shared_ptr<TransactionDBCondVar> key_cv = stripe->AddWaiter(key);
     // If we weren't able to acquire the lock, we will keep retrying as long
     // as the timeout allows.
     bool timed_out = false;
@@ -305,6 +366,7 @@ Status PointLockManager::AcquireWithTimeout(
           if (IncrementWaiters(txn, wait_ids, key, column_family_id,
                                lock_info.exclusive, env)) {
             result = Status::Busy(Status::SubCode::kDeadlock);
+            stripe->RemoveWaiter(key);
             stripe->stripe_mutex->UnLock();
             return result;
           }
@@ -315,12 +377,11 @@ Status PointLockManager::AcquireWithTimeout(
       TEST_SYNC_POINT("PointLockManager::AcquireWithTimeout:WaitingTxn");
       if (cv_end_time < 0) {
         // Wait indefinitely
-        result = stripe->stripe_cv->Wait(stripe->stripe_mutex);
+        result = key_cv->Wait(stripe->stripe_mutex);
       } else {
         uint64_t now = env->NowMicros();
         if (static_cast<uint64_t>(cv_end_time) > now) {
-          result = stripe->stripe_cv->WaitFor(stripe->stripe_mutex,
-                                              cv_end_time - now);
+          result = key_cv->WaitFor(stripe->stripe_mutex, cv_end_time - now);
         }
       }
 
@@ -343,6 +404,7 @@ Status PointLockManager::AcquireWithTimeout(
                                &expire_time_hint, &wait_ids);
       }
     } while (!result.ok() && !timed_out);
+    stripe->RemoveWaiter(key);
   }
 
   stripe->stripe_mutex->UnLock();
@@ -537,9 +599,10 @@ Status PointLockManager::AcquireLocked(LockMap* lock_map, LockMapStripe* stripe,
   return result;
 }
 
-void PointLockManager::UnLockKey(PessimisticTransaction* txn,
-                                 const std::string& key, LockMapStripe* stripe,
-                                 LockMap* lock_map, Env* env) {
+void PointLockManager::UnLockKey(
+    PessimisticTransaction* txn, const std::string& key, LockMapStripe* stripe,
+    LockMap* lock_map, Env* env,
+    autovector<std::shared_ptr<TransactionDBCondVar>>* cvs_to_notify) {
 #ifdef NDEBUG
   (void)env;
 #endif
@@ -566,6 +629,11 @@ void PointLockManager::UnLockKey(PessimisticTransaction* txn,
         assert(lock_map->lock_cnt.load(std::memory_order_relaxed) > 0);
         lock_map->lock_cnt--;
       }
+
+      // Transactions that hit the lock limit wait on their own key, which
+      // may be any key of the stripe.
+      stripe->GetWaitersToNotify(key, max_num_locks_ > 0 /* all_keys */,
+                                 cvs_to_notify);
     }
   } else {
     // This key is either not locked or locked by someone else.  This should
@@ -590,12 +658,15 @@ void PointLockManager::UnLock(PessimisticTransaction* txn,
   assert(lock_map->lock_map_stripes_.size() > stripe_num);
   LockMapStripe* stripe = lock_map->lock_map_stripes_.at(stripe_num);
 
+  autovector<std::shared_ptr<TransactionDBCondVar>> cvs_to_notify;
   stripe->stripe_mutex->Lock().PermitUncheckedError();
-  UnLockKey(txn, key, stripe, lock_map, env);
+  UnLockKey(txn, key, stripe, lock_map, env, &cvs_to_notify);
   stripe->stripe_mutex->UnLock();
 
-  // Signal waiting threads to retry locking
-  stripe->stripe_cv->NotifyAll();
+  // Signal threads waiting for this key to retry locking
+  for (auto& cv : cvs_to_notify) {
+    cv->NotifyAll();
+  }
 }
 
 void PointLockManager::UnLock(PessimisticTransaction* txn,
@@ -632,16 +703,19 @@ void PointLockManager::UnLock(PessimisticTransaction* txn,
       assert(lock_map->lock_map_stripes_.size() > stripe_num);
       LockMapStripe* stripe = lock_map->lock_map_stripes_.at(stripe_num);
 
+      autovector<std::shared_ptr<TransactionDBCondVar>> cvs_to_notify;
       stripe->stripe_mutex->Lock().PermitUncheckedError();
 
       for (const std::string* key : stripe_keys) {
-        UnLockKey(txn, *key, stripe, lock_map, env);
+        UnLockKey(txn, *key, stripe, lock_map, env, &cvs_to_notify);
       }
 
       stripe->stripe_mutex->UnLock();
 
-      // Signal waiting threads to retry locking
-      stripe->stripe_cv->NotifyAll();
+      // Signal threads waiting for the unlocked keys to retry locking
+      for (auto& cv : cvs_to_notify) {
+        cv->NotifyAll();
+      }
     }
   }
 }
@@ -13,6 +13,7 @@
 
 #include "monitoring/instrumented_mutex.h"
 #include "rocksdb/utilities/transaction.h"
+#include "rocksdb/utilities/transaction_db_mutex.h"
 #include "util/autovector.h"
 #include "util/hash_containers.h"
 #include "util/hash_map.h"
@@ -206,8 +207,12 @@ class PointLockManager : public LockManager {
                        const LockInfo& lock_info, uint64_t* wait_time,
                        autovector<TransactionID>* txn_ids);
 
-  void UnLockKey(PessimisticTransaction* txn, const std::string& key,
-                 LockMapStripe* stripe, LockMap* lock_map, Env* env);
+  // Releases txn's lock on key, and adds the condition variable of the
+  // transactions waiting for key, if any, to `cvs_to_notify`.
+  void UnLockKey(
+      PessimisticTransaction* txn, const std::string& key,
+      LockMapStripe* stripe, LockMap* lock_map, Env* env,
+      autovector<std::shared_ptr<TransactionDBCondVar>>* cvs_to_notify);
 
   bool IncrementWaiters(const PessimisticTransaction* txn,
                         const autovector<TransactionID>& wait_ids,
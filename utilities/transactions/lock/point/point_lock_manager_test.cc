@@ -157,6 +157,52 @@ TEST_F(PointLockManagerTest, DeadlockDepthExceeded) {
   delete txn1;
 }
 
+TEST_F(PointLockManagerTest, UnlockOnlyWakesWaitersOfKey) {
+  // Tests that releasing a lock does not wake up transactions waiting for
+  // other keys, even when those keys share the lock stripe.
+  MockColumnFamilyHandle cf(1);
+  locker_->AddColumnFamily(&cf);
+  TransactionOptions txn_opt;
+  txn_opt.lock_timeout = 1000000;
+  auto txn1 = NewTxn(txn_opt);
+  auto txn2 = NewTxn(txn_opt);
+
+  std::atomic<int> num_waits(0);
+  SyncPoint::GetInstance()->SetCallBack(
+      wait_sync_point_name_, [&](void* /*arg*/) { num_waits.fetch_add(1); });
+  SyncPoint::GetInstance()->EnableProcessing();
+
+  ASSERT_OK(locker_->TryLock(txn1, 1, "k", env_, true));
+  port::Thread t([&]() {
+    // block because txn1 is holding a lock on k.
+    ASSERT_OK(locker_->TryLock(txn2, 1, "k", env_, true));
+  });
+  while (num_waits.load() == 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  // Enough keys for some of them to map to the stripe of "k".
+  const int kNumOtherKeys = 100;
+  for (int i = 0; i < kNumOtherKeys; i++) {
+    std::string key = "other" + std::to_string(i);
+    ASSERT_OK(locker_->TryLock(txn1, 1, key, env_, true));
+    locker_->UnLock(txn1, 1, key, env_);
+  }
+
+  locker_->UnLock(txn1, 1, "k", env_);
+  t.join();
+  // txn2 only waited once, until "k" was released.
+  ASSERT_EQ(num_waits.load(), 1);
+
+  SyncPoint::GetInstance()->DisableProcessing();
+  SyncPoint::GetInstance()->ClearAllCallBacks();
+
+  // Cleanup
+  locker_->UnLock(txn2, 1, "k", env_);
+  delete txn2;
+  delete txn1;
+}
+
 INSTANTIATE_TEST_CASE_P(PointLockManager, AnyLockManagerTest,
                         ::testing::Values(nullptr));
 
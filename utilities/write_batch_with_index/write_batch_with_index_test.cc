@@ -3095,6 +3095,62 @@ TEST_P(WriteBatchWithIndexTest, EntityReadSanityChecks) {
   }
 }
 
+TEST_P(WriteBatchWithIndexTest, GetEntityAfterProjectedRead) {
+  ASSERT_OK(OpenDB());
+
+  ColumnFamilyHandle* const cfh = db_->DefaultColumnFamily();
+  constexpr char db_key[] = "foo";
+  constexpr char batch_key[] = "bar";
+  const WideColumns columns{
+      {kDefaultWideColumnName, "d"}, {"a", "1"}, {"b", "2"}};
+  const WideColumns projected_columns{{"a", "1"}};
+
+  ASSERT_OK(db_->PutEntity(write_opts_, cfh, db_key, columns));
+  ASSERT_OK(batch_->PutEntity(cfh, batch_key, columns));
+
+  auto projected_get = [&](PinnableWideColumns* result) {
+    const std::vector<Slice> projection{"a"};
+    ReadOptions read_options;
+    read_options.wide_column_projection = &projection;
+    ASSERT_OK(db_->GetEntity(read_options, cfh, db_key, result));
+    ASSERT_EQ(result->columns(), projected_columns);
+  };
+
+  // Reads through the batch reuse the result of a projected read after the
+  // projection is gone, and return all columns
+  for (const char* key : {db_key, batch_key}) {
+    PinnableWideColumns result;
+    projected_get(&result);
+    ASSERT_OK(
+        batch_->GetEntityFromBatchAndDB(db_, read_opts_, cfh, key, &result));
+    ASSERT_EQ(result.columns(), columns);
+
+    projected_get(&result);
+    PinnableWideColumns moved(std::move(result));
+    ASSERT_EQ(moved.columns(), projected_columns);
+    ASSERT_OK(
+        batch_->GetEntityFromBatchAndDB(db_, read_opts_, cfh, key, &moved));
+    ASSERT_EQ(moved.columns(), columns);
+  }
+
+  {
+    std::array<PinnableWideColumns, 2> results;
+    projected_get(&results[0]);
+    projected_get(&results[1]);
+
+    std::array<Slice, 2> keys{{db_key, batch_key}};
+    std::array<Status, 2> statuses;
+    constexpr bool sorted_input = false;
+    batch_->MultiGetEntityFromBatchAndDB(db_, read_opts_, cfh, keys.size(),
+                                         keys.data(), results.data(),
+                                         statuses.data(), sorted_input);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      ASSERT_OK(statuses[i]);
+      ASSERT_EQ(results[i].columns(), columns);
+    }
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(WBWI, WriteBatchWithIndexTest, testing::Bool());
 }  // namespace ROCKSDB_NAMESPACE
 